@@ -0,0 +1,529 @@
+/*
+ * Gearsystem - Sega Master System / Game Gear Emulator
+ * Copyright (C) 2013  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include "../../src/gearsystem.h"
+
+#define BENCHMARK_BUFFER_SIZE (GS_RESOLUTION_MAX_WIDTH_WITH_OVERSCAN * GS_RESOLUTION_MAX_HEIGHT_WITH_OVERSCAN * 3)
+#define BENCHMARK_ROM_SIZE 0x8000
+#define BENCHMARK_CPU_CHUNK 228
+#define BENCHMARK_LINE_CYCLES 228
+
+typedef std::chrono::steady_clock Clock;
+
+// di; ld sp,$DFF0; ld iy,$C100
+// loop: ld hl,$C000; ld b,0
+// inner: ld a,(hl); add a,b; daa; ld (hl),a; inc hl; rlc a; xor c; ld c,a
+//        push bc; pop de; ex de,hl; add hl,de; ex de,hl; inc ix; ld (iy+0),a
+//        djnz inner
+//        ld hl,$C000; ld de,$C200; ld bc,$40; ldir; jp loop
+static const u8 kCPUProgram[] = {
+    0xF3, 0x31, 0xF0, 0xDF, 0xFD, 0x21, 0x00, 0xC1,
+    0x21, 0x00, 0xC0, 0x06, 0x00,
+    0x7E, 0x80, 0x27, 0x77, 0x23, 0xCB, 0x07, 0xA9, 0x4F,
+    0xC5, 0xD1, 0xEB, 0x19, 0xEB, 0xDD, 0x23, 0xFD, 0x77, 0x00,
+    0x10, 0xEB,
+    0x21, 0x00, 0xC0, 0x11, 0x00, 0xC2, 0x01, 0x40, 0x00, 0xED, 0xB0, 0xC3, 0x08, 0x00
+};
+
+// di; jr $
+static const u8 kIdleProgram[] = { 0xF3, 0x18, 0xFE };
+
+struct VideoMode
+{
+    const char* name;
+    Cartridge::CartridgeSystem system;
+    u8 registers[11];
+};
+
+static const VideoMode kVideoModes[] = {
+    { "sms", Cartridge::CartridgeSMS, { 0x06, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0x03, 0x00, 0x00, 0xFF } },
+    { "sms_224", Cartridge::CartridgeSMS, { 0x06, 0xD0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0x03, 0x00, 0x00, 0xFF } },
+    { "gg", Cartridge::CartridgeGG, { 0x06, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0x03, 0x00, 0x00, 0xFF } },
+    { "sg1000", Cartridge::CartridgeSG1000, { 0x02, 0xC0, 0x0E, 0xFF, 0x03, 0x7E, 0x07, 0x01, 0x00, 0x00, 0xFF } }
+};
+
+static const int kVideoModeCount = sizeof(kVideoModes) / sizeof(kVideoModes[0]);
+
+static double elapsed_seconds(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static double per_second(double count, double seconds)
+{
+    return (seconds > 0.0) ? (count / seconds) : 0.0;
+}
+
+static std::string json_string(const char* text)
+{
+    std::string result = "\"";
+
+    for (const char* c = text; *c; c++)
+    {
+        if ((*c == '"') || (*c == '\\'))
+        {
+            result += '\\';
+            result += *c;
+        }
+        else if (static_cast<unsigned char>(*c) < 0x20)
+            result += ' ';
+        else
+            result += *c;
+    }
+
+    result += "\"";
+    return result;
+}
+
+static GearsystemCore* create_core(const u8* program, int program_size, Cartridge::CartridgeSystem system)
+{
+    std::vector<u8> rom(BENCHMARK_ROM_SIZE, 0x00);
+    memcpy(&rom[0], program, program_size);
+
+    Cartridge::ForceConfiguration config;
+    config.type = Cartridge::CartridgeRomOnlyMapper;
+    config.zone = Cartridge::CartridgeUnknownZone;
+    config.region = Cartridge::CartridgeNTSC;
+    config.system = system;
+
+    GearsystemCore* core = new GearsystemCore();
+    core->Init(GS_PIXEL_RGB888);
+
+    if (!core->LoadROMFromBuffer(&rom[0], BENCHMARK_ROM_SIZE, &config))
+    {
+        printf("Unable to load the synthetic ROM\n");
+        SafeDelete(core);
+    }
+
+    return core;
+}
+
+static void benchmark_cpu(FILE* out, int frames)
+{
+    GearsystemCore* core = create_core(kCPUProgram, sizeof(kCPUProgram), Cartridge::CartridgeSMS);
+
+    if (!IsValidPointer(core))
+        return;
+
+    Processor* processor = core->GetProcessor();
+    long long budget = static_cast<long long>(frames) * 262 * BENCHMARK_LINE_CYCLES;
+
+    size_t state_size = 0;
+    core->SaveState(NULL, state_size);
+    std::vector<u8> state(state_size);
+    core->SaveState(&state[0], state_size);
+
+    // First pass counts the instructions using the lockstep trace, which
+    // selects the instrumented loop, so it is not timed
+    std::vector<Processor::stLockstepRecord> trace;
+    trace.reserve(BENCHMARK_CPU_CHUNK);
+    processor->SetLockstepTrace(&trace);
+
+    long long instructions = 0;
+    long long executed = 0;
+
+    while (executed < budget)
+    {
+        trace.clear();
+        executed += processor->RunFor(BENCHMARK_CPU_CHUNK);
+        processor->ConsumePendingTStates();
+        instructions += trace.size();
+    }
+
+    processor->SetLockstepTrace(NULL);
+    core->LoadState(&state[0], state_size);
+
+    executed = 0;
+    Clock::time_point start = Clock::now();
+
+    while (executed < budget)
+    {
+        executed += processor->RunFor(BENCHMARK_CPU_CHUNK);
+        processor->ConsumePendingTStates();
+    }
+
+    double seconds = elapsed_seconds(start);
+
+    fprintf(out, "  \"cpu\": {\n");
+    fprintf(out, "    \"instructions\": %lld,\n", instructions);
+    fprintf(out, "    \"tstates\": %lld,\n", executed);
+    fprintf(out, "    \"elapsed_ms\": %.3f,\n", seconds * 1000.0);
+    fprintf(out, "    \"instructions_per_sec\": %.0f,\n", per_second(static_cast<double>(instructions), seconds));
+    fprintf(out, "    \"tstates_per_sec\": %.0f\n", per_second(static_cast<double>(executed), seconds));
+    fprintf(out, "  },\n");
+
+    SafeDelete(core);
+}
+
+static void benchmark_video_mode(FILE* out, const VideoMode& mode, int frames, bool last)
+{
+    GearsystemCore* core = create_core(kIdleProgram, sizeof(kIdleProgram), mode.system);
+
+    if (!IsValidPointer(core))
+        return;
+
+    Video* video = core->GetVideo();
+
+    for (int i = 0; i < 11; i++)
+    {
+        video->WriteControl(mode.registers[i]);
+        video->WriteControl(0x80 | i);
+    }
+
+    u32 seed = 0x12345678;
+
+    video->WriteControl(0x00);
+    video->WriteControl(0x40);
+
+    for (int i = 0; i < 0x4000; i++)
+    {
+        seed = (seed * 1103515245) + 12345;
+        video->WriteData(static_cast<u8>(seed >> 16));
+    }
+
+    // Spread the sprites over the screen so none ends the list early
+    video->WriteControl(0x00);
+    video->WriteControl(0x7F);
+
+    for (int i = 0; i < 64; i++)
+        video->WriteData(static_cast<u8>((i * 3) % 0xC0));
+
+    video->WriteControl(0x00);
+    video->WriteControl(0xC0);
+
+    for (int i = 0; i < 64; i++)
+    {
+        seed = (seed * 1103515245) + 12345;
+        video->WriteData(static_cast<u8>(seed >> 16));
+    }
+
+    long long lines = 0;
+    Clock::time_point start = Clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        bool vblank = false;
+
+        while (!vblank)
+        {
+            vblank = video->Tick(BENCHMARK_LINE_CYCLES);
+            lines++;
+        }
+    }
+
+    double seconds = elapsed_seconds(start);
+
+    fprintf(out, "    %s: {\n", json_string(mode.name).c_str());
+    fprintf(out, "      \"scanlines\": %lld,\n", lines);
+    fprintf(out, "      \"elapsed_ms\": %.3f,\n", seconds * 1000.0);
+    fprintf(out, "      \"scanlines_per_sec\": %.0f\n", per_second(static_cast<double>(lines), seconds));
+    fprintf(out, "    }%s\n", last ? "" : ",");
+
+    SafeDelete(core);
+}
+
+static void benchmark_video(FILE* out, int frames)
+{
+    fprintf(out, "  \"video\": {\n");
+
+    for (int i = 0; i < kVideoModeCount; i++)
+        benchmark_video_mode(out, kVideoModes[i], frames, i == (kVideoModeCount - 1));
+
+    fprintf(out, "  },\n");
+}
+
+static void benchmark_audio_run(FILE* out, bool ym2413, int frames)
+{
+    GearsystemCore* core = create_core(kIdleProgram, sizeof(kIdleProgram), Cartridge::CartridgeSMS);
+
+    if (!IsValidPointer(core))
+        return;
+
+    Audio* audio = core->GetAudio();
+
+    if (ym2413)
+    {
+        audio->YM2413Write(0xF2, 0x01);
+
+        for (int channel = 0; channel < 9; channel++)
+        {
+            const u8 registers[3][2] = {
+                { static_cast<u8>(0x30 + channel), static_cast<u8>(((channel + 1) << 4) | 0x02) },
+                { static_cast<u8>(0x10 + channel), static_cast<u8>(0x40 + (channel * 0x10)) },
+                { static_cast<u8>(0x20 + channel), static_cast<u8>(0x10 | ((channel % 7) << 1) | 0x01) }
+            };
+
+            for (int i = 0; i < 3; i++)
+            {
+                audio->YM2413Write(0xF0, registers[i][0]);
+                audio->YM2413Write(0xF1, registers[i][1]);
+            }
+        }
+    }
+
+    std::vector<s16> samples(GS_AUDIO_BUFFER_SIZE * 2);
+    long long total_samples = 0;
+    Clock::time_point start = Clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        // Sweep the tone channels so the PSG produces transitions every line
+        for (int line = 0; line < 262; line++)
+        {
+            u8 channel = static_cast<u8>((line & 0x03) << 5);
+            audio->WriteAudioRegister(0x80 | channel | (line & 0x0F));
+            audio->WriteAudioRegister(static_cast<u8>((frame + line) & 0x3F));
+            audio->WriteAudioRegister(0x90 | channel | ((frame >> 2) & 0x07));
+            audio->Tick(BENCHMARK_LINE_CYCLES);
+        }
+
+        int sample_count = 0;
+        audio->EndFrame(&samples[0], &sample_count);
+        total_samples += sample_count;
+    }
+
+    double seconds = elapsed_seconds(start);
+
+    fprintf(out, "    %s: {\n", ym2413 ? "\"psg_ym2413\"" : "\"psg\"");
+    fprintf(out, "      \"samples\": %lld,\n", total_samples);
+    fprintf(out, "      \"elapsed_ms\": %.3f,\n", seconds * 1000.0);
+    fprintf(out, "      \"samples_per_sec\": %.0f\n", per_second(static_cast<double>(total_samples), seconds));
+    fprintf(out, "    }%s\n", ym2413 ? "" : ",");
+
+    SafeDelete(core);
+}
+
+static void benchmark_audio(FILE* out, int frames)
+{
+    fprintf(out, "  \"audio\": {\n");
+    benchmark_audio_run(out, false, frames);
+    benchmark_audio_run(out, true, frames);
+    fprintf(out, "  },\n");
+}
+
+static void benchmark_savestate(FILE* out, int iterations)
+{
+    GearsystemCore* core = create_core(kCPUProgram, sizeof(kCPUProgram), Cartridge::CartridgeSMS);
+
+    if (!IsValidPointer(core))
+        return;
+
+    std::vector<u8> frame_buffer(BENCHMARK_BUFFER_SIZE);
+    std::vector<s16> audio_buffer(GS_AUDIO_BUFFER_SIZE * 2);
+    int sample_count = 0;
+
+    for (int i = 0; i < 10; i++)
+        core->RunToVBlank(&frame_buffer[0], &audio_buffer[0], &sample_count);
+
+    size_t size = 0;
+    core->SaveState(NULL, size);
+    std::vector<u8> state(size);
+
+    Clock::time_point start = Clock::now();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        size_t state_size = size;
+        core->SaveState(&state[0], state_size);
+    }
+
+    double save_seconds = elapsed_seconds(start);
+
+    start = Clock::now();
+
+    for (int i = 0; i < iterations; i++)
+        core->LoadState(&state[0], size);
+
+    double load_seconds = elapsed_seconds(start);
+
+    double megabytes = (static_cast<double>(size) * iterations) / (1024.0 * 1024.0);
+
+    fprintf(out, "  \"savestate\": {\n");
+    fprintf(out, "    \"size\": %d,\n", static_cast<int>(size));
+    fprintf(out, "    \"iterations\": %d,\n", iterations);
+    fprintf(out, "    \"save_per_sec\": %.0f,\n", per_second(iterations, save_seconds));
+    fprintf(out, "    \"save_mb_per_sec\": %.2f,\n", per_second(megabytes, save_seconds));
+    fprintf(out, "    \"load_per_sec\": %.0f,\n", per_second(iterations, load_seconds));
+    fprintf(out, "    \"load_mb_per_sec\": %.2f\n", per_second(megabytes, load_seconds));
+    fprintf(out, "  },\n");
+
+    SafeDelete(core);
+}
+
+static void benchmark_rom(FILE* out, const char* rom_file, int frames, bool last)
+{
+    GearsystemCore* core = new GearsystemCore();
+    core->Init(GS_PIXEL_RGB888);
+
+    fprintf(out, "    {\n");
+    fprintf(out, "      \"rom\": %s,\n", json_string(rom_file).c_str());
+
+    if (!core->LoadROM(rom_file))
+    {
+        fprintf(out, "      \"error\": \"unable to load\"\n");
+        fprintf(out, "    }%s\n", last ? "" : ",");
+        SafeDelete(core);
+        return;
+    }
+
+    std::vector<u8> frame_buffer(BENCHMARK_BUFFER_SIZE);
+    std::vector<s16> audio_buffer(GS_AUDIO_BUFFER_SIZE * 2);
+
+    double total = 0.0;
+    double min_frame = 0.0;
+    double max_frame = 0.0;
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        int sample_count = 0;
+
+        Clock::time_point start = Clock::now();
+        core->RunToVBlank(&frame_buffer[0], &audio_buffer[0], &sample_count);
+        double seconds = elapsed_seconds(start);
+
+        total += seconds;
+
+        if ((frame == 0) || (seconds < min_frame))
+            min_frame = seconds;
+        if ((frame == 0) || (seconds > max_frame))
+            max_frame = seconds;
+    }
+
+    // Same amount of frames again without rendering or mixing them, the
+    // way fast-forward and run-ahead run the frames nobody sees
+    Clock::time_point skip_start = Clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        int sample_count = 0;
+        core->RunToVBlank(&frame_buffer[0], &audio_buffer[0], &sample_count, false, false, GS_RUN_SKIP_RENDER | GS_RUN_SKIP_AUDIO);
+    }
+
+    double skip_total = elapsed_seconds(skip_start);
+
+    fprintf(out, "      \"frames\": %d,\n", frames);
+    fprintf(out, "      \"elapsed_ms\": %.3f,\n", total * 1000.0);
+    fprintf(out, "      \"fps\": %.2f,\n", per_second(frames, total));
+    fprintf(out, "      \"frame_ms_mean\": %.4f,\n", (frames > 0) ? (total * 1000.0 / frames) : 0.0);
+    fprintf(out, "      \"frame_ms_min\": %.4f,\n", min_frame * 1000.0);
+    fprintf(out, "      \"frame_ms_max\": %.4f,\n", max_frame * 1000.0);
+    fprintf(out, "      \"skip_fps\": %.2f\n", per_second(frames, skip_total));
+    fprintf(out, "    }%s\n", last ? "" : ",");
+
+    SafeDelete(core);
+}
+
+static void print_usage(const char* name)
+{
+    printf("Usage: %s [options] [rom_file ...]\n", name);
+    printf("Options:\n");
+    printf("  -f, --frames N       frames per ROM and per synthetic test (default 600)\n");
+    printf("  -s, --states N       save/load iterations (default 2000)\n");
+    printf("  -o, --output FILE    write the JSON report to FILE instead of stdout\n");
+    printf("      --no-synthetic   only run the ROM corpus\n");
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<const char*> roms;
+    const char* output_file = NULL;
+    int frames = 600;
+    int states = 2000;
+    bool synthetic = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        bool has_value = (i + 1) < argc;
+
+        if ((strcmp(arg, "-h") == 0) || (strcmp(arg, "--help") == 0))
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else if ((strcmp(arg, "-v") == 0) || (strcmp(arg, "--version") == 0))
+        {
+            printf("%s %s\n", GEARSYSTEM_TITLE, GEARSYSTEM_VERSION);
+            printf("Build: %s\n", EMULATOR_BUILD);
+            return 0;
+        }
+        else if (((strcmp(arg, "-f") == 0) || (strcmp(arg, "--frames") == 0)) && has_value)
+            frames = atoi(argv[++i]);
+        else if (((strcmp(arg, "-s") == 0) || (strcmp(arg, "--states") == 0)) && has_value)
+            states = atoi(argv[++i]);
+        else if (((strcmp(arg, "-o") == 0) || (strcmp(arg, "--output") == 0)) && has_value)
+            output_file = argv[++i];
+        else if (strcmp(arg, "--no-synthetic") == 0)
+            synthetic = false;
+        else if (arg[0] != '-')
+            roms.push_back(arg);
+        else
+        {
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    if ((frames <= 0) || (states <= 0))
+    {
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    FILE* out = stdout;
+
+    if (IsValidPointer(output_file))
+    {
+        out = fopen(output_file, "w");
+
+        if (!IsValidPointer(out))
+        {
+            printf("Unable to open output file %s\n", output_file);
+            return -1;
+        }
+    }
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"version\": %s,\n", json_string(GEARSYSTEM_VERSION).c_str());
+    fprintf(out, "  \"frames\": %d,\n", frames);
+
+    if (synthetic)
+    {
+        benchmark_cpu(out, frames);
+        benchmark_video(out, frames);
+        benchmark_audio(out, frames);
+        benchmark_savestate(out, states);
+    }
+
+    fprintf(out, "  \"roms\": [\n");
+
+    for (size_t i = 0; i < roms.size(); i++)
+        benchmark_rom(out, roms[i], frames, i == (roms.size() - 1));
+
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+
+    if (out != stdout)
+        fclose(out);
+
+    return 0;
+}
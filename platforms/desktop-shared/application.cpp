@@ -35,6 +35,8 @@ static bool running = true;
 static bool paused_when_focus_lost = false;
 static Uint64 frame_time_start;
 static Uint64 frame_time_end;
+static SDL_Thread* emulation_thread;
+static SDL_atomic_t emulation_running;
 
 static int sdl_init(void);
 static void sdl_destroy(void);
@@ -42,9 +44,13 @@ static void sdl_events(void);
 static void sdl_events_emu(const SDL_Event* event);
 static void sdl_shortcuts_gui(const SDL_Event* event);
 static void handle_mouse_cursor(void);
-static void run_emulator(void);
+static void update_emulator(void);
 static void render(void);
 static void frame_throttle(void);
+static void start_emulation_thread(void);
+static void stop_emulation_thread(void);
+static int emulation_loop(void* data);
+static float emulation_frame_time(void);
 static void save_window_size(void);
 
 int application_init(const char* rom_file, const char* symbol_file)
@@ -56,6 +62,7 @@ int application_init(const char* rom_file, const char* symbol_file)
 
     int ret = sdl_init();
     emu_init();
+    emu_debug_enable(config_debug.debug);
 
     strcpy(emu_savefiles_path, config_emulator.savefiles_path.c_str());
     strcpy(emu_savestates_path, config_emulator.savestates_path.c_str());
@@ -101,16 +108,27 @@ void application_destroy(void)
 
 void application_mainloop(void)
 {
+    start_emulation_thread();
+
     while (running)
     {
         frame_time_start = SDL_GetPerformanceCounter();
+
+        emu_lock();
         sdl_events();
         handle_mouse_cursor();
-        run_emulator();
+        update_emulator();
+        renderer_begin_render();
+        ImGui_ImplSDL2_NewFrame(sdl_window);
+        gui_render();
+        emu_unlock();
+
         render();
         frame_time_end = SDL_GetPerformanceCounter();
         frame_throttle();
     }
+
+    stop_emulation_thread();
 }
 
 void application_trigger_quit(void)
@@ -490,7 +508,7 @@ static void handle_mouse_cursor(void)
         ImGui::SetMouseCursor(ImGuiMouseCursor_Arrow);
 }
 
-static void run_emulator(void)
+static void update_emulator(void)
 {
     static char prevtitle[256];
 
@@ -514,14 +532,16 @@ static void run_emulator(void)
     }
     config_emulator.paused = emu_is_paused();
     emu_audio_sync = config_audio.sync;
-    emu_update();
+    emu_frame_skip = config_emulator.ffwd;
+
+    if (config_debug.debug)
+        emu_update_debug();
 }
 
+// Runs without the core lock, so vsync waits and GL work never hold back
+// the emulation thread
 static void render(void)
 {
-    renderer_begin_render();
-    ImGui_ImplSDL2_NewFrame(sdl_window);  
-    gui_render();
     renderer_render();
     renderer_end_render();
 
@@ -530,36 +550,92 @@ static void render(void)
 
 static void frame_throttle(void)
 {
-    if (emu_is_empty() || emu_is_paused() || config_emulator.ffwd)
+    float elapsed = (float)((frame_time_end - frame_time_start) * 1000) / SDL_GetPerformanceFrequency();
+
+    float min = 16.666f;
+
+    if (elapsed < min)
+        SDL_Delay((Uint32)(min - elapsed));
+}
+
+static void start_emulation_thread(void)
+{
+    SDL_AtomicSet(&emulation_running, 1);
+    emulation_thread = SDL_CreateThread(emulation_loop, "Emulation", NULL);
+
+    if (!IsValidPointer(emulation_thread))
     {
-        float elapsed = (float)((frame_time_end - frame_time_start) * 1000) / SDL_GetPerformanceFrequency();
+        Log("Error: Unable to create emulation thread: %s\n", SDL_GetError());
+    }
+}
+
+static void stop_emulation_thread(void)
+{
+    SDL_AtomicSet(&emulation_running, 0);
+
+    if (IsValidPointer(emulation_thread))
+        SDL_WaitThread(emulation_thread, NULL);
 
-        float min = 16.666f;
+    InitPointer(emulation_thread);
+}
+
+// The core runs here, one frame per iteration. With audio sync the sound
+// queue paces it, otherwise it keeps its own schedule so fast forward is
+// not tied to the display refresh.
+static int emulation_loop(void* data)
+{
+    (void)data;
 
-        if (config_emulator.ffwd)
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 deadline = SDL_GetPerformanceCounter();
+
+    while (SDL_AtomicGet(&emulation_running))
+    {
+        bool ran = emu_update();
+
+        emu_lock();
+        float frame_time = ran ? emulation_frame_time() : 16.666f;
+        emu_unlock();
+
+        Uint64 now = SDL_GetPerformanceCounter();
+
+        if (frame_time <= 0.0f)
         {
-            switch (config_emulator.ffwd_speed)
-            {
-                case 0:
-                    min = 16.666f / 1.5f;
-                    break;
-                case 1: 
-                    min = 16.666f / 2.0f;
-                    break;
-                case 2:
-                    min = 16.666f / 2.5f;
-                    break;
-                case 3:
-                    min = 16.666f / 3.0f;
-                    break;
-                default:
-                    min = 0.0f;
-            }
+            deadline = now;
+            continue;
         }
 
-        if (elapsed < min)
-            SDL_Delay((Uint32)(min - elapsed));
+        deadline += (Uint64)(frame_time * frequency / 1000.0f);
+
+        if (deadline > now)
+            SDL_Delay((Uint32)(((deadline - now) * 1000) / frequency));
+        else
+            deadline = now;
     }
+
+    return 0;
+}
+
+static float emulation_frame_time(void)
+{
+    if (config_emulator.ffwd)
+    {
+        switch (config_emulator.ffwd_speed)
+        {
+            case 0:
+                return 16.666f / 1.5f;
+            case 1:
+                return 16.666f / 2.0f;
+            case 2:
+                return 16.666f / 2.5f;
+            case 3:
+                return 16.666f / 3.0f;
+            default:
+                return 0.0f;
+        }
+    }
+
+    return emu_audio_sync ? 0.0f : 16.666f;
 }
 
 static void save_window_size(void)
@@ -131,6 +131,7 @@ void config_init(void)
     config_setShortcut(gui_ShortcutReset, KMOD_CTRL, SDL_SCANCODE_R);
     config_setShortcut(gui_ShortcutPause, KMOD_CTRL, SDL_SCANCODE_P);
     config_setShortcut(gui_ShortcutFFWD, KMOD_CTRL, SDL_SCANCODE_F);
+    config_setShortcut(gui_ShortcutRewind, KMOD_CTRL, SDL_SCANCODE_B);
     config_setShortcut(gui_ShortcutSaveState, KMOD_CTRL, SDL_SCANCODE_S);
     config_setShortcut(gui_ShortcutLoadState, KMOD_CTRL, SDL_SCANCODE_L);
     config_setShortcut(gui_ShortcutScreenshot, KMOD_CTRL, SDL_SCANCODE_X);
@@ -180,6 +181,9 @@ void config_read(void)
     config_emulator.fullscreen = read_bool("Emulator", "FullScreen", false);
     config_emulator.show_menu = read_bool("Emulator", "ShowMenu", true);
     config_emulator.ffwd_speed = read_int("Emulator", "FFWD", 1);
+    config_emulator.rewind_buffer = read_int("Emulator", "RewindBuffer", 0);
+    config_emulator.runahead = read_int("Emulator", "RunAhead", 0);
+    config_emulator.runahead_second_instance = read_bool("Emulator", "RunAheadSecondInstance", false);
     config_emulator.save_slot = read_int("Emulator", "SaveSlot", 0);
     config_emulator.start_paused = read_bool("Emulator", "StartPaused", false);
     config_emulator.system = read_int("Emulator", "System", 0);
@@ -285,6 +289,9 @@ void config_write(void)
     write_bool("Emulator", "FullScreen", config_emulator.fullscreen);
     write_bool("Emulator", "ShowMenu", config_emulator.show_menu);
     write_int("Emulator", "FFWD", config_emulator.ffwd_speed);
+    write_int("Emulator", "RewindBuffer", config_emulator.rewind_buffer);
+    write_int("Emulator", "RunAhead", config_emulator.runahead);
+    write_bool("Emulator", "RunAheadSecondInstance", config_emulator.runahead_second_instance);
     write_int("Emulator", "SaveSlot", config_emulator.save_slot);
     write_bool("Emulator", "StartPaused", config_emulator.start_paused);
     write_int("Emulator", "System", config_emulator.system);
@@ -44,6 +44,10 @@ struct config_Emulator
     bool start_paused = false;
     bool ffwd = false;
     int ffwd_speed = 1;
+    bool rewind = false;
+    int rewind_buffer = 0;
+    int runahead = 0;
+    bool runahead_second_instance = false;
     int system = 0;
     int zone = 0;
     int mapper = 0;
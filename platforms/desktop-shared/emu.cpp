@@ -29,13 +29,31 @@
 #endif
 #include "stb/stb_image_write.h"
 
+#define FRAME_READY 4
+
 static GearsystemCore* gearsystem;
 static Sound_Queue* sound_queue;
 static s16* audio_buffer;
 static bool audio_enabled;
 static bool debugging = false;
+static bool debug_enabled = false;
 static bool debug_step = false;
 static bool debug_next_frame = false;
+static SDL_mutex* core_mutex;
+static SDL_atomic_t core_lock_requests;
+static SDL_atomic_t audio_reset_request;
+
+// Triple buffer between the emulation and the render thread. The emulation
+// thread renders into render_buffer and copies each finished frame to
+// frame_buffers[frame_back]. Publishing swaps it with the shared middle
+// index. The renderer swaps frame_front with the middle index only when
+// FRAME_READY is set.
+static u8* render_buffer;
+static u8* frame_buffers[3];
+static GS_RuntimeInfo frame_runtimes[3];
+static int frame_back;
+static int frame_front;
+static SDL_atomic_t frame_middle;
 
 u16* debug_background_buffer;
 u16* debug_tile_buffer;
@@ -43,6 +61,8 @@ u16* debug_sprite_buffers[64];
 
 static void save_ram(void);
 static void load_ram(void);
+static void publish_frame(void);
+static void discard_pending_frame(void);
 static const char* get_mapper(Cartridge::CartridgeTypes type);
 static const char* get_zone(Cartridge::CartridgeZones zone);
 static void init_debug(void);
@@ -59,19 +79,37 @@ void emu_init(void)
 {
     int screen_size = GS_RESOLUTION_MAX_WIDTH_WITH_OVERSCAN * GS_RESOLUTION_MAX_HEIGHT_WITH_OVERSCAN;
 
-    emu_frame_buffer = new u8[screen_size * 3];
+    render_buffer = new u8[screen_size * 3];
+
+    for (int i = 0; i < (screen_size * 3); i++)
+        render_buffer[i] = 0;
 
-    for (int i=0, j=0; i < screen_size; i++, j+=3)
+    for (int f = 0; f < 3; f++)
     {
-        emu_frame_buffer[j] = 0;
-        emu_frame_buffer[j+1] = 0;
-        emu_frame_buffer[j+2] = 0;
+        frame_buffers[f] = new u8[screen_size * 3];
+
+        for (int i = 0; i < (screen_size * 3); i++)
+            frame_buffers[f][i] = 0;
     }
 
     init_debug();
 
     gearsystem = new GearsystemCore();
     gearsystem->Init();
+    gearsystem->EnableCleanLineSkipping(true);
+
+    for (int f = 0; f < 3; f++)
+        gearsystem->GetRuntimeInfo(frame_runtimes[f]);
+
+    frame_back = 0;
+    frame_front = 1;
+    SDL_AtomicSet(&frame_middle, 2);
+    emu_frame_buffer = frame_buffers[frame_front];
+    emu_frame_runtime = frame_runtimes[frame_front];
+
+    core_mutex = SDL_CreateMutex();
+    SDL_AtomicSet(&core_lock_requests, 0);
+    SDL_AtomicSet(&audio_reset_request, 0);
 
     sound_queue = new Sound_Queue();
     sound_queue->start(GS_AUDIO_SAMPLE_RATE, 2);
@@ -83,6 +121,8 @@ void emu_init(void)
 
     audio_enabled = true;
     emu_audio_sync = true;
+    emu_frame_skip = false;
+    emu_rewind = false;
     emu_debug_disable_breakpoints_cpu = false;
     emu_debug_disable_breakpoints_mem = false;
     emu_debug_tile_palette = 0;
@@ -98,44 +138,134 @@ void emu_destroy(void)
     SafeDeleteArray(audio_buffer);
     SafeDelete(sound_queue);
     SafeDelete(gearsystem);
-    SafeDeleteArray(emu_frame_buffer);
+    SafeDeleteArray(render_buffer);
+    for (int f = 0; f < 3; f++)
+        SafeDeleteArray(frame_buffers[f]);
+    InitPointer(emu_frame_buffer);
+    SDL_DestroyMutex(core_mutex);
     destroy_debug();
 }
 
+// Serializes access to the core between the emulation thread and the main
+// thread. The main thread holds it while it handles events and builds the
+// GUI, so every emu_* call made from there is already covered.
+void emu_lock(void)
+{
+    SDL_AtomicAdd(&core_lock_requests, 1);
+    SDL_LockMutex(core_mutex);
+    SDL_AtomicAdd(&core_lock_requests, -1);
+}
+
+void emu_unlock(void)
+{
+    SDL_UnlockMutex(core_mutex);
+}
+
 void emu_load_rom(const char* file_path, Cartridge::ForceConfiguration config)
 {
     save_ram();
     gearsystem->LoadROM(file_path, &config);
     load_ram();
+    discard_pending_frame();
     emu_debug_continue();
 }
 
-void emu_update(void)
+// Runs on the emulation thread. Returns false when the core did not run,
+// so the caller knows no audio was queued to pace it.
+bool emu_update(void)
 {
-    if (!emu_is_empty())
-    {
-        int sampleCount = 0;
+    bool ran = false;
+    bool sync = true;
+    int sampleCount = 0;
+
+    // Let the main thread in first when it is waiting for the core
+    while (SDL_AtomicGet(&core_lock_requests) > 0)
+        SDL_Delay(1);
 
+    SDL_LockMutex(core_mutex);
+
+    if (!emu_is_empty() && !gearsystem->IsPaused())
+    {
         if (!debugging || debug_step || debug_next_frame)
         {
             bool breakpoints = (!emu_debug_disable_breakpoints_cpu && !emu_debug_disable_breakpoints_mem) || IsValidPointer(gearsystem->GetMemory()->GetRunToBreakpoint());
+            bool rewinding = emu_rewind && !debugging;
+            int flags = GS_RUN_DEFAULT;
+
+            // When frames are produced faster than they are shown, the ones
+            // the renderer would never pick up are not drawn at all
+            bool skip_frame = emu_frame_skip && !debug_enabled && ((SDL_AtomicGet(&frame_middle) & FRAME_READY) != 0);
+
+            if (skip_frame)
+                flags = GS_RUN_SKIP_RENDER;
 
-            if (gearsystem->RunToVBlank(emu_frame_buffer, audio_buffer, &sampleCount, debug_step, breakpoints))
+            // While rewinding, each frame goes back one snapshot and then
+            // runs forward once so there is something to show
+            if (!rewinding || gearsystem->GetRewind()->StepBack())
             {
-                debugging = true;
+                // Run-ahead knows nothing about breakpoints, keep it out of
+                // the way while the debugger is open
+                if (!debug_enabled && !rewinding)
+                {
+                    gearsystem->GetRunAhead()->RunToVBlank(render_buffer, audio_buffer, &sampleCount, flags);
+                }
+                else if (gearsystem->RunToVBlank(render_buffer, audio_buffer, &sampleCount, debug_step, breakpoints, flags))
+                {
+                    debugging = true;
+                }
+
+                if (rewinding)
+                    sampleCount = 0;
+                else if (!debugging)
+                    gearsystem->GetRewind()->Capture();
+
+                ran = true;
+
+                if (!skip_frame)
+                    publish_frame();
             }
 
             debug_next_frame = false;
             debug_step = false;
         }
+    }
 
-        update_debug();
+    sync = emu_audio_sync;
 
-        if ((sampleCount > 0) && !gearsystem->IsPaused())
-        {
-            sound_queue->write(audio_buffer, sampleCount, emu_audio_sync);
-        }
+    SDL_UnlockMutex(core_mutex);
+
+    if (SDL_AtomicSet(&audio_reset_request, 0) != 0)
+    {
+        sound_queue->stop();
+        sound_queue->start(GS_AUDIO_SAMPLE_RATE, 2);
     }
+
+    if (sampleCount > 0)
+    {
+        sound_queue->write(audio_buffer, sampleCount, sync);
+    }
+
+    return ran;
+}
+
+// Runs on the render thread. Picks up the latest published frame, if any,
+// into emu_frame_buffer and emu_frame_runtime.
+bool emu_acquire_frame(void)
+{
+    if ((SDL_AtomicGet(&frame_middle) & FRAME_READY) == 0)
+        return false;
+
+    frame_front = SDL_AtomicSet(&frame_middle, frame_front) & ~FRAME_READY;
+    emu_frame_buffer = frame_buffers[frame_front];
+    emu_frame_runtime = frame_runtimes[frame_front];
+
+    return true;
+}
+
+void emu_update_debug(void)
+{
+    if (!emu_is_empty())
+        update_debug();
 }
 
 void emu_key_pressed(GS_Joypads pad, GS_Keys key)
@@ -173,6 +303,7 @@ void emu_reset(Cartridge::ForceConfiguration config)
     save_ram();
     gearsystem->ResetROM(&config);
     load_ram();
+    discard_pending_frame();
 }
 
 void emu_memory_dump(void)
@@ -191,10 +322,11 @@ void emu_audio_mute(bool mute)
     gearsystem->GetAudio()->Mute(mute);
 }
 
+// The emulation thread may be blocked writing to the queue, so it is the
+// one that restarts it
 void emu_audio_reset(void)
 {
-    sound_queue->stop();
-    sound_queue->start(GS_AUDIO_SAMPLE_RATE, 2);
+    SDL_AtomicSet(&audio_reset_request, 1);
 }
 
 bool emu_is_audio_enabled(void)
@@ -298,6 +430,12 @@ GearsystemCore* emu_get_core(void)
     return gearsystem;
 }
 
+void emu_debug_enable(bool enable)
+{
+    debug_enabled = enable;
+    gearsystem->EnableDebug(enable);
+}
+
 void emu_debug_step(void)
 {
     debugging = debug_step = true;
@@ -404,13 +542,23 @@ void emu_disable_ym2413(bool disable)
     gearsystem->GetAudio()->DisableYM2413(disable);
 }
 
+void emu_set_rewind_buffer(int megabytes)
+{
+    gearsystem->GetRewind()->SetBufferSize(megabytes * 1024 * 1024);
+}
+
+void emu_set_runahead(int frames, bool second_instance)
+{
+    gearsystem->GetRunAhead()->SetFrames(frames);
+    gearsystem->GetRunAhead()->EnableSecondInstance(second_instance);
+}
+
 void emu_save_screenshot(const char* file_path)
 {
     if (!gearsystem->GetCartridge()->IsReady())
         return;
 
-    GS_RuntimeInfo runtime;
-    emu_get_runtime(runtime);
+    GS_RuntimeInfo runtime = emu_frame_runtime;
 
     Log("Saving screenshot to %s", file_path);
 
@@ -439,6 +587,23 @@ static void load_ram(void)
         gearsystem->LoadRam();
 }
 
+static void publish_frame(void)
+{
+    GS_RuntimeInfo& runtime = frame_runtimes[frame_back];
+    gearsystem->GetRuntimeInfo(runtime);
+
+    memcpy(frame_buffers[frame_back], render_buffer, runtime.screen_width * runtime.screen_height * 3);
+
+    frame_back = SDL_AtomicSet(&frame_middle, frame_back | FRAME_READY) & ~FRAME_READY;
+}
+
+// Called with the core locked, so the emulation thread can not publish
+// a frame at the same time
+static void discard_pending_frame(void)
+{
+    SDL_AtomicSet(&frame_middle, SDL_AtomicGet(&frame_middle) & ~FRAME_READY);
+}
+
 static const char* get_mapper(Cartridge::CartridgeTypes type)
 {
     switch (type)
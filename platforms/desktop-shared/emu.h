@@ -29,11 +29,14 @@
 #endif
 
 EXTERN u8* emu_frame_buffer;
+EXTERN GS_RuntimeInfo emu_frame_runtime;
 EXTERN u8* emu_debug_background_buffer;
 EXTERN u8* emu_debug_tile_buffer;
 EXTERN u8* emu_debug_sprite_buffers[64];
 
 EXTERN bool emu_audio_sync;
+EXTERN bool emu_rewind;
+EXTERN bool emu_frame_skip;
 EXTERN bool emu_debug_disable_breakpoints_cpu;
 EXTERN bool emu_debug_disable_breakpoints_mem;
 EXTERN int emu_debug_tile_palette;
@@ -44,7 +47,11 @@ EXTERN char emu_savestates_path[4096];
 
 EXTERN void emu_init(void);
 EXTERN void emu_destroy(void);
-EXTERN void emu_update(void);
+EXTERN bool emu_update(void);
+EXTERN bool emu_acquire_frame(void);
+EXTERN void emu_update_debug(void);
+EXTERN void emu_lock(void);
+EXTERN void emu_unlock(void);
 EXTERN void emu_load_rom(const char* file_path, Cartridge::ForceConfiguration config);
 EXTERN void emu_key_pressed(GS_Joypads pad, GS_Keys key);
 EXTERN void emu_key_released(GS_Joypads pad, GS_Keys key);
@@ -69,6 +76,7 @@ EXTERN void emu_clear_cheats();
 EXTERN void emu_get_runtime(GS_RuntimeInfo& runtime);
 EXTERN void emu_get_info(char* info);
 EXTERN GearsystemCore* emu_get_core(void);
+EXTERN void emu_debug_enable(bool enable);
 EXTERN void emu_debug_step(void);
 EXTERN void emu_debug_continue(void);
 EXTERN void emu_debug_next_frame(void);
@@ -80,6 +88,8 @@ EXTERN void emu_set_media_slot(int slot);
 EXTERN void emu_set_3d_glasses_config(int config);
 EXTERN void emu_set_overscan(int overscan);
 EXTERN void emu_disable_ym2413(bool disable);
+EXTERN void emu_set_rewind_buffer(int megabytes);
+EXTERN void emu_set_runahead(int frames, bool second_instance);
 EXTERN void emu_save_screenshot(const char* file_path);
 
 #undef EMU_IMPORT
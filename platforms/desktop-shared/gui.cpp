@@ -73,6 +73,8 @@ static void push_recent_rom(std::string path);
 static void menu_reset(void);
 static void menu_pause(void);
 static void menu_ffwd(void);
+static void menu_rewind(void);
+static void menu_rewind_buffer(void);
 static void show_info(void);
 static void show_fps(void);
 static void show_status_message(void);
@@ -127,6 +129,8 @@ void gui_init(void)
     emu_set_media_slot(config_emulator.media);
     emu_set_overscan(config_debug.debug ? 0 : config_video.overscan);
     emu_disable_ym2413(config_audio.ym2413 == 1);
+    menu_rewind_buffer();
+    emu_set_runahead(config_emulator.runahead, config_emulator.runahead_second_instance);
 }
 
 void gui_destroy(void)
@@ -175,6 +179,10 @@ void gui_shortcut(gui_ShortCutEvent event)
         config_emulator.ffwd = !config_emulator.ffwd;
         menu_ffwd();
         break;
+    case gui_ShortcutRewind:
+        config_emulator.rewind = !config_emulator.rewind;
+        menu_rewind();
+        break;
     case gui_ShortcutSaveState:
     {
         std::string message("Saving state to slot ");
@@ -375,6 +383,39 @@ static void main_menu(void)
                 ImGui::EndMenu();
             }
 
+            gui_event_get_shortcut_string(shortcut, sizeof(shortcut), gui_ShortcutRewind);
+            if (ImGui::MenuItem("Rewind", shortcut, &config_emulator.rewind, config_emulator.rewind_buffer > 0))
+            {
+                menu_rewind();
+            }
+
+            if (ImGui::BeginMenu("Rewind Buffer"))
+            {
+                ImGui::PushItemWidth(100.0f);
+                if (ImGui::Combo("##rewind", &config_emulator.rewind_buffer, "Disabled\08 MB\016 MB\032 MB\064 MB\0\0"))
+                {
+                    menu_rewind_buffer();
+                }
+                ImGui::PopItemWidth();
+                ImGui::EndMenu();
+            }
+
+            if (ImGui::BeginMenu("Run-Ahead"))
+            {
+                ImGui::PushItemWidth(100.0f);
+                if (ImGui::Combo("##runahead", &config_emulator.runahead, "Disabled\01 frame\02 frames\03 frames\04 frames\0\0"))
+                {
+                    emu_set_runahead(config_emulator.runahead, config_emulator.runahead_second_instance);
+                }
+                ImGui::PopItemWidth();
+
+                if (ImGui::MenuItem("Use Second Instance", "", &config_emulator.runahead_second_instance))
+                {
+                    emu_set_runahead(config_emulator.runahead, config_emulator.runahead_second_instance);
+                }
+                ImGui::EndMenu();
+            }
+
             ImGui::Separator();
 
             if (ImGui::MenuItem("Save RAM As...")) 
@@ -929,6 +970,7 @@ static void main_menu(void)
 
             if (ImGui::MenuItem("Enable", "", &config_debug.debug))
             {
+                emu_debug_enable(config_debug.debug);
                 emu_set_overscan(config_debug.debug ? 0 : config_video.overscan);
 
                 if (config_debug.debug)
@@ -1712,6 +1754,27 @@ static void menu_ffwd(void)
     }
 }
 
+static void menu_rewind(void)
+{
+    if (config_emulator.rewind_buffer == 0)
+        config_emulator.rewind = false;
+
+    emu_rewind = config_emulator.rewind;
+    gui_set_status_message(config_emulator.rewind ? "Rewind ON" : "Rewind OFF", 3000);
+}
+
+static void menu_rewind_buffer(void)
+{
+    int megabytes = (config_emulator.rewind_buffer > 0) ? (4 << config_emulator.rewind_buffer) : 0;
+    emu_set_rewind_buffer(megabytes);
+
+    if (megabytes == 0 && config_emulator.rewind)
+    {
+        config_emulator.rewind = false;
+        menu_rewind();
+    }
+}
+
 static void show_info(void)
 {
     ImGui::Begin("ROM Info", &config_emulator.show_info, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoResize);
@@ -309,6 +309,8 @@ static void debug_window_memory(void)
         {
             ImGui::PushFont(gui_default_font);
             mem_edit.DrawContents(video->GetVRAM(), 0x4000, 0);
+            video->InvalidateTileCache();
+            video->InvalidateSpriteCache();
             ImGui::PopFont();
             ImGui::EndTabItem();
         }
@@ -340,9 +342,6 @@ static void debug_window_disassembler(void)
     Memory* memory = core->GetMemory();
     std::vector<Memory::stDisassembleRecord*>* breakpoints_cpu = memory->GetBreakpointsCPU();
     std::vector<Memory::stMemoryBreakpoint>* breakpoints_mem = memory->GetBreakpointsMem();
-    Memory::stDisassembleRecord** memory_map = memory->GetDisassembledMemoryMap();
-    Memory::stDisassembleRecord** rom_map = memory->GetDisassembledROMMemoryMap();
-    Memory::stDisassembleRecord** map = NULL;
 
     int pc = proc_state->PC->GetValue();
 
@@ -572,29 +571,29 @@ static void debug_window_disassembler(void)
         {
             int offset = i;
             int bank = 0;
+            bool rom = true;
 
             switch (i & 0xC000)
             {
             case 0x0000:
                 bank = memory->GetCurrentRule()->GetBank(0);
                 offset = (0x4000 * bank) + i;
-                map = rom_map;
                 break;
             case 0x4000:
                 bank = memory->GetCurrentRule()->GetBank(1);
                 offset = (0x4000 * bank) + (i & 0x3FFF);
-                map = rom_map;
                 break;
             case 0x8000:
                 bank = memory->GetCurrentRule()->GetBank(2);
                 offset = (0x4000 * bank) + (i & 0x3FFF);
-                map = rom_map;
                 break;
             default:
-                map = memory_map;
+                rom = false;
             }
 
-            if (IsValidPointer(map[offset]) && (map[offset]->name[0] != 0))
+            Memory::stDisassembleRecord* record = memory->GetDisassembleRecord(offset, rom);
+
+            if (IsValidPointer(record) && (record->name[0] != 0))
             {
                 for (long unsigned int s = 0; s < symbols.size(); s++)
                 {
@@ -607,7 +606,7 @@ static void debug_window_disassembler(void)
                 }
 
                 vec[dis_size].is_symbol = false;
-                vec[dis_size].record = map[offset];
+                vec[dis_size].record = record;
 
                 if (vec[dis_size].record->address == pc)
                     pc_pos = dis_size;
@@ -1603,39 +1602,35 @@ static void add_breakpoint_cpu(void)
         return;
     }
 
-    Memory::stDisassembleRecord** memoryMap = emu_get_core()->GetMemory()->GetDisassembledMemoryMap();
-    Memory::stDisassembleRecord** romMap = emu_get_core()->GetMemory()->GetDisassembledROMMemoryMap();
-    Memory::stDisassembleRecord** map = NULL;
+    Memory* memory = emu_get_core()->GetMemory();
 
     bool rom = true;
 
     if ((target_address & 0xC000) == 0x0000)
     {
         target_offset = (0x4000 * target_bank) + target_address;
-        map = romMap;
     }
     else if ((target_address & 0xC000) == 0x4000)
     {
         target_offset = (0x4000 * target_bank) + (target_address & 0x3FFF);
-        map = romMap;
     }
     else
     {
         target_offset = target_address;
-        map = memoryMap;
         rom = false;
     }
 
     brk_address_cpu[0] = 0;
 
     bool found = false;
-    std::vector<Memory::stDisassembleRecord*>* breakpoints = emu_get_core()->GetMemory()->GetBreakpointsCPU();
+    std::vector<Memory::stDisassembleRecord*>* breakpoints = memory->GetBreakpointsCPU();
+    Memory::stDisassembleRecord* record = memory->GetDisassembleRecord(target_offset, rom);
 
-    if (IsValidPointer(map[target_offset]))
+    if (IsValidPointer(record))
     {
         for (long unsigned int b = 0; b < breakpoints->size(); b++)
         {
-            if ((*breakpoints)[b] == map[target_offset])
+            if ((*breakpoints)[b] == record)
             {
                 found = true;
                 break;
@@ -1645,31 +1640,7 @@ static void add_breakpoint_cpu(void)
 
     if (!found)
     {
-        if (!IsValidPointer(map[target_offset]))
-        {
-            map[target_offset] = new Memory::stDisassembleRecord;
-
-            if (rom)
-            {
-                map[target_offset]->address = target_offset & 0x3FFF;
-                map[target_offset]->bank = target_offset >> 14;
-            }
-            else
-            {
-                map[target_offset]->address = 0;
-                map[target_offset]->bank = 0;
-            }
-
-            map[target_offset]->name[0] = 0;
-            map[target_offset]->bytes[0] = 0;
-            map[target_offset]->size = 0;
-            map[target_offset]->jump = false;
-            map[target_offset]->jump_address = 0;
-            for (int i = 0; i < 4; i++)
-                map[target_offset]->opcodes[i] = 0;
-        }
-
-        breakpoints->push_back(map[target_offset]);
+        breakpoints->push_back(memory->GetOrCreateDisassembleRecord(target_offset, rom));
     }
 }
 
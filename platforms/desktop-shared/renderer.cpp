@@ -105,7 +105,8 @@ void renderer_begin_render(void)
 
 void renderer_render(void)
 {
-    emu_get_runtime(current_runtime);
+    emu_acquire_frame();
+    current_runtime = emu_frame_runtime;
 
     renderer_emu_texture = fbo_texture;
 
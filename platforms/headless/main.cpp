@@ -0,0 +1,320 @@
+/*
+ * Gearsystem - Sega Master System / Game Gear Emulator
+ * Copyright (C) 2013  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#include <vector>
+#include <chrono>
+#include "../../src/gearsystem.h"
+
+#define HEADLESS_BUFFER_SIZE (GS_RESOLUTION_MAX_WIDTH_WITH_OVERSCAN * GS_RESOLUTION_MAX_HEIGHT_WITH_OVERSCAN * 3)
+
+struct InputEvent
+{
+    int frame;
+    GS_Joypads joypad;
+    GS_Keys key;
+    bool pressed;
+};
+
+static const u64 hash_seed = 14695981039346656037ULL;
+
+static u64 hash_bytes(u64 hash, const void* data, size_t size)
+{
+    const u8* bytes = static_cast<const u8*>(data);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+static bool parse_key(const char* name, GS_Keys& key)
+{
+    static const char* names[] = { "up", "down", "left", "right", "1", "2", "start" };
+
+    for (int i = 0; i < 7; i++)
+    {
+        if (strcmp(name, names[i]) == 0)
+        {
+            key = static_cast<GS_Keys>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool load_input(const char* file_path, std::vector<InputEvent>& events)
+{
+    FILE* file = fopen(file_path, "r");
+
+    if (!IsValidPointer(file))
+    {
+        printf("Unable to open input file %s\n", file_path);
+        return false;
+    }
+
+    char line[256];
+    int line_number = 0;
+
+    while (fgets(line, sizeof(line), file))
+    {
+        line_number++;
+
+        if ((line[0] == '#') || (line[0] == '\n') || (line[0] == '\r'))
+            continue;
+
+        int frame = 0;
+        int pad = 0;
+        char key_name[32];
+        char action[32];
+
+        InputEvent event;
+
+        if ((sscanf(line, "%d %d %31s %31s", &frame, &pad, key_name, action) != 4) ||
+            (pad < 1) || (pad > 2) || !parse_key(key_name, event.key) ||
+            ((strcmp(action, "press") != 0) && (strcmp(action, "release") != 0)))
+        {
+            printf("Invalid input event at %s:%d\n", file_path, line_number);
+            fclose(file);
+            return false;
+        }
+
+        event.frame = frame;
+        event.joypad = (pad == 1) ? Joypad_1 : Joypad_2;
+        event.pressed = (strcmp(action, "press") == 0);
+        events.push_back(event);
+    }
+
+    fclose(file);
+    return true;
+}
+
+static void print_usage(const char* name)
+{
+    printf("Usage: %s [options] rom_file\n", name);
+    printf("Options:\n");
+    printf("  -f, --frames N       number of frames to run (default 600)\n");
+    printf("  -i, --input FILE     replay input events from FILE\n");
+    printf("  -s, --state FILE     save the final state to FILE\n");
+    printf("  -H, --hash-frames    print the hash of every frame\n");
+    printf("  -N, --native         hash the native VDP output instead of converted RGB\n");
+    printf("      --system NAME    force system: sms, gg, sg1000\n");
+    printf("      --region NAME    force region: ntsc, pal\n");
+    printf("Input file lines: <frame> <1|2> <up|down|left|right|1|2|start> <press|release>\n");
+}
+
+int main(int argc, char* argv[])
+{
+    const char* rom_file = NULL;
+    const char* input_file = NULL;
+    const char* state_file = NULL;
+    int frames = 600;
+    bool hash_frames = false;
+    bool native = false;
+
+    Cartridge::ForceConfiguration config;
+    config.type = Cartridge::CartridgeNotSupported;
+    config.zone = Cartridge::CartridgeUnknownZone;
+    config.region = Cartridge::CartridgeUnknownRegion;
+    config.system = Cartridge::CartridgeUnknownSystem;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        bool has_value = (i + 1) < argc;
+
+        if ((strcmp(arg, "-h") == 0) || (strcmp(arg, "--help") == 0))
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else if ((strcmp(arg, "-v") == 0) || (strcmp(arg, "--version") == 0))
+        {
+            printf("%s %s\n", GEARSYSTEM_TITLE, GEARSYSTEM_VERSION);
+            printf("Build: %s\n", EMULATOR_BUILD);
+            return 0;
+        }
+        else if (((strcmp(arg, "-f") == 0) || (strcmp(arg, "--frames") == 0)) && has_value)
+            frames = atoi(argv[++i]);
+        else if (((strcmp(arg, "-i") == 0) || (strcmp(arg, "--input") == 0)) && has_value)
+            input_file = argv[++i];
+        else if (((strcmp(arg, "-s") == 0) || (strcmp(arg, "--state") == 0)) && has_value)
+            state_file = argv[++i];
+        else if ((strcmp(arg, "-H") == 0) || (strcmp(arg, "--hash-frames") == 0))
+            hash_frames = true;
+        else if ((strcmp(arg, "-N") == 0) || (strcmp(arg, "--native") == 0))
+            native = true;
+        else if ((strcmp(arg, "--system") == 0) && has_value)
+        {
+            const char* system = argv[++i];
+            if (strcmp(system, "sms") == 0)
+                config.system = Cartridge::CartridgeSMS;
+            else if (strcmp(system, "gg") == 0)
+                config.system = Cartridge::CartridgeGG;
+            else if (strcmp(system, "sg1000") == 0)
+                config.system = Cartridge::CartridgeSG1000;
+            else
+            {
+                print_usage(argv[0]);
+                return -1;
+            }
+        }
+        else if ((strcmp(arg, "--region") == 0) && has_value)
+        {
+            const char* region = argv[++i];
+            if (strcmp(region, "ntsc") == 0)
+                config.region = Cartridge::CartridgeNTSC;
+            else if (strcmp(region, "pal") == 0)
+                config.region = Cartridge::CartridgePAL;
+            else
+            {
+                print_usage(argv[0]);
+                return -1;
+            }
+        }
+        else if ((arg[0] != '-') && !IsValidPointer(rom_file))
+            rom_file = arg;
+        else
+        {
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (!IsValidPointer(rom_file) || (frames < 0))
+    {
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    std::vector<InputEvent> events;
+
+    if (IsValidPointer(input_file) && !load_input(input_file, events))
+        return -1;
+
+    GearsystemCore* core = new GearsystemCore();
+    core->Init(GS_PIXEL_RGB888);
+
+    if (!core->LoadROM(rom_file, &config))
+    {
+        printf("Unable to load %s\n", rom_file);
+        SafeDelete(core);
+        return -1;
+    }
+
+    std::vector<u8> frame_buffer(HEADLESS_BUFFER_SIZE);
+    std::vector<s16> audio_buffer(GS_AUDIO_BUFFER_SIZE * 2);
+
+    u64 frame_hash = hash_seed;
+    u64 audio_hash = hash_seed;
+    long long total_samples = 0;
+    size_t next_event = 0;
+
+    std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::duration::zero();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        while ((next_event < events.size()) && (events[next_event].frame <= frame))
+        {
+            const InputEvent& event = events[next_event++];
+
+            if (event.pressed)
+                core->KeyPressed(event.joypad, event.key);
+            else
+                core->KeyReleased(event.joypad, event.key);
+        }
+
+        int sample_count = 0;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        core->RunToVBlank(native ? NULL : &frame_buffer[0], &audio_buffer[0], &sample_count);
+        elapsed += std::chrono::steady_clock::now() - start;
+
+        u64 hash = hash_seed;
+
+        if (native)
+        {
+            GS_FrameView view;
+            core->GetFrameView(view);
+
+            for (int y = 0; y < view.height; y++)
+                hash = hash_bytes(hash, view.buffer + (y * view.pitch), view.width * sizeof(u16));
+        }
+        else
+        {
+            GS_RuntimeInfo runtime;
+            core->GetRuntimeInfo(runtime);
+
+            size_t frame_size = runtime.screen_width * runtime.screen_height * 3;
+            hash = hash_bytes(hash_seed, &frame_buffer[0], frame_size);
+        }
+
+        frame_hash = hash_bytes(frame_hash, &hash, sizeof(hash));
+        audio_hash = hash_bytes(audio_hash, &audio_buffer[0], sample_count * sizeof(s16));
+        total_samples += sample_count;
+
+        if (hash_frames)
+            printf("frame %d: %016llx\n", frame, (unsigned long long)hash);
+    }
+
+    size_t state_size = 0;
+    std::vector<u8> state;
+
+    if (core->SaveState(NULL, state_size) && (state_size > 0))
+    {
+        state.resize(state_size);
+        core->SaveState(&state[0], state_size);
+    }
+
+    u64 state_hash = hash_bytes(hash_seed, state.empty() ? NULL : &state[0], state.size());
+
+    if (IsValidPointer(state_file) && !state.empty())
+    {
+        FILE* file = fopen(state_file, "wb");
+
+        if (IsValidPointer(file))
+        {
+            fwrite(&state[0], 1, state.size(), file);
+            fclose(file);
+        }
+        else
+            printf("Unable to write state file %s\n", state_file);
+    }
+
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    Processor::ProcessorState* cpu = core->GetProcessor()->GetState();
+
+    printf("rom: %s\n", rom_file);
+    printf("frames: %d\n", frames);
+    printf("frame_hash: %016llx\n", (unsigned long long)frame_hash);
+    printf("audio_hash: %016llx\n", (unsigned long long)audio_hash);
+    printf("audio_samples: %lld\n", total_samples);
+    printf("state_hash: %016llx\n", (unsigned long long)state_hash);
+    printf("state_size: %d\n", (int)state.size());
+    printf("pc: %04X\n", cpu->PC->GetValue());
+    printf("elapsed_ms: %.3f\n", seconds * 1000.0);
+    printf("fps: %.2f\n", (seconds > 0.0) ? (frames / seconds) : 0.0);
+
+    SafeDelete(core);
+
+    return 0;
+}
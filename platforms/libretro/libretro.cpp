@@ -76,6 +76,8 @@ static const struct retro_variable vars[] = {
     { "gearsystem_ym2413", "YM2413 (restart); Auto|Disabled"},
     { "gearsystem_glasses", "3D Glasses; Both Eyes / OFF|Left Eye|Right Eye" },
     { "gearsystem_up_down_allowed", "Allow Up+Down / Left+Right; Disabled|Enabled" },
+    { "gearsystem_runahead", "Run-Ahead; Disabled|1 frame|2 frames|3 frames|4 frames" },
+    { "gearsystem_runahead_second_instance", "Run-Ahead Second Instance; Disabled|Enabled" },
     { NULL }
 };
 
@@ -109,6 +111,7 @@ void retro_init(void)
 #endif
 
     frame_buffer = new u8[GS_RESOLUTION_MAX_WIDTH_WITH_OVERSCAN * GS_RESOLUTION_MAX_HEIGHT_WITH_OVERSCAN * 2];
+    core->EnableCleanLineSkipping(true);
 
     audio_sample_count = 0;
 
@@ -498,6 +501,25 @@ static void check_variables(void)
 
         core->SetGlassesConfig(glasses_config);
     }
+
+    var.key = "gearsystem_runahead";
+    var.value = NULL;
+
+    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+    {
+        if (strcmp(var.value, "Disabled") == 0)
+            core->GetRunAhead()->SetFrames(0);
+        else
+            core->GetRunAhead()->SetFrames(atoi(var.value));
+    }
+
+    var.key = "gearsystem_runahead_second_instance";
+    var.value = NULL;
+
+    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+    {
+        core->GetRunAhead()->EnableSecondInstance(strcmp(var.value, "Enabled") == 0);
+    }
 }
 
 void retro_run(void)
@@ -512,7 +534,20 @@ void retro_run(void)
 
     audio_sample_count = 0;
 
-    core->RunToVBlank(frame_buffer, audio_buf, &audio_sample_count);
+    // Frontends hide frames while running ahead or fast-forwarding,
+    // there is no point in drawing or mixing them
+    int run_flags = GS_RUN_DEFAULT;
+    int av_enable = 3;
+
+    if (environ_cb(RETRO_ENVIRONMENT_GET_AUDIO_VIDEO_ENABLE, &av_enable))
+    {
+        if (!(av_enable & 1))
+            run_flags |= GS_RUN_SKIP_RENDER;
+        if (!(av_enable & 2))
+            run_flags |= GS_RUN_SKIP_AUDIO;
+    }
+
+    core->GetRunAhead()->RunToVBlank(frame_buffer, audio_buf, &audio_sample_count, run_flags);
 
     GS_RuntimeInfo runtime_info;
     core->GetRuntimeInfo(runtime_info);
@@ -591,9 +626,7 @@ bool retro_load_game_special(unsigned type, const struct retro_game_info *info,
 
 size_t retro_serialize_size(void)
 {
-    size_t size = 0;
-    core->SaveState(NULL, size);
-    return size;
+    return core->GetStateSize();
 }
 
 bool retro_serialize(void *data, size_t size)
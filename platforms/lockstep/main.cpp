@@ -0,0 +1,165 @@
+/*
+ * Gearsystem - Sega Master System / Game Gear Emulator
+ * Copyright (C) 2013  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#include <vector>
+#include "../../src/gearsystem.h"
+
+#define LOCKSTEP_BUFFER_SIZE (GS_RESOLUTION_MAX_WIDTH_WITH_OVERSCAN * GS_RESOLUTION_MAX_HEIGHT_WITH_OVERSCAN * 3)
+
+struct Instance
+{
+    GearsystemCore* core;
+    std::vector<Processor::stLockstepRecord> trace;
+    std::vector<u8> frame_buffer;
+    std::vector<s16> audio_buffer;
+    int sample_count;
+};
+
+static const char* interpreter_names[] = { "table", "switch" };
+
+static bool init_instance(Instance& instance, const char* rom_file, Processor::Interpreter interpreter)
+{
+    instance.core = new GearsystemCore();
+    instance.core->Init(GS_PIXEL_RGB888);
+    instance.core->GetProcessor()->SetInterpreter(interpreter);
+    instance.core->GetProcessor()->SetLockstepTrace(&instance.trace);
+    instance.frame_buffer.resize(LOCKSTEP_BUFFER_SIZE);
+    instance.audio_buffer.resize(GS_AUDIO_BUFFER_SIZE * 2);
+    instance.sample_count = 0;
+
+    return instance.core->LoadROM(rom_file);
+}
+
+static void print_record(const char* name, const Processor::stLockstepRecord& r)
+{
+    printf("  %-6s PC:%04X SP:%04X AF:%04X BC:%04X DE:%04X HL:%04X IX:%04X IY:%04X WZ:%04X\n",
+           name, r.PC, r.SP, r.AF, r.BC, r.DE, r.HL, r.IX, r.IY, r.WZ);
+    printf("         AF':%04X BC':%04X DE':%04X HL':%04X I:%02X R:%02X FLAGS:%02X T:%d\n",
+           r.AF2, r.BC2, r.DE2, r.HL2, r.I, r.R, r.flags, r.tstates);
+}
+
+static bool compare_traces(int frame, Instance& a, Instance& b)
+{
+    size_t count = std::min(a.trace.size(), b.trace.size());
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (memcmp(&a.trace[i], &b.trace[i], sizeof(Processor::stLockstepRecord)) != 0)
+        {
+            printf("Divergence at frame %d, instruction %d\n", frame, (int)i);
+            if (i > 0)
+                print_record("before", a.trace[i - 1]);
+            print_record(interpreter_names[Processor::InterpreterTable], a.trace[i]);
+            print_record(interpreter_names[Processor::InterpreterSwitch], b.trace[i]);
+            return false;
+        }
+    }
+
+    if (a.trace.size() != b.trace.size())
+    {
+        printf("Divergence at frame %d: %d vs %d instructions\n", frame, (int)a.trace.size(), (int)b.trace.size());
+        return false;
+    }
+
+    return true;
+}
+
+static bool compare_outputs(int frame, Instance& a, Instance& b)
+{
+    if (a.frame_buffer != b.frame_buffer)
+    {
+        printf("Frame buffer mismatch at frame %d\n", frame);
+        return false;
+    }
+
+    if ((a.sample_count != b.sample_count) || (memcmp(&a.audio_buffer[0], &b.audio_buffer[0], a.sample_count * sizeof(s16)) != 0))
+    {
+        printf("Audio mismatch at frame %d\n", frame);
+        return false;
+    }
+
+    return true;
+}
+
+static void press_keys(Instance& instance, int frame)
+{
+    static const GS_Keys keys[] = { Key_Up, Key_Down, Key_Left, Key_Right, Key_1, Key_2, Key_Start };
+    const int key_count = sizeof(keys) / sizeof(keys[0]);
+    int step = frame / 20;
+
+    if ((frame % 20) == 0)
+        instance.core->KeyPressed(Joypad_1, keys[step % key_count]);
+    else if ((frame % 20) == 10)
+        instance.core->KeyReleased(Joypad_1, keys[step % key_count]);
+}
+
+int main(int argc, char* argv[])
+{
+    if ((argc < 2) || (argc > 3))
+    {
+        printf("Usage: %s rom_file [frames]\n", argv[0]);
+        printf("Runs the table and switch Z80 interpreters side by side and\n");
+        printf("reports the first instruction where their state differs.\n");
+        return -1;
+    }
+
+    const char* rom_file = argv[1];
+    int frames = (argc == 3) ? atoi(argv[2]) : 600;
+
+    Instance table;
+    Instance fast;
+
+    if (!init_instance(table, rom_file, Processor::InterpreterTable) ||
+        !init_instance(fast, rom_file, Processor::InterpreterSwitch))
+    {
+        printf("Unable to load %s\n", rom_file);
+        return -1;
+    }
+
+    unsigned long long instructions = 0;
+    int ret = 0;
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        table.trace.clear();
+        fast.trace.clear();
+
+        press_keys(table, frame);
+        press_keys(fast, frame);
+
+        table.core->RunToVBlank(&table.frame_buffer[0], &table.audio_buffer[0], &table.sample_count);
+        fast.core->RunToVBlank(&fast.frame_buffer[0], &fast.audio_buffer[0], &fast.sample_count);
+
+        if (!compare_traces(frame, table, fast) || !compare_outputs(frame, table, fast))
+        {
+            ret = 1;
+            break;
+        }
+
+        instructions += table.trace.size();
+    }
+
+    if (ret == 0)
+        printf("OK: %d frames, %llu instructions in lockstep\n", frames, instructions);
+
+    SafeDelete(table.core);
+    SafeDelete(fast.core);
+
+    return ret;
+}
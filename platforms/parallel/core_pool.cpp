@@ -0,0 +1,166 @@
+/*
+ * Gearsystem - Sega Master System / Game Gear Emulator
+ * Copyright (C) 2013  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#include "core_pool.h"
+
+#define CORE_POOL_FRAME_BUFFER_SIZE (GS_RESOLUTION_MAX_WIDTH_WITH_OVERSCAN * GS_RESOLUTION_MAX_HEIGHT_WITH_OVERSCAN * 3)
+
+CorePool::CorePool(int threads)
+{
+    m_iNextSlot = 0;
+    m_iPendingSlots = 0;
+    m_iFrames = 0;
+    m_iGeneration = 0;
+    m_bQuit = false;
+    m_pFrameCallback = NULL;
+    InitPointer(m_pCallbackData);
+
+    if (threads < 1)
+        threads = 1;
+
+    for (int i = 0; i < threads; i++)
+        m_Threads.push_back(std::thread(&CorePool::WorkerLoop, this));
+}
+
+CorePool::~CorePool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_bQuit = true;
+    }
+
+    m_WorkCondition.notify_all();
+
+    for (size_t i = 0; i < m_Threads.size(); i++)
+        m_Threads[i].join();
+
+    for (size_t i = 0; i < m_Slots.size(); i++)
+    {
+        SafeDelete(m_Slots[i]->core);
+        SafeDelete(m_Slots[i]);
+    }
+}
+
+int CorePool::AddCore(GearsystemCore* core)
+{
+    Slot* slot = new Slot();
+    slot->core = core;
+    slot->frame_buffer.resize(CORE_POOL_FRAME_BUFFER_SIZE);
+    slot->audio_buffer.resize(GS_AUDIO_BUFFER_SIZE * 2);
+    slot->sample_count = 0;
+    slot->frame_count = 0;
+
+    m_Slots.push_back(slot);
+
+    return static_cast<int>(m_Slots.size()) - 1;
+}
+
+int CorePool::GetCoreCount()
+{
+    return static_cast<int>(m_Slots.size());
+}
+
+int CorePool::GetThreadCount()
+{
+    return static_cast<int>(m_Threads.size());
+}
+
+CorePool::Slot& CorePool::GetSlot(int index)
+{
+    return *m_Slots[index];
+}
+
+void CorePool::SetFrameCallback(FrameCallback callback, void* user_data)
+{
+    m_pFrameCallback = callback;
+    m_pCallbackData = user_data;
+}
+
+void CorePool::RunFrames(int frames)
+{
+    if (m_Slots.empty() || (frames <= 0))
+        return;
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    m_iFrames = frames;
+    m_iNextSlot = 0;
+    m_iPendingSlots = static_cast<int>(m_Slots.size());
+    m_iGeneration++;
+
+    m_WorkCondition.notify_all();
+
+    while (m_iPendingSlots > 0)
+        m_DoneCondition.wait(lock);
+}
+
+void CorePool::WorkerLoop()
+{
+    unsigned int generation = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            while (!m_bQuit && (generation == m_iGeneration))
+                m_WorkCondition.wait(lock);
+
+            if (m_bQuit)
+                return;
+
+            generation = m_iGeneration;
+        }
+
+        // Cores are handed out one at a time so a slow ROM does not leave
+        // the other workers idle
+        int completed = 0;
+        int count = static_cast<int>(m_Slots.size());
+
+        for (int index = m_iNextSlot++; index < count; index = m_iNextSlot++)
+        {
+            RunSlot(index);
+            completed++;
+        }
+
+        if (completed > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_iPendingSlots -= completed;
+
+            if (m_iPendingSlots == 0)
+                m_DoneCondition.notify_one();
+        }
+    }
+}
+
+void CorePool::RunSlot(int index)
+{
+    Slot* slot = m_Slots[index];
+
+    for (int frame = 0; frame < m_iFrames; frame++)
+    {
+        slot->sample_count = 0;
+        slot->core->RunToVBlank(&slot->frame_buffer[0], &slot->audio_buffer[0], &slot->sample_count);
+        slot->frame_count++;
+
+        if (IsValidPointer(m_pFrameCallback))
+            m_pFrameCallback(index, *slot, m_pCallbackData);
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Gearsystem - Sega Master System / Game Gear Emulator
+ * Copyright (C) 2013  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#ifndef CORE_POOL_H
+#define CORE_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "../../src/gearsystem.h"
+
+class CorePool
+{
+public:
+    struct Slot
+    {
+        GearsystemCore* core;
+        std::vector<u8> frame_buffer;
+        std::vector<s16> audio_buffer;
+        int sample_count;
+        int frame_count;
+    };
+
+    // Called on the worker thread right after a core completes a frame
+    typedef void (*FrameCallback) (int index, Slot& slot, void* user_data);
+
+public:
+    CorePool(int threads);
+    ~CorePool();
+    int AddCore(GearsystemCore* core);
+    int GetCoreCount();
+    int GetThreadCount();
+    Slot& GetSlot(int index);
+    void SetFrameCallback(FrameCallback callback, void* user_data);
+    void RunFrames(int frames);
+
+private:
+    void WorkerLoop();
+    void RunSlot(int index);
+
+private:
+    std::vector<std::thread> m_Threads;
+    std::vector<Slot*> m_Slots;
+    std::mutex m_Mutex;
+    std::condition_variable m_WorkCondition;
+    std::condition_variable m_DoneCondition;
+    std::atomic<int> m_iNextSlot;
+    int m_iPendingSlots;
+    int m_iFrames;
+    unsigned int m_iGeneration;
+    bool m_bQuit;
+    FrameCallback m_pFrameCallback;
+    void* m_pCallbackData;
+};
+
+#endif /* CORE_POOL_H */
@@ -0,0 +1,212 @@
+/*
+ * Gearsystem - Sega Master System / Game Gear Emulator
+ * Copyright (C) 2013  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#include <chrono>
+#include <algorithm>
+#include "core_pool.h"
+
+struct CoreHashes
+{
+    const char* rom;
+    u64 frame_hash;
+    u64 audio_hash;
+};
+
+static const u64 hash_seed = 14695981039346656037ULL;
+
+static u64 hash_bytes(u64 hash, const void* data, size_t size)
+{
+    const u8* bytes = static_cast<const u8*>(data);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+static void frame_callback(int index, CorePool::Slot& slot, void* user_data)
+{
+    CoreHashes* hashes = static_cast<CoreHashes*>(user_data) + index;
+
+    GS_RuntimeInfo runtime;
+    slot.core->GetRuntimeInfo(runtime);
+
+    size_t frame_size = runtime.screen_width * runtime.screen_height * 3;
+    u64 hash = hash_bytes(hash_seed, &slot.frame_buffer[0], frame_size);
+
+    hashes->frame_hash = hash_bytes(hashes->frame_hash, &hash, sizeof(hash));
+    hashes->audio_hash = hash_bytes(hashes->audio_hash, &slot.audio_buffer[0], slot.sample_count * sizeof(s16));
+}
+
+static GearsystemCore* create_core(const char* rom_file)
+{
+    GearsystemCore* core = new GearsystemCore();
+    core->Init(GS_PIXEL_RGB888);
+
+    if (!core->LoadROM(rom_file))
+    {
+        printf("Unable to load %s\n", rom_file);
+        SafeDelete(core);
+    }
+
+    return core;
+}
+
+static void print_usage(const char* name)
+{
+    printf("Usage: %s [options] rom_file [rom_file ...]\n", name);
+    printf("Options:\n");
+    printf("  -j, --threads N      number of worker threads (default: hardware threads)\n");
+    printf("  -n, --cores N        number of cores, ROMs are assigned round robin (default: threads)\n");
+    printf("  -f, --frames N       number of frames to run (default 600)\n");
+    printf("  -b, --batch N        frames per RunFrames call (default 1)\n");
+    printf("      --verify         check every core against a single threaded run\n");
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<const char*> roms;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    int cores = 0;
+    int frames = 600;
+    int batch = 1;
+    bool verify = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        bool has_value = (i + 1) < argc;
+
+        if ((strcmp(arg, "-h") == 0) || (strcmp(arg, "--help") == 0))
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else if ((strcmp(arg, "-v") == 0) || (strcmp(arg, "--version") == 0))
+        {
+            printf("%s %s\n", GEARSYSTEM_TITLE, GEARSYSTEM_VERSION);
+            printf("Build: %s\n", EMULATOR_BUILD);
+            return 0;
+        }
+        else if (((strcmp(arg, "-j") == 0) || (strcmp(arg, "--threads") == 0)) && has_value)
+            threads = atoi(argv[++i]);
+        else if (((strcmp(arg, "-n") == 0) || (strcmp(arg, "--cores") == 0)) && has_value)
+            cores = atoi(argv[++i]);
+        else if (((strcmp(arg, "-f") == 0) || (strcmp(arg, "--frames") == 0)) && has_value)
+            frames = atoi(argv[++i]);
+        else if (((strcmp(arg, "-b") == 0) || (strcmp(arg, "--batch") == 0)) && has_value)
+            batch = atoi(argv[++i]);
+        else if (strcmp(arg, "--verify") == 0)
+            verify = true;
+        else if (arg[0] != '-')
+            roms.push_back(arg);
+        else
+        {
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (threads < 1)
+        threads = 1;
+    if (cores < 1)
+        cores = threads;
+
+    if (roms.empty() || (frames < 0) || (batch < 1))
+    {
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    std::vector<CoreHashes> hashes(cores);
+    CorePool* pool = new CorePool(threads);
+
+    for (int i = 0; i < cores; i++)
+    {
+        const char* rom_file = roms[i % roms.size()];
+        GearsystemCore* core = create_core(rom_file);
+
+        if (!IsValidPointer(core))
+        {
+            SafeDelete(pool);
+            return -1;
+        }
+
+        pool->AddCore(core);
+        hashes[i].rom = rom_file;
+        hashes[i].frame_hash = hash_seed;
+        hashes[i].audio_hash = hash_seed;
+    }
+
+    pool->SetFrameCallback(frame_callback, &hashes[0]);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame += batch)
+        pool->RunFrames(std::min(batch, frames - frame));
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    SafeDelete(pool);
+
+    int mismatches = 0;
+
+    for (int i = 0; i < cores; i++)
+    {
+        const char* status = "";
+
+        if (verify)
+        {
+            std::vector<CoreHashes> reference(1);
+            reference[0].rom = hashes[i].rom;
+            reference[0].frame_hash = hash_seed;
+            reference[0].audio_hash = hash_seed;
+
+            CorePool* single = new CorePool(1);
+            single->AddCore(create_core(hashes[i].rom));
+            single->SetFrameCallback(frame_callback, &reference[0]);
+            single->RunFrames(frames);
+            SafeDelete(single);
+
+            bool match = (reference[0].frame_hash == hashes[i].frame_hash) &&
+                         (reference[0].audio_hash == hashes[i].audio_hash);
+
+            status = match ? " ok" : " MISMATCH";
+
+            if (!match)
+                mismatches++;
+        }
+
+        printf("core %d: %s frame_hash: %016llx audio_hash: %016llx%s\n", i, hashes[i].rom,
+               (unsigned long long)hashes[i].frame_hash, (unsigned long long)hashes[i].audio_hash, status);
+    }
+
+    long long total_frames = static_cast<long long>(frames) * cores;
+
+    printf("threads: %d\n", threads);
+    printf("cores: %d\n", cores);
+    printf("frames: %d\n", frames);
+    printf("elapsed_ms: %.3f\n", seconds * 1000.0);
+    printf("total_fps: %.2f\n", (seconds > 0.0) ? (total_frames / seconds) : 0.0);
+
+    return (mismatches > 0) ? 1 : 0;
+}
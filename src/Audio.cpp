@@ -36,6 +36,8 @@ Audio::Audio(Cartridge * pCartridge)
     m_bPSGEnabled = true;
     m_bYM2413ForceDisabled = false;
     m_bMute = false;
+    m_bFrozen = false;
+    m_bSynthesis = true;
 }
 
 Audio::~Audio()
@@ -50,6 +52,8 @@ Audio::~Audio()
 void Audio::Init()
 {
     m_pSampleBuffer = new blip_sample_t[GS_AUDIO_BUFFER_SIZE];
+    for (int i = 0; i < GS_AUDIO_BUFFER_SIZE; i++)
+        m_pSampleBuffer[i] = 0;
 
     m_pApu = new Sms_Apu();
     m_pBuffer = new Stereo_Buffer();
@@ -61,6 +65,8 @@ void Audio::Init()
     //m_pApu->treble_eq(-15.0);
 
     m_pYM2413Buffer = new s16[GS_AUDIO_BUFFER_SIZE];
+    for (int i = 0; i < GS_AUDIO_BUFFER_SIZE; i++)
+        m_pYM2413Buffer[i] = 0;
 
     m_pYM2413 = new YM2413();
     m_pYM2413->Init(m_bPAL ? GS_MASTER_CLOCK_PAL : GS_MASTER_CLOCK_NTSC);
@@ -85,8 +91,57 @@ void Audio::Mute(bool bMute)
     m_bMute = bMute;
 }
 
+// The PSG is not part of save states, so frames that are going to be rolled
+// back must leave it alone. While frozen, PSG writes are dropped, frames
+// produce no samples and loading a state keeps the PSG as it is.
+void Audio::Freeze(bool bFreeze)
+{
+    m_bFrozen = bFreeze;
+}
+
+// Frames without synthesis keep every register write, so the sound picks up
+// where the guest left it, but the PSG oscillators are not clocked into the
+// buffers and no samples are mixed.
+void Audio::EnableSynthesis(bool bEnabled)
+{
+    if (m_bSynthesis == bEnabled)
+        return;
+
+    m_bSynthesis = bEnabled;
+
+    if (m_bSynthesis)
+        m_pApu->output(m_pBuffer->center(), m_pBuffer->left(), m_pBuffer->right());
+    else
+        m_pApu->output(NULL, NULL, NULL);
+
+    m_pYM2413->EnableSynthesis(m_bSynthesis);
+}
+
 void Audio::EndFrame(s16* pSampleBuffer, int* pSampleCount)
 {
+    if (m_bFrozen)
+    {
+        m_pYM2413->EndFrame(m_pYM2413Buffer);
+
+        if (IsValidPointer(pSampleCount))
+            *pSampleCount = 0;
+
+        m_ElapsedCycles = 0;
+        return;
+    }
+
+    if (!m_bSynthesis)
+    {
+        m_pApu->end_frame(m_ElapsedCycles);
+        m_pYM2413->EndFrame(m_pYM2413Buffer);
+
+        if (IsValidPointer(pSampleCount))
+            *pSampleCount = 0;
+
+        m_ElapsedCycles = 0;
+        return;
+    }
+
     m_pApu->end_frame(m_ElapsedCycles);
     m_pBuffer->end_frame(m_ElapsedCycles);
 
@@ -121,28 +176,32 @@ void Audio::DisableYM2413(bool bDisable)
     m_pYM2413->Enable(bDisable ? false : m_bYM2413Enabled);
 }
 
-void Audio::SaveState(std::ostream& stream)
+bool Audio::IsYM2413Disabled()
+{
+    return m_bYM2413ForceDisabled;
+}
+
+void Audio::SaveState(StateWriter& state)
 {
-    using namespace std;
-
-    stream.write(reinterpret_cast<const char*> (&m_ElapsedCycles), sizeof(m_ElapsedCycles));
-    stream.write(reinterpret_cast<const char*> (m_pSampleBuffer), sizeof(blip_sample_t) * GS_AUDIO_BUFFER_SIZE);
-    stream.write(reinterpret_cast<const char*> (&m_bYM2413Enabled), sizeof(m_bYM2413Enabled));
-    stream.write(reinterpret_cast<const char*> (&m_bPSGEnabled), sizeof(m_bPSGEnabled));
-    stream.write(reinterpret_cast<const char*> (m_pYM2413Buffer), sizeof(s16) * GS_AUDIO_BUFFER_SIZE);
-    m_pYM2413->SaveState(stream);
+    state.Write(&m_ElapsedCycles, sizeof(m_ElapsedCycles));
+    state.Write(m_pSampleBuffer, sizeof(blip_sample_t) * GS_AUDIO_BUFFER_SIZE);
+    state.Write(&m_bYM2413Enabled, sizeof(m_bYM2413Enabled));
+    state.Write(&m_bPSGEnabled, sizeof(m_bPSGEnabled));
+    state.Write(m_pYM2413Buffer, sizeof(s16) * GS_AUDIO_BUFFER_SIZE);
+    m_pYM2413->SaveState(state);
 }
 
-void Audio::LoadState(std::istream& stream)
+void Audio::LoadState(StateReader& state)
 {
-    using namespace std;
-
-    stream.read(reinterpret_cast<char*> (&m_ElapsedCycles), sizeof(m_ElapsedCycles));
-    stream.read(reinterpret_cast<char*> (m_pSampleBuffer), sizeof(blip_sample_t) * GS_AUDIO_BUFFER_SIZE);
-    stream.read(reinterpret_cast<char*> (&m_bYM2413Enabled), sizeof(m_bYM2413Enabled));
-    stream.read(reinterpret_cast<char*> (&m_bPSGEnabled), sizeof(m_bPSGEnabled));
-    stream.read(reinterpret_cast<char*> (m_pYM2413Buffer), sizeof(s16) * GS_AUDIO_BUFFER_SIZE);
-    m_pYM2413->LoadState(stream);
+    state.Read(&m_ElapsedCycles, sizeof(m_ElapsedCycles));
+    state.Read(m_pSampleBuffer, sizeof(blip_sample_t) * GS_AUDIO_BUFFER_SIZE);
+    state.Read(&m_bYM2413Enabled, sizeof(m_bYM2413Enabled));
+    state.Read(&m_bPSGEnabled, sizeof(m_bPSGEnabled));
+    state.Read(m_pYM2413Buffer, sizeof(s16) * GS_AUDIO_BUFFER_SIZE);
+    m_pYM2413->LoadState(state);
+
+    if (m_bFrozen)
+        return;
 
     m_pApu->reset(m_pCartridge->IsSG1000());
     m_pApu->volume(1.0);
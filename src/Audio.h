@@ -35,6 +35,8 @@ public:
     void Init();
     void Reset(bool bPAL);
     void Mute(bool bMute);
+    void Freeze(bool bFreeze);
+    void EnableSynthesis(bool bEnabled);
     void WriteAudioRegister(u8 value);
     void WriteGGStereoRegister(u8 value);
     void YM2413Write(u8 port, u8 value);
@@ -42,8 +44,9 @@ public:
     void Tick(unsigned int clockCycles);
     void EndFrame(s16* pSampleBuffer, int* pSampleCount);
     void DisableYM2413(bool bDisable);
-    void SaveState(std::ostream& stream);
-    void LoadState(std::istream& stream);
+    bool IsYM2413Disabled();
+    void SaveState(StateWriter& state);
+    void LoadState(StateReader& state);
 
 private:
     YM2413* m_pYM2413;
@@ -59,6 +62,8 @@ private:
     Cartridge* m_pCartridge;
     s16* m_pYM2413Buffer;
     bool m_bMute;
+    bool m_bFrozen;
+    bool m_bSynthesis;
 };
 
 #include "Cartridge.h"
@@ -71,11 +76,17 @@ inline void Audio::Tick(unsigned int clockCycles)
 
 inline void Audio::WriteAudioRegister(u8 value)
 {
+    if (m_bFrozen)
+        return;
+
     m_pApu->write_data(m_ElapsedCycles, value);
 }
 
 inline void Audio::WriteGGStereoRegister(u8 value)
 {
+    if (m_bFrozen)
+        return;
+
     m_pApu->write_ggstereo(m_ElapsedCycles, value);
 }
 
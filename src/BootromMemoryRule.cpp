@@ -100,18 +100,21 @@ void BootromMemoryRule::PerformWrite(u16 address, u8 value)
             {
                 m_iMapperSlot[0] = value & m_iBankMax;
                 m_iMapperSlotAddress[0] = m_iMapperSlot[0] * 0x4000;
+                m_pMemory->UpdatePageTable();
                 break;
             }
             case 0xFFFE:
             {
                 m_iMapperSlot[1] = value & m_iBankMax;
                 m_iMapperSlotAddress[1] = m_iMapperSlot[1] * 0x4000;
+                m_pMemory->UpdatePageTable();
                 break;
             }
             case 0xFFFF:
             {
                 m_iMapperSlot[2] = value & m_iBankMax;
                 m_iMapperSlotAddress[2] = m_iMapperSlot[2] * 0x4000;
+                m_pMemory->UpdatePageTable();
                 break;
             }
         }
@@ -129,6 +132,22 @@ void BootromMemoryRule::Reset()
         m_iMapperSlot[i] = i;
         m_iMapperSlotAddress[i] = i * 0x4000;
     }
+    m_pMemory->UpdatePageTable();
+}
+
+void BootromMemoryRule::MapPages()
+{
+    if (!IsValidPointer(m_pBootrom) || !IsValidPointer(m_pBootromBanks))
+        return;
+
+    // First 1KB (fixed)
+    m_pMemory->MapReadPages(0x0000, 0x0400, m_pBootrom);
+    // ROM page 0, 1 and 2
+    m_pMemory->MapReadPages(0x0400, 0x3C00, m_pBootromBanks + m_iMapperSlotAddress[0] + 0x0400);
+    m_pMemory->MapReadPages(0x4000, 0x4000, m_pBootromBanks + m_iMapperSlotAddress[1]);
+    m_pMemory->MapReadPages(0x8000, 0x4000, m_pBootromBanks + m_iMapperSlotAddress[2]);
+    // RAM + RAM mirror
+    m_pMemory->MapReadPages(0xC000, 0x4000, m_pMemory->GetMemoryMap() + 0xC000);
 }
 
 u8* BootromMemoryRule::GetPage(int index)
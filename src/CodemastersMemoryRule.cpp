@@ -24,6 +24,8 @@
 CodemastersMemoryRule::CodemastersMemoryRule(Memory* pMemory, Cartridge* pCartridge, Input* pInput) : MemoryRule(pMemory, pCartridge, pInput)
 {
     m_pCartRAM = new u8[0x2000];
+    for (int i = 0; i < 0x2000; i++)
+        m_pCartRAM[i] = 0;
     Reset();
 }
 
@@ -77,6 +79,7 @@ void CodemastersMemoryRule::PerformWrite(u16 address, u8 value)
             {
                 m_iMapperSlot[0] = value & (m_pCartridge->GetROMBankCount() - 1);
                 m_iMapperSlotAddress[0] = m_iMapperSlot[0] * 0x4000;
+                m_pMemory->UpdatePageTable();
                 break;
             }
             case 0x4000:
@@ -84,12 +87,14 @@ void CodemastersMemoryRule::PerformWrite(u16 address, u8 value)
                 m_bRAMBankActive = ((value & 0x80) != 0) && m_pCartridge->HasRAMWithoutBattery();
                 m_iMapperSlot[1] = value & (m_pCartridge->GetROMBankCount() - 1);
                 m_iMapperSlotAddress[1] = m_iMapperSlot[1] * 0x4000;
+                m_pMemory->UpdatePageTable();
                 break;
             }
             case 0x8000:
             {
                 m_iMapperSlot[2] = value & (m_pCartridge->GetROMBankCount() - 1);
                 m_iMapperSlotAddress[2] = m_iMapperSlot[2] * 0x4000;
+                m_pMemory->UpdatePageTable();
                 break;
             }
             default:
@@ -132,6 +137,27 @@ void CodemastersMemoryRule::Reset()
     m_iMapperSlot[2] = 0;
     m_iMapperSlotAddress[2] = m_iMapperSlot[2] * 0x4000;
     m_bRAMBankActive = false;
+    m_pMemory->UpdatePageTable();
+}
+
+void CodemastersMemoryRule::MapPages()
+{
+    u8* pROM = m_pCartridge->GetROM();
+
+    if (!IsValidPointer(pROM))
+        return;
+
+    m_pMemory->MapReadPages(0x0000, 0x4000, pROM + m_iMapperSlotAddress[0]);
+    m_pMemory->MapReadPages(0x4000, 0x4000, pROM + m_iMapperSlotAddress[1]);
+    m_pMemory->MapReadPages(0x8000, 0x4000, pROM + m_iMapperSlotAddress[2]);
+
+    if (m_bRAMBankActive)
+    {
+        m_pMemory->MapReadPages(0xA000, 0x2000, m_pCartRAM);
+        m_pMemory->MapWritePages(0xA000, 0x2000, m_pCartRAM);
+    }
+
+    m_pMemory->MapReadPages(0xC000, 0x4000, m_pMemory->GetMemoryMap() + 0xC000);
 }
 
 u8* CodemastersMemoryRule::GetRamBanks()
@@ -160,22 +186,19 @@ int CodemastersMemoryRule::GetBank(int index)
     }
 }
 
-void CodemastersMemoryRule::SaveState(std::ostream& stream)
+void CodemastersMemoryRule::SaveState(StateWriter& state)
 {
-    using namespace std;
-
-    stream.write(reinterpret_cast<const char*> (m_iMapperSlot), sizeof(m_iMapperSlot));
-    stream.write(reinterpret_cast<const char*> (m_iMapperSlotAddress), sizeof(m_iMapperSlotAddress));
-    stream.write(reinterpret_cast<const char*> (m_pCartRAM), 0x2000);
-    stream.write(reinterpret_cast<const char*> (&m_bRAMBankActive), sizeof(m_bRAMBankActive));
+    state.Write(m_iMapperSlot, sizeof(m_iMapperSlot));
+    state.Write(m_iMapperSlotAddress, sizeof(m_iMapperSlotAddress));
+    state.Write(m_pCartRAM, 0x2000);
+    state.Write(&m_bRAMBankActive, sizeof(m_bRAMBankActive));
 }
 
-void CodemastersMemoryRule::LoadState(std::istream& stream)
+void CodemastersMemoryRule::LoadState(StateReader& state)
 {
-    using namespace std;
-
-    stream.read(reinterpret_cast<char*> (m_iMapperSlot), sizeof(m_iMapperSlot));
-    stream.read(reinterpret_cast<char*> (m_iMapperSlotAddress), sizeof(m_iMapperSlotAddress));
-    stream.read(reinterpret_cast<char*> (m_pCartRAM), 0x2000);
-    stream.read(reinterpret_cast<char*> (&m_bRAMBankActive), sizeof(m_bRAMBankActive));
+    state.Read(m_iMapperSlot, sizeof(m_iMapperSlot));
+    state.Read(m_iMapperSlotAddress, sizeof(m_iMapperSlotAddress));
+    state.Read(m_pCartRAM, 0x2000);
+    state.Read(&m_bRAMBankActive, sizeof(m_bRAMBankActive));
+    m_pMemory->UpdatePageTable();
 }
@@ -23,14 +23,16 @@
 #include "Input.h"
 #include "Cartridge.h"
 #include "Memory.h"
+#include "Processor.h"
 
-GameGearIOPorts::GameGearIOPorts(Audio* pAudio, Video* pVideo, Input* pInput, Cartridge* pCartridge, Memory* pMemory)
+GameGearIOPorts::GameGearIOPorts(Audio* pAudio, Video* pVideo, Input* pInput, Cartridge* pCartridge, Memory* pMemory, Processor* pProcessor)
 {
     m_pAudio = pAudio;
     m_pVideo = pVideo;
     m_pInput = pInput;
     m_pCartridge = pCartridge;
     m_pMemory = pMemory;
+    m_pProcessor = pProcessor;
     m_Port3F = 0;
     m_Port3F_HC = 0;
 }
@@ -46,8 +48,24 @@ void GameGearIOPorts::Reset()
     m_Port2 = 0;
 }
 
+void GameGearIOPorts::SyncDevices()
+{
+    // Bring audio and input up to date with the instructions executed
+    // since the last sync. The VDP only catches up when its ports are hit.
+    unsigned int clockCycles = m_pProcessor->ConsumePendingTStates();
+
+    if (clockCycles > 0)
+    {
+        m_pVideo->AddPendingCycles(clockCycles);
+        m_pAudio->Tick(clockCycles);
+        m_pInput->Tick(clockCycles);
+    }
+}
+
 u8 GameGearIOPorts::DoInput(u8 port)
 {
+    SyncDevices();
+
     if (port < 0x07)
     {
         switch (port)
@@ -80,6 +98,7 @@ u8 GameGearIOPorts::DoInput(u8 port)
     {
         // Reads from even addresses return the V counter
         // Reads from odd addresses return the H counter
+        m_pVideo->Sync();
         if ((port & 0x01) == 0x00)
             return m_pVideo->GetVCounter();
         else
@@ -89,6 +108,7 @@ u8 GameGearIOPorts::DoInput(u8 port)
     {
         // Reads from even addresses return the VDP data port contents
         // Reads from odd address return the VDP status flags
+        m_pVideo->Sync();
         if ((port & 0x01) == 0x00)
             return m_pVideo->GetDataPort();
         else
@@ -122,6 +142,8 @@ u8 GameGearIOPorts::DoInput(u8 port)
 
 void GameGearIOPorts::DoOutput(u8 port, u8 value)
 {
+    SyncDevices();
+
     if (port < 0x07)
     {
         if (port == 0x06)
@@ -146,7 +168,10 @@ void GameGearIOPorts::DoOutput(u8 port, u8 value)
         else
         {
             if (((value  & 0x01) && !(m_Port3F_HC & 0x01)) || ((value  & 0x08) && !(m_Port3F_HC & 0x08)))
+            {
+                m_pVideo->Sync();
                 m_pVideo->LatchHCounter();
+            }
             m_Port3F_HC = value & 0x05;
 
             m_Port3F =  ((value & 0x80) | (value & 0x20) << 1) & 0xC0;
@@ -163,6 +188,7 @@ void GameGearIOPorts::DoOutput(u8 port, u8 value)
     {
         // Writes to even addresses go to the VDP data port.
         // Writes to odd addresses go to the VDP control port.
+        m_pVideo->Sync();
         if ((port & 0x01) == 0x00)
             m_pVideo->WriteData(value);
         else
@@ -188,18 +214,14 @@ void GameGearIOPorts::DoOutput(u8 port, u8 value)
 #endif
 }
 
-void GameGearIOPorts::SaveState(std::ostream& stream)
+void GameGearIOPorts::SaveState(StateWriter& state)
 {
-    using namespace std;
-
-    stream.write(reinterpret_cast<const char*> (&m_Port3F), sizeof(m_Port3F));
-    stream.write(reinterpret_cast<const char*> (&m_Port3F_HC), sizeof(m_Port3F_HC));
+    state.Write(&m_Port3F, sizeof(m_Port3F));
+    state.Write(&m_Port3F_HC, sizeof(m_Port3F_HC));
 }
 
-void GameGearIOPorts::LoadState(std::istream& stream)
+void GameGearIOPorts::LoadState(StateReader& state)
 {
-    using namespace std;
-
-    stream.read(reinterpret_cast<char*> (&m_Port3F), sizeof(m_Port3F));
-    stream.read(reinterpret_cast<char*> (&m_Port3F_HC), sizeof(m_Port3F_HC));
+    state.Read(&m_Port3F, sizeof(m_Port3F));
+    state.Read(&m_Port3F_HC, sizeof(m_Port3F_HC));
 }
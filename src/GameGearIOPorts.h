@@ -27,23 +27,27 @@ class Video;
 class Input;
 class Cartridge;
 class Memory;
+class Processor;
 
 class GameGearIOPorts : public IOPorts
 {
 public:
-    GameGearIOPorts(Audio* pAudio, Video* pVideo, Input* pInput, Cartridge* pCartridge, Memory* pMemory);
+    GameGearIOPorts(Audio* pAudio, Video* pVideo, Input* pInput, Cartridge* pCartridge, Memory* pMemory, Processor* pProcessor);
     virtual ~GameGearIOPorts();
     void Reset();
     virtual u8 DoInput(u8 port);
     virtual void DoOutput(u8 port, u8 value);
-    virtual void SaveState(std::ostream& stream);
-    virtual void LoadState(std::istream& stream);
+    virtual void SaveState(StateWriter& state);
+    virtual void LoadState(StateReader& state);
+private:
+    void SyncDevices();
 private:
     Audio* m_pAudio;
     Video* m_pVideo;
     Input* m_pInput;
     Memory* m_pMemory;
     Cartridge* m_pCartridge;
+    Processor* m_pProcessor;
     u8 m_Port3F;
     u8 m_Port3F_HC;
     u8 m_Port2;
@@ -35,6 +35,8 @@
 #include "SmsIOPorts.h"
 #include "GameGearIOPorts.h"
 #include "BootromMemoryRule.h"
+#include "Rewind.h"
+#include "RunAhead.h"
 
 GearsystemCore::GearsystemCore()
 {
@@ -54,13 +56,19 @@ GearsystemCore::GearsystemCore()
     InitPointer(m_pSmsIOPorts);
     InitPointer(m_pGameGearIOPorts);
     InitPointer(m_pBootromMemoryRule);
+    InitPointer(m_pRewind);
+    InitPointer(m_pRunAhead);
     m_bPaused = true;
+    m_bDebugEnabled = false;
     m_pixelFormat = GS_PIXEL_RGB888;
     m_GlassesConfig = GearsystemCore::GlassesBothEyes;
+    m_bSkipCleanLines = false;
 }
 
 GearsystemCore::~GearsystemCore()
 {
+    SafeDelete(m_pRunAhead);
+    SafeDelete(m_pRewind);
     SafeDelete(m_pBootromMemoryRule);
     SafeDelete(m_pGameGearIOPorts);
     SafeDelete(m_pSmsIOPorts);
@@ -92,7 +100,9 @@ void GearsystemCore::Init(GS_Color_Format pixelFormat)
     m_pInput = new Input(m_pProcessor);
     m_pAudio = new Audio(m_pCartridge);
     m_pSmsIOPorts = new SmsIOPorts(m_pAudio, m_pVideo, m_pInput, m_pCartridge, m_pMemory, m_pProcessor);
-    m_pGameGearIOPorts = new GameGearIOPorts(m_pAudio, m_pVideo, m_pInput, m_pCartridge, m_pMemory);
+    m_pGameGearIOPorts = new GameGearIOPorts(m_pAudio, m_pVideo, m_pInput, m_pCartridge, m_pMemory, m_pProcessor);
+    m_pRewind = new Rewind(this);
+    m_pRunAhead = new RunAhead(this);
 
     m_pMemory->Init();
     m_pProcessor->Init();
@@ -100,11 +110,15 @@ void GearsystemCore::Init(GS_Color_Format pixelFormat)
     m_pVideo->Init();
     m_pInput->Init();
     m_pCartridge->Init();
+    m_pRewind->Init();
 
     InitMemoryRules();
 }
 
-bool GearsystemCore::RunToVBlank(u8* pFrameBuffer, s16* pSampleBuffer, int* pSampleCount, bool step, bool stopOnBreakpoints)
+// GS_RUN_SKIP_RENDER runs the frame without rasterizing it: everything the
+// guest can observe is still computed but the frame buffer keeps the previous
+// picture. GS_RUN_SKIP_AUDIO runs it without synthesizing any samples.
+bool GearsystemCore::RunToVBlank(u8* pFrameBuffer, s16* pSampleBuffer, int* pSampleCount, bool step, bool stopOnBreakpoints, int flags)
 {
     bool breakpoint = false;
 
@@ -112,16 +126,37 @@ bool GearsystemCore::RunToVBlank(u8* pFrameBuffer, s16* pSampleBuffer, int* pSam
     {
         bool vblank = false;
         int totalClocks = 0;
+        bool skipRender = (flags & GS_RUN_SKIP_RENDER) != 0;
+
+        m_pVideo->SetSkipRender(skipRender);
+        m_pAudio->EnableSynthesis((flags & GS_RUN_SKIP_AUDIO) == 0);
+
+#ifndef GEARSYSTEM_DISABLE_DISASSEMBLER
+        // Only pay for disassembly and breakpoint checks while the debugger
+        // is open or there is something that could stop the frame
+        bool debug = m_bDebugEnabled || step || (stopOnBreakpoints && m_pMemory->HasBreakpoints());
+        m_pProcessor->EnableDebug(debug);
+        m_pMemory->EnableMemoryBreakpoints(debug);
+#endif
+
         while (!vblank)
         {
-#ifdef PERFORMANCE
-            unsigned int clockCycles = m_pProcessor->RunFor(75);
-#else
-            unsigned int clockCycles = m_pProcessor->RunFor(1);
+            // Run the CPU until the VDP may raise an interrupt or end the
+            // frame. I/O accesses sync the devices they touch on their own.
+            unsigned int budget = m_pVideo->GetCyclesToNextEvent();
+
+#ifndef GEARSYSTEM_DISABLE_DISASSEMBLER
+            if (step)
+                budget = 1;
 #endif
-            vblank = m_pVideo->Tick(clockCycles);
-            m_pAudio->Tick(clockCycles);
-            m_pInput->Tick(clockCycles);
+
+            unsigned int clockCycles = m_pProcessor->RunFor(budget);
+            unsigned int pendingCycles = m_pProcessor->ConsumePendingTStates();
+
+            m_pVideo->AddPendingCycles(pendingCycles);
+            vblank = m_pVideo->Sync();
+            m_pAudio->Tick(pendingCycles);
+            m_pInput->Tick(pendingCycles);
 
             totalClocks += clockCycles;
 
@@ -139,7 +174,9 @@ bool GearsystemCore::RunToVBlank(u8* pFrameBuffer, s16* pSampleBuffer, int* pSam
         }
 
         m_pAudio->EndFrame(pSampleBuffer, pSampleCount);
-        RenderFrameBuffer(pFrameBuffer);
+
+        if (IsValidPointer(pFrameBuffer) && !skipRender)
+            RenderFrameBuffer(pFrameBuffer);
     }
 
     return breakpoint;
@@ -214,9 +251,7 @@ void GearsystemCore::SaveMemoryDump()
 
 void GearsystemCore::SaveDisassembledROM()
 {
-    Memory::stDisassembleRecord** romMap = m_pMemory->GetDisassembledROMMemoryMap();
-
-    if (m_pCartridge->IsReady() && (strlen(m_pCartridge->GetFilePath()) > 0) && IsValidPointer(romMap))
+    if (m_pCartridge->IsReady() && (strlen(m_pCartridge->GetFilePath()) > 0))
     {
         using namespace std;
 
@@ -233,10 +268,12 @@ void GearsystemCore::SaveDisassembledROM()
         {
             for (int i = 0; i < 65536; i++)
             {
-                if (IsValidPointer(romMap[i]) && (romMap[i]->name[0] != 0))
+                Memory::stDisassembleRecord* record = m_pMemory->GetDisassembleRecord(i, true);
+
+                if (IsValidPointer(record) && (record->name[0] != 0))
                 {
-                    myfile << "0x" << hex << i << "\t " << romMap[i]->name << "\n";
-                    i += (romMap[i]->size - 1);
+                    myfile << "0x" << hex << i << "\t " << record->name << "\n";
+                    i += (record->size - 1);
                 }
             }
 
@@ -280,6 +317,23 @@ bool GearsystemCore::GetRuntimeInfo(GS_RuntimeInfo& runtime_info)
     return false;
 }
 
+// The view stays valid until the next call to RunToVBlank. Frontends that
+// only need the native pixels can pass a NULL frame buffer to RunToVBlank
+// and skip the color conversion altogether.
+bool GearsystemCore::GetFrameView(GS_FrameView& view)
+{
+    m_pVideo->GetFrameView(view);
+    return m_pCartridge->IsReady();
+}
+
+// Makes the VDP render into a caller owned buffer of at least
+// GS_RESOLUTION_MAX_WIDTH * GS_RESOLUTION_MAX_HEIGHT pixels, NULL restores
+// the internal one. The buffer can be swapped between frames.
+void GearsystemCore::SetNativeFrameBuffer(u16* pFrameBuffer)
+{
+    m_pVideo->SetFrameBuffer(pFrameBuffer);
+}
+
 Memory* GearsystemCore::GetMemory()
 {
     return m_pMemory;
@@ -305,11 +359,48 @@ Video* GearsystemCore::GetVideo()
     return m_pVideo;
 }
 
+Rewind* GearsystemCore::GetRewind()
+{
+    return m_pRewind;
+}
+
+RunAhead* GearsystemCore::GetRunAhead()
+{
+    return m_pRunAhead;
+}
+
 void GearsystemCore::SetGlassesConfig(GlassesConfig config)
 {
     m_GlassesConfig = config;
 }
 
+GearsystemCore::GlassesConfig GearsystemCore::GetGlassesConfig()
+{
+    return m_GlassesConfig;
+}
+
+// Only lines that changed since the previous frame are converted into the
+// frame buffer passed to RunToVBlank. The caller must pass the same buffer
+// every frame and leave its contents alone between frames.
+void GearsystemCore::EnableCleanLineSkipping(bool enable)
+{
+    if (enable == m_bSkipCleanLines)
+        return;
+
+    m_bSkipCleanLines = enable;
+    m_pVideo->InvalidateRenderTarget();
+}
+
+bool GearsystemCore::IsCleanLineSkippingEnabled()
+{
+    return m_bSkipCleanLines;
+}
+
+GS_Color_Format GearsystemCore::GetPixelFormat()
+{
+    return m_pixelFormat;
+}
+
 void GearsystemCore::KeyPressed(GS_Joypads joypad, GS_Keys key)
 {
     m_pInput->KeyPressed(joypad, key);
@@ -338,6 +429,11 @@ bool GearsystemCore::IsPaused()
     return m_bPaused;
 }
 
+void GearsystemCore::EnableDebug(bool enable)
+{
+    m_bDebugEnabled = enable;
+}
+
 void GearsystemCore::ResetROM(Cartridge::ForceConfiguration* config)
 {
     if (m_pCartridge->IsReady())
@@ -535,9 +631,6 @@ void GearsystemCore::SaveState(const char* szPath, int index)
     using namespace std;
 
     size_t size;
-    SaveState(NULL, size);
-
-    u8* buffer = new u8[size];
     string path = "";
 
     if (IsValidPointer(szPath))
@@ -570,86 +663,67 @@ void GearsystemCore::SaveState(const char* szPath, int index)
 
     SaveState(file, size);
 
-    SafeDeleteArray(buffer);
-
     file.close();
 
     Log("Save state created");
 }
 
-bool GearsystemCore::SaveState(u8* buffer, size_t& size)
+size_t GearsystemCore::GetStateSize()
 {
-    if (m_pMemory->GetCurrentSlot() == Memory::BiosSlot)
-    {
-        Log("Save states disabled when running BIOS");
-        return false;
-    }
-
-    bool ret = false;
+    if (!CanSaveState())
+        return 0;
 
-    if (m_pCartridge->IsReady() && IsValidPointer(m_pMemory->GetCurrentRule()))
-    {
-        using namespace std;
+    StateWriter state(NULL, 0);
+    SaveState(state);
 
-        stringstream stream;
+    return state.GetSize();
+}
 
-        if (SaveState(stream, size))
-            ret = true;
+// With a NULL buffer only the size is returned. Otherwise size is the
+// capacity of the buffer on input and the size of the state on output.
+bool GearsystemCore::SaveState(u8* buffer, size_t& size)
+{
+    if (!CanSaveState())
+        return false;
 
-        if (IsValidPointer(buffer))
-        {
-            Log("Saving state to buffer [%d bytes]...", size);
-            memcpy(buffer, stream.str().c_str(), size);
-            ret = true;
-        }
-    }
-    else
+    if (!IsValidPointer(buffer))
     {
-        Log("Invalid rom or memory rule.");
+        size = GetStateSize();
+        return true;
     }
 
-    return ret;
-}
+    StateWriter state(buffer, size);
+    SaveState(state);
 
-bool GearsystemCore::SaveState(std::ostream& stream, size_t& size)
-{
-    if (m_pMemory->GetCurrentSlot() == Memory::BiosSlot)
+    if (!state.IsValid())
     {
-        Log("Save states disabled when running BIOS");
+        Log("Save state buffer too small [%d bytes], %d bytes needed", size, state.GetSize());
         return false;
     }
 
-    if (m_pCartridge->IsReady() && IsValidPointer(m_pMemory->GetCurrentRule()))
-    {
-        Log("Gathering save state data...");
+    size = state.GetSize();
 
-        using namespace std;
-
-        m_pMemory->SaveState(stream);
-        m_pProcessor->SaveState(stream);
-        m_pAudio->SaveState(stream);
-        m_pVideo->SaveState(stream);
-        m_pInput->SaveState(stream);
-        m_pMemory->GetCurrentRule()->SaveState(stream);
-        m_pProcessor->GetIOPOrts()->SaveState(stream);
+    Log("Save state size: %d", size);
 
-        size = static_cast<size_t>(stream.tellp());
-        size += (sizeof(u32) * 2);
+    return true;
+}
 
-        u32 header_magic = GS_SAVESTATE_MAGIC;
-        u32 header_size = static_cast<u32>(size);
+bool GearsystemCore::SaveState(std::ostream& stream, size_t& size)
+{
+    size = GetStateSize();
 
-        stream.write(reinterpret_cast<const char*> (&header_magic), sizeof(header_magic));
-        stream.write(reinterpret_cast<const char*> (&header_size), sizeof(header_size));
+    if (size == 0)
+        return false;
 
-        Log("Save state size: %d", static_cast<size_t>(stream.tellp()));
+    u8* buffer = new u8[size];
+    bool ret = SaveState(buffer, size);
 
-        return true;
-    }
+    if (ret)
+        stream.write(reinterpret_cast<const char*> (buffer), size);
 
-    Log("Invalid rom or memory rule.");
+    SafeDeleteArray(buffer);
 
-    return false;
+    return ret;
 }
 
 void GearsystemCore::LoadState(int index)
@@ -730,84 +804,114 @@ void GearsystemCore::LoadState(const char* szPath, int index)
 
 bool GearsystemCore::LoadState(const u8* buffer, size_t size)
 {
-    if (m_pMemory->GetCurrentSlot() == Memory::BiosSlot)
+    if (!CanSaveState())
+        return false;
+
+    if ((size <= (sizeof(u32) * 2)) || !IsValidPointer(buffer))
     {
-        Log("Save states disabled when running BIOS");
+        Log("Invalid save state buffer");
         return false;
     }
 
-    if (m_pCartridge->IsReady() && IsValidPointer(m_pMemory->GetCurrentRule()) && (size > 0) && IsValidPointer(buffer))
-    {
-        Log("Gathering load state data [%d bytes]...", size);
+    u32 header_magic = 0;
+    u32 header_size = 0;
 
-        using namespace std;
+    memcpy(&header_magic, buffer + size - (2 * sizeof(u32)), sizeof(header_magic));
+    memcpy(&header_size, buffer + size - sizeof(u32), sizeof(header_size));
 
-        stringstream stream;
+    Log("Load state magic: 0x%08x", header_magic);
+    Log("Load state size: %d", header_size);
 
-        stream.write(reinterpret_cast<const char*> (buffer), size);
+    if ((header_size != size) || (header_magic != GS_SAVESTATE_MAGIC))
+    {
+        Log("Invalid save state size or header");
+        return false;
+    }
 
-        return LoadState(stream);
+    // Reject states made for a different memory rule before touching
+    // anything, so a bad state never gets partially loaded
+    if (size != GetStateSize())
+    {
+        Log("Save state size doesn't match the running game");
+        return false;
     }
 
-    Log("Invalid rom or memory rule.");
+    Log("Loading state...");
 
-    return false;
+    StateReader state(buffer, size);
+    LoadState(state);
+
+    return state.IsValid();
 }
 
 bool GearsystemCore::LoadState(std::istream& stream)
 {
-    if (m_pMemory->GetCurrentSlot() == Memory::BiosSlot)
-    {
-        Log("Save states disabled when running BIOS");
-        return false;
-    }
-
-    if (m_pCartridge->IsReady() && IsValidPointer(m_pMemory->GetCurrentRule()))
-    {
-        using namespace std;
+    using namespace std;
 
-        u32 header_magic = 0;
-        u32 header_size = 0;
+    stream.seekg(0, ios::end);
+    size_t size = static_cast<size_t>(stream.tellg());
+    stream.seekg(0, ios::beg);
 
-        stream.seekg(0, ios::end);
-        size_t size = static_cast<size_t>(stream.tellg());
-        stream.seekg(0, ios::beg);
+    Log("Load state stream size: %d", size);
 
-        Log("Load state stream size: %d", size);
+    if (size == 0)
+        return false;
 
-        stream.seekg(size - (2 * sizeof(u32)), ios::beg);
-        stream.read(reinterpret_cast<char*> (&header_magic), sizeof(header_magic));
-        stream.read(reinterpret_cast<char*> (&header_size), sizeof(header_size));
-        stream.seekg(0, ios::beg);
+    u8* buffer = new u8[size];
+    stream.read(reinterpret_cast<char*> (buffer), size);
 
-        Log("Load state magic: 0x%08x", header_magic);
-        Log("Load state size: %d", header_size);
+    bool ret = !stream.fail() && LoadState(buffer, size);
 
-        if ((header_size == size) && (header_magic == GS_SAVESTATE_MAGIC))
-        {
-            Log("Loading state...");
+    SafeDeleteArray(buffer);
 
-            m_pMemory->LoadState(stream);
-            m_pProcessor->LoadState(stream);
-            m_pAudio->LoadState(stream);
-            m_pVideo->LoadState(stream);
-            m_pInput->LoadState(stream);
-            m_pMemory->GetCurrentRule()->LoadState(stream);
-            m_pProcessor->GetIOPOrts()->LoadState(stream);
+    return ret;
+}
 
-            return true;
-        }
-        else
-        {
-            Log("Invalid save state size or header");
-        }
+bool GearsystemCore::CanSaveState()
+{
+    if (m_pMemory->GetCurrentSlot() == Memory::BiosSlot)
+    {
+        Log("Save states disabled when running BIOS");
+        return false;
     }
-    else
+
+    if (!m_pCartridge->IsReady() || !IsValidPointer(m_pMemory->GetCurrentRule()))
     {
         Log("Invalid rom or memory rule");
+        return false;
     }
 
-    return false;
+    return true;
+}
+
+// The layout matches the original stream based format, so older state
+// files still load. The magic and total size go last.
+void GearsystemCore::SaveState(StateWriter& state)
+{
+    m_pMemory->SaveState(state);
+    m_pProcessor->SaveState(state);
+    m_pAudio->SaveState(state);
+    m_pVideo->SaveState(state);
+    m_pInput->SaveState(state);
+    m_pMemory->GetCurrentRule()->SaveState(state);
+    m_pProcessor->GetIOPOrts()->SaveState(state);
+
+    u32 header_magic = GS_SAVESTATE_MAGIC;
+    u32 header_size = static_cast<u32>(state.GetSize() + (sizeof(u32) * 2));
+
+    state.Write(&header_magic, sizeof(header_magic));
+    state.Write(&header_size, sizeof(header_size));
+}
+
+void GearsystemCore::LoadState(StateReader& state)
+{
+    m_pMemory->LoadState(state);
+    m_pProcessor->LoadState(state);
+    m_pAudio->LoadState(state);
+    m_pVideo->LoadState(state);
+    m_pInput->LoadState(state);
+    m_pMemory->GetCurrentRule()->LoadState(state);
+    m_pProcessor->GetIOPOrts()->LoadState(state);
 }
 
 void GearsystemCore::SetCheat(const char* szCheat)
@@ -823,6 +927,7 @@ void GearsystemCore::SetCheat(const char* szCheat)
     {
         m_pProcessor->SetProActionReplayCheat(szCheat);
     }
+    m_pRunAhead->Reset();
 }
 
 void GearsystemCore::ClearCheats()
@@ -831,6 +936,7 @@ void GearsystemCore::ClearCheats()
     m_pProcessor->ClearProActionReplayCheats();
     if (m_pCartridge->IsReady())
         m_pMemory->LoadSlotsFromROM(m_pCartridge->GetROM(), m_pCartridge->GetROMSize());
+    m_pRunAhead->Reset();
 }
 
 void GearsystemCore::SetRamModificationCallback(RamChangedCallback callback)
@@ -921,6 +1027,8 @@ void GearsystemCore::Reset()
     m_pBootromMemoryRule->Reset();
     m_pGameGearIOPorts->Reset();
     m_pSmsIOPorts->Reset();
+    m_pRewind->Reset();
+    m_pRunAhead->Reset();
     m_bPaused = false;
 }
 
@@ -936,7 +1044,10 @@ void GearsystemCore::RenderFrameBuffer(u8* finalFrameBuffer)
             return;
     }
 
-    int size = GS_RESOLUTION_MAX_WIDTH_WITH_OVERSCAN * GS_RESOLUTION_MAX_HEIGHT_WITH_OVERSCAN;
+    GS_RuntimeInfo runtime_info;
+    GetRuntimeInfo(runtime_info);
+
+    int size = runtime_info.screen_width * runtime_info.screen_height;
 
     switch (m_pixelFormat)
     {
@@ -945,13 +1056,13 @@ void GearsystemCore::RenderFrameBuffer(u8* finalFrameBuffer)
         case GS_PIXEL_RGB565:
         case GS_PIXEL_BGR565:
         {
-            m_pVideo->Render16bit(m_pVideo->GetFrameBuffer(), finalFrameBuffer, m_pixelFormat, size, true);
+            m_pVideo->Render16bit(m_pVideo->GetFrameBuffer(), finalFrameBuffer, m_pixelFormat, size, true, m_bSkipCleanLines);
             break;
         }
         case GS_PIXEL_RGB888:
         case GS_PIXEL_BGR888:
         {
-            m_pVideo->Render24bit(m_pVideo->GetFrameBuffer(), finalFrameBuffer, m_pixelFormat, size, true);
+            m_pVideo->Render24bit(m_pVideo->GetFrameBuffer(), finalFrameBuffer, m_pixelFormat, size, true, m_bSkipCleanLines);
             break;
         }
     }
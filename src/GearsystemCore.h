@@ -39,6 +39,10 @@ class MemoryRule;
 class SmsIOPorts;
 class GameGearIOPorts;
 class BootromMemoryRule;
+class Rewind;
+class RunAhead;
+class StateWriter;
+class StateReader;
 
 class GearsystemCore
 {
@@ -54,16 +58,19 @@ public:
     GearsystemCore();
     ~GearsystemCore();
     void Init(GS_Color_Format pixelFormat = GS_PIXEL_RGB888);
-    bool RunToVBlank(u8* pFrameBuffer, s16* pSampleBuffer, int* pSampleCount, bool step = false, bool stopOnBreakpoints = false);
+    bool RunToVBlank(u8* pFrameBuffer, s16* pSampleBuffer, int* pSampleCount, bool step = false, bool stopOnBreakpoints = false, int flags = GS_RUN_DEFAULT);
     bool LoadROM(const char* szFilePath, Cartridge::ForceConfiguration* config = NULL);
     bool LoadROMFromBuffer(const u8* buffer, int size, Cartridge::ForceConfiguration* config = NULL, const char* szFilePath = NULL);
     void SaveMemoryDump();
     void SaveDisassembledROM();
     bool GetRuntimeInfo(GS_RuntimeInfo& runtime_info);
+    bool GetFrameView(GS_FrameView& view);
+    void SetNativeFrameBuffer(u16* pFrameBuffer);
     void KeyPressed(GS_Joypads joypad, GS_Keys key);
     void KeyReleased(GS_Joypads joypad, GS_Keys key);
     void Pause(bool paused);
     bool IsPaused();
+    void EnableDebug(bool enable);
     void ResetROM(Cartridge::ForceConfiguration* config = NULL);
     void ResetROMPreservingRAM(Cartridge::ForceConfiguration* config = NULL);
     void ResetSound();
@@ -73,6 +80,7 @@ public:
     void LoadRam(const char* szPath, bool fullPath = false);
     void SaveState(int index);
     void SaveState(const char* szPath, int index);
+    size_t GetStateSize();
     bool SaveState(u8* buffer, size_t& size);
     bool SaveState(std::ostream& stream, size_t& size);
     void LoadState(int index);
@@ -87,13 +95,22 @@ public:
     Processor* GetProcessor();
     Audio* GetAudio();
     Video* GetVideo();
+    Rewind* GetRewind();
+    RunAhead* GetRunAhead();
     void SetGlassesConfig(GlassesConfig config);
+    GlassesConfig GetGlassesConfig();
+    void EnableCleanLineSkipping(bool enable);
+    bool IsCleanLineSkippingEnabled();
+    GS_Color_Format GetPixelFormat();
 
 private:
     void InitMemoryRules();
     bool AddMemoryRules();
     void Reset();
     void RenderFrameBuffer(u8* finalFrameBuffer);
+    bool CanSaveState();
+    void SaveState(StateWriter& state);
+    void LoadState(StateReader& state);
 
 private:
     Memory* m_pMemory;
@@ -112,10 +129,14 @@ private:
     SmsIOPorts* m_pSmsIOPorts;
     GameGearIOPorts* m_pGameGearIOPorts;
     BootromMemoryRule* m_pBootromMemoryRule;
+    Rewind* m_pRewind;
+    RunAhead* m_pRunAhead;
     bool m_bPaused;
+    bool m_bDebugEnabled;
     RamChangedCallback m_pRamChangedCallback;
     GS_Color_Format m_pixelFormat;
     GlassesConfig m_GlassesConfig;
+    bool m_bSkipCleanLines;
 };
 
 #endif	/* CORE_H */
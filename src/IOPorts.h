@@ -21,6 +21,7 @@
 #define	IOPORTS_H
 
 #include "definitions.h"
+#include "StateSerializer.h"
 
 class IOPorts
 {
@@ -30,8 +31,8 @@ public:
     virtual void Reset() = 0;
     virtual u8 DoInput(u8 port) = 0;
     virtual void DoOutput(u8 port, u8 value) = 0;
-    virtual void SaveState(std::ostream& stream) = 0;
-    virtual void LoadState(std::istream& stream) = 0;
+    virtual void SaveState(StateWriter& state) = 0;
+    virtual void LoadState(StateReader& state) = 0;
 };
 
 #endif	/* IOPORTS_H */
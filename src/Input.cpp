@@ -54,7 +54,7 @@ void Input::Tick(unsigned int clockCycles)
 {
     m_iInputCycles += clockCycles;
 
-    if (m_iInputCycles >= 10000)
+    while (m_iInputCycles >= 10000)
     {
         m_iInputCycles -= 10000;
         Update();
@@ -113,26 +113,22 @@ void Input::Update()
     m_IOPort00 = (IsSetBit(m_Joypad1, Key_Start) ? 0x80 : 0) & 0x80;
 }
 
-void Input::SaveState(std::ostream& stream)
+void Input::SaveState(StateWriter& state)
 {
-    using namespace std;
-
-    stream.write(reinterpret_cast<const char*> (&m_Joypad1), sizeof(m_Joypad1));
-    stream.write(reinterpret_cast<const char*> (&m_Joypad2), sizeof(m_Joypad2));
-    stream.write(reinterpret_cast<const char*> (&m_IOPortDC), sizeof(m_IOPortDC));
-    stream.write(reinterpret_cast<const char*> (&m_IOPortDD), sizeof(m_IOPortDD));
-    stream.write(reinterpret_cast<const char*> (&m_IOPort00), sizeof(m_IOPort00));
-    stream.write(reinterpret_cast<const char*> (&m_iInputCycles), sizeof(m_iInputCycles));
+    state.Write(&m_Joypad1, sizeof(m_Joypad1));
+    state.Write(&m_Joypad2, sizeof(m_Joypad2));
+    state.Write(&m_IOPortDC, sizeof(m_IOPortDC));
+    state.Write(&m_IOPortDD, sizeof(m_IOPortDD));
+    state.Write(&m_IOPort00, sizeof(m_IOPort00));
+    state.Write(&m_iInputCycles, sizeof(m_iInputCycles));
 }
 
-void Input::LoadState(std::istream& stream)
+void Input::LoadState(StateReader& state)
 {
-    using namespace std;
-
-    stream.read(reinterpret_cast<char*> (&m_Joypad1), sizeof(m_Joypad1));
-    stream.read(reinterpret_cast<char*> (&m_Joypad2), sizeof(m_Joypad2));
-    stream.read(reinterpret_cast<char*> (&m_IOPortDC), sizeof(m_IOPortDC));
-    stream.read(reinterpret_cast<char*> (&m_IOPortDD), sizeof(m_IOPortDD));
-    stream.read(reinterpret_cast<char*> (&m_IOPort00), sizeof(m_IOPort00));
-    stream.read(reinterpret_cast<char*> (&m_iInputCycles), sizeof(m_iInputCycles));
+    state.Read(&m_Joypad1, sizeof(m_Joypad1));
+    state.Read(&m_Joypad2, sizeof(m_Joypad2));
+    state.Read(&m_IOPortDC, sizeof(m_IOPortDC));
+    state.Read(&m_IOPortDD, sizeof(m_IOPortDD));
+    state.Read(&m_IOPort00, sizeof(m_IOPort00));
+    state.Read(&m_iInputCycles, sizeof(m_iInputCycles));
 }
@@ -21,6 +21,7 @@
 #define	INPUT_H
 
 #include "definitions.h"
+#include "StateSerializer.h"
 
 class Memory;
 class Processor;
@@ -39,8 +40,8 @@ public:
     u8 GetPort00();
     u8 GetGlassesRegistry();
     void SetGlassesRegistry(u8 value);
-    void SaveState(std::ostream& stream);
-    void LoadState(std::istream& stream);
+    void SaveState(StateWriter& state);
+    void LoadState(StateReader& state);
 
 private:
     void Update();
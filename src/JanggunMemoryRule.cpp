@@ -89,6 +89,7 @@ void JanggunMemoryRule::PerformWrite(u16 address, u8 value)
             // page 0
             m_iMapperSlot[0] = value & 0x3F;
             m_iMapperSlotAddress[0] = m_iMapperSlot[0] * 0x2000;
+            m_pMemory->UpdatePageTable();
             break;
         }
         case 0x6000:
@@ -96,6 +97,7 @@ void JanggunMemoryRule::PerformWrite(u16 address, u8 value)
             // page 1
             m_iMapperSlot[1] = value & 0x3F;
             m_iMapperSlotAddress[1] = m_iMapperSlot[1] * 0x2000;
+            m_pMemory->UpdatePageTable();
             break;
         }
         case 0x8000:
@@ -103,6 +105,7 @@ void JanggunMemoryRule::PerformWrite(u16 address, u8 value)
             // page 2
             m_iMapperSlot[2] = value & 0x3F;
             m_iMapperSlotAddress[2] = m_iMapperSlot[2] * 0x2000;
+            m_pMemory->UpdatePageTable();
             break;
         }
         case 0xA000:
@@ -110,6 +113,7 @@ void JanggunMemoryRule::PerformWrite(u16 address, u8 value)
             // page 3
             m_iMapperSlot[3] = value & 0x3F;
             m_iMapperSlotAddress[3] = m_iMapperSlot[3] * 0x2000;
+            m_pMemory->UpdatePageTable();
             break;
         }
         default:
@@ -133,6 +137,7 @@ void JanggunMemoryRule::PerformWrite(u16 address, u8 value)
                         m_iMapperSlotAddress[0] = m_iMapperSlot[0] * 0x2000;
                         m_iMapperSlotAddress[1] = m_iMapperSlot[1] * 0x2000;
                         m_bReverseFlags[1] = IsSetBit(value, 6);
+                        m_pMemory->UpdatePageTable();
                         break;
                     }
                     case 0xFFFF:
@@ -142,6 +147,7 @@ void JanggunMemoryRule::PerformWrite(u16 address, u8 value)
                         m_iMapperSlotAddress[2] = m_iMapperSlot[2] * 0x2000;
                         m_iMapperSlotAddress[3] = m_iMapperSlot[3] * 0x2000;
                         m_bReverseFlags[2] = IsSetBit(value, 6);
+                        m_pMemory->UpdatePageTable();
                         break;
                     }
                 }
@@ -158,6 +164,34 @@ void JanggunMemoryRule::Reset()
         m_iMapperSlotAddress[i] = i * 0x4000;
         m_bReverseFlags[i] = false;
     }
+    m_pMemory->UpdatePageTable();
+}
+
+void JanggunMemoryRule::MapPages()
+{
+    u8* pROM = m_pCartridge->GetROM();
+
+    if (!IsValidPointer(pROM))
+        return;
+
+    // Pages with reversed bits go through PerformRead
+    if (!m_bReverseFlags[0])
+        m_pMemory->MapReadPages(0x0000, 0x4000, pROM);
+
+    if (!m_bReverseFlags[1])
+    {
+        m_pMemory->MapReadPages(0x4000, 0x2000, pROM + m_iMapperSlotAddress[0]);
+        m_pMemory->MapReadPages(0x6000, 0x2000, pROM + m_iMapperSlotAddress[1]);
+    }
+
+    if (!m_bReverseFlags[2])
+    {
+        m_pMemory->MapReadPages(0x8000, 0x2000, pROM + m_iMapperSlotAddress[2]);
+        m_pMemory->MapReadPages(0xA000, 0x2000, pROM + m_iMapperSlotAddress[3]);
+    }
+
+    if (!m_bReverseFlags[3])
+        m_pMemory->MapReadPages(0xC000, 0x4000, m_pMemory->GetMemoryMap() + 0xC000);
 }
 
 u8* JanggunMemoryRule::GetPage(int index)
@@ -188,14 +222,15 @@ int JanggunMemoryRule::GetBank(int index)
     }
 }
 
-void JanggunMemoryRule::SaveState(std::ostream& stream)
+void JanggunMemoryRule::SaveState(StateWriter& state)
 {
-    stream.write(reinterpret_cast<const char*> (m_iMapperSlot), sizeof(m_iMapperSlot));
-    stream.write(reinterpret_cast<const char*> (m_iMapperSlotAddress), sizeof(m_iMapperSlotAddress));
+    state.Write(m_iMapperSlot, sizeof(m_iMapperSlot));
+    state.Write(m_iMapperSlotAddress, sizeof(m_iMapperSlotAddress));
 }
 
-void JanggunMemoryRule::LoadState(std::istream& stream)
+void JanggunMemoryRule::LoadState(StateReader& state)
 {
-    stream.read(reinterpret_cast<char*> (m_iMapperSlot), sizeof(m_iMapperSlot));
-    stream.read(reinterpret_cast<char*> (m_iMapperSlotAddress), sizeof(m_iMapperSlotAddress));
+    state.Read(m_iMapperSlot, sizeof(m_iMapperSlot));
+    state.Read(m_iMapperSlotAddress, sizeof(m_iMapperSlotAddress));
+    m_pMemory->UpdatePageTable();
 }
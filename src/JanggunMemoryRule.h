@@ -30,10 +30,11 @@ public:
     virtual u8 PerformRead(u16 address);
     virtual void PerformWrite(u16 address, u8 value);
     virtual void Reset();
+    virtual void MapPages();
     virtual u8* GetPage(int index);
     virtual int GetBank(int index);
-    virtual void SaveState(std::ostream& stream);
-    virtual void LoadState(std::istream& stream);
+    virtual void SaveState(StateWriter& state);
+    virtual void LoadState(StateReader& state);
 
 private:
     int m_iMapperSlot[4];
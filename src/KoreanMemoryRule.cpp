@@ -61,6 +61,7 @@ void KoreanMemoryRule::PerformWrite(u16 address, u8 value)
         {
             m_iMapperSlot2 = value % m_pCartridge->GetROMBankCount();
             m_iMapperSlot2Address = m_iMapperSlot2 * 0x4000;
+            m_pMemory->UpdatePageTable();
         }
         else
         {
@@ -86,6 +87,19 @@ void KoreanMemoryRule::Reset()
 {
     m_iMapperSlot2 = 2;
     m_iMapperSlot2Address = m_iMapperSlot2 * 0x4000;
+    m_pMemory->UpdatePageTable();
+}
+
+void KoreanMemoryRule::MapPages()
+{
+    u8* pROM = m_pCartridge->GetROM();
+
+    if (!IsValidPointer(pROM))
+        return;
+
+    m_pMemory->MapReadPages(0x0000, 0x8000, pROM);
+    m_pMemory->MapReadPages(0x8000, 0x4000, pROM + m_iMapperSlot2Address);
+    m_pMemory->MapReadPages(0xC000, 0x4000, m_pMemory->GetMemoryMap() + 0xC000);
 }
 
 u8* KoreanMemoryRule::GetPage(int index)
@@ -116,16 +130,15 @@ int KoreanMemoryRule::GetBank(int index)
     }
 }
 
-void KoreanMemoryRule::SaveState(std::ostream& stream)
+void KoreanMemoryRule::SaveState(StateWriter& state)
 {
-    stream.write(reinterpret_cast<const char*> (&m_iMapperSlot2), sizeof(m_iMapperSlot2));
-    stream.write(reinterpret_cast<const char*> (&m_iMapperSlot2Address), sizeof(m_iMapperSlot2Address));
+    state.Write(&m_iMapperSlot2, sizeof(m_iMapperSlot2));
+    state.Write(&m_iMapperSlot2Address, sizeof(m_iMapperSlot2Address));
 }
 
-void KoreanMemoryRule::LoadState(std::istream& stream)
+void KoreanMemoryRule::LoadState(StateReader& state)
 {
-    using namespace std;
-
-    stream.read(reinterpret_cast<char*> (&m_iMapperSlot2), sizeof(m_iMapperSlot2));
-    stream.read(reinterpret_cast<char*> (&m_iMapperSlot2Address), sizeof(m_iMapperSlot2Address));
+    state.Read(&m_iMapperSlot2, sizeof(m_iMapperSlot2));
+    state.Read(&m_iMapperSlot2Address, sizeof(m_iMapperSlot2Address));
+    m_pMemory->UpdatePageTable();
 }
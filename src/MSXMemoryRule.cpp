@@ -78,6 +78,7 @@ void MSXMemoryRule::PerformWrite(u16 address, u8 value)
     {
         m_iMapperSlot[address] = value;
         m_iMapperSlotAddress[address] = m_iMapperSlot[address] * 0x2000;
+        m_pMemory->UpdatePageTable();
     }
     else if (address < 0xC000)
     {
@@ -104,6 +105,32 @@ void MSXMemoryRule::Reset()
         m_iMapperSlot[i] = 0;
         m_iMapperSlotAddress[i] = m_iMapperSlot[i] * 0x2000;
     }
+    m_pMemory->UpdatePageTable();
+}
+
+void MSXMemoryRule::MapPages()
+{
+    u8* pROM = m_pCartridge->GetROM();
+
+    if (!IsValidPointer(pROM))
+        return;
+
+    // nemesis
+    if (m_pCartridge->GetCRC() == 0xE316C06D)
+    {
+        m_pMemory->MapReadPages(0x0000, 0x2000, pROM + m_pCartridge->GetROMSize() - 0x2000);
+        m_pMemory->MapReadPages(0x2000, 0x2000, pROM + 0x2000);
+    }
+    else
+    {
+        m_pMemory->MapReadPages(0x0000, 0x4000, pROM);
+    }
+
+    m_pMemory->MapReadPages(0x4000, 0x2000, pROM + m_iMapperSlotAddress[2]);
+    m_pMemory->MapReadPages(0x6000, 0x2000, pROM + m_iMapperSlotAddress[3]);
+    m_pMemory->MapReadPages(0x8000, 0x2000, pROM + m_iMapperSlotAddress[0]);
+    m_pMemory->MapReadPages(0xA000, 0x2000, pROM + m_iMapperSlotAddress[1]);
+    m_pMemory->MapReadPages(0xC000, 0x4000, m_pMemory->GetMemoryMap() + 0xC000);
 }
 
 u8* MSXMemoryRule::GetPage(int index)
@@ -133,16 +160,15 @@ int MSXMemoryRule::GetBank(int index)
     }
 }
 
-void MSXMemoryRule::SaveState(std::ostream& stream)
+void MSXMemoryRule::SaveState(StateWriter& state)
 {
-    stream.write(reinterpret_cast<const char*> (m_iMapperSlot), sizeof(m_iMapperSlot));
-    stream.write(reinterpret_cast<const char*> (m_iMapperSlotAddress), sizeof(m_iMapperSlotAddress));
+    state.Write(m_iMapperSlot, sizeof(m_iMapperSlot));
+    state.Write(m_iMapperSlotAddress, sizeof(m_iMapperSlotAddress));
 }
 
-void MSXMemoryRule::LoadState(std::istream& stream)
+void MSXMemoryRule::LoadState(StateReader& state)
 {
-    using namespace std;
-
-    stream.read(reinterpret_cast<char*> (m_iMapperSlot), sizeof(m_iMapperSlot));
-    stream.read(reinterpret_cast<char*> (m_iMapperSlotAddress), sizeof(m_iMapperSlotAddress));
+    state.Read(m_iMapperSlot, sizeof(m_iMapperSlot));
+    state.Read(m_iMapperSlotAddress, sizeof(m_iMapperSlotAddress));
+    m_pMemory->UpdatePageTable();
 }
@@ -28,9 +28,10 @@ Memory::Memory()
     InitPointer(m_pProcessor);
     InitPointer(m_pMap);
     InitPointer(m_pCurrentMemoryRule);
-    InitPointer(m_pDisassembledMap);
-    InitPointer(m_pDisassembledROMMap);
+    InitPointer(m_pBootromMemoryRule);
+    m_iDisassemblePoolUsed = DISASSEMBLE_POOL_BLOCK_SIZE;
     InitPointer(m_pRunToBreakpoint);
+    m_bMemoryBreakpointsEnabled = false;
     InitPointer(m_pBootromSMS);
     InitPointer(m_pBootromGG);
     m_bBootromSMSEnabled = false;
@@ -44,6 +45,22 @@ Memory::Memory()
     m_iBootromBankCountSMS = 1;
     m_iBootromBankCountGG = 1;
     m_bIOEnabled = true;
+
+    for (int i = 0; i < MEMORY_PAGE_COUNT; i++)
+    {
+        InitPointer(m_pReadPages[i]);
+        InitPointer(m_pWritePages[i]);
+    }
+
+    for (int i = 0; i < DISASSEMBLE_RAM_PAGE_COUNT; i++)
+    {
+        InitPointer(m_pDisassembledMap[i]);
+    }
+
+    for (int i = 0; i < DISASSEMBLE_ROM_PAGE_COUNT; i++)
+    {
+        InitPointer(m_pDisassembledROMMap[i]);
+    }
 }
 
 Memory::~Memory()
@@ -53,22 +70,12 @@ Memory::~Memory()
     SafeDeleteArray(m_pBootromSMS);
     SafeDeleteArray(m_pBootromGG);
 
-    if (IsValidPointer(m_pDisassembledROMMap))
-    {
-        for (int i = 0; i < MAX_ROM_SIZE; i++)
-        {
-            SafeDelete(m_pDisassembledROMMap[i]);
-        }
-        SafeDeleteArray(m_pDisassembledROMMap);
-    }
+    FreeDisassemblePages(m_pDisassembledROMMap, DISASSEMBLE_ROM_PAGE_COUNT);
+    FreeDisassemblePages(m_pDisassembledMap, DISASSEMBLE_RAM_PAGE_COUNT);
 
-    if (IsValidPointer(m_pDisassembledMap))
+    for (unsigned int i = 0; i < m_DisassemblePool.size(); i++)
     {
-        for (int i = 0; i < 0x10000; i++)
-        {
-            SafeDelete(m_pDisassembledMap[i]);
-        }
-        SafeDeleteArray(m_pDisassembledMap);
+        SafeDeleteArray(m_DisassemblePool[i]);
     }
 }
 
@@ -80,19 +87,6 @@ void Memory::SetProcessor(Processor* pProcessor)
 void Memory::Init()
 {
     m_pMap = new u8[0x10000];
-#ifndef GEARSYSTEM_DISABLE_DISASSEMBLER
-    m_pDisassembledMap = new stDisassembleRecord*[0x10000];
-    for (int i = 0; i < 0x10000; i++)
-    {
-        InitPointer(m_pDisassembledMap[i]);
-    }
-
-    m_pDisassembledROMMap = new stDisassembleRecord*[MAX_ROM_SIZE];
-    for (int i = 0; i < MAX_ROM_SIZE; i++)
-    {
-        InitPointer(m_pDisassembledROMMap[i]);
-    }
-#endif
     m_BreakpointsCPU.clear();
     m_BreakpointsMem.clear();
     InitPointer(m_pRunToBreakpoint);
@@ -113,16 +107,41 @@ void Memory::Reset(bool bGameGear)
 
     if (IsBootromEnabled())
         ResetRomDisassembledMemory();
+
+    UpdatePageTable();
 }
 
 void Memory::SetCurrentRule(MemoryRule* pRule)
 {
     m_pCurrentMemoryRule = pRule;
+    UpdatePageTable();
 }
 
 void Memory::SetBootromRule(MemoryRule* pRule)
 {
     m_pBootromMemoryRule = pRule;
+    UpdatePageTable();
+}
+
+void Memory::UpdatePageTable()
+{
+    for (int i = 0; i < MEMORY_PAGE_COUNT; i++)
+    {
+        InitPointer(m_pReadPages[i]);
+        InitPointer(m_pWritePages[i]);
+    }
+
+    // Pages left unmapped fall back to the memory rules
+    if (m_MediaSlot == m_DesiredMediaSlot)
+    {
+        if (IsValidPointer(m_pCurrentMemoryRule))
+            m_pCurrentMemoryRule->MapPages();
+    }
+    else if (m_MediaSlot == BiosSlot)
+    {
+        if (IsValidPointer(m_pBootromMemoryRule))
+            m_pBootromMemoryRule->MapPages();
+    }
 }
 
 MemoryRule* Memory::GetCurrentRule()
@@ -148,9 +167,10 @@ void Memory::LoadSlotsFromROM(u8* pTheROM, int size)
 
 void Memory::MemoryDump(const char* szFilePath)
 {
-    if (!IsValidPointer(m_pDisassembledMap))
-        return;
-
+#ifdef GEARSYSTEM_DISABLE_DISASSEMBLER
+    (void)szFilePath;
+    return;
+#else
     using namespace std;
 
     ofstream myfile(szFilePath, ios::out | ios::trunc);
@@ -159,10 +179,12 @@ void Memory::MemoryDump(const char* szFilePath)
     {
         for (int i = 0; i < 0x10000; i++)
         {
-            if (IsValidPointer(m_pDisassembledMap[i]) && (m_pDisassembledMap[i]->name[0] != 0))
+            stDisassembleRecord* record = GetDisassembleRecord(i, false);
+
+            if (IsValidPointer(record) && (record->name[0] != 0))
             {
-                myfile << "0x" << hex << i << "\t " << m_pDisassembledMap[i]->name << "\n";
-                i += (m_pDisassembledMap[i]->size - 1);
+                myfile << "0x" << hex << i << "\t " << record->name << "\n";
+                i += (record->size - 1);
             }
             else
             {
@@ -172,22 +194,19 @@ void Memory::MemoryDump(const char* szFilePath)
 
         myfile.close();
     }
+#endif
 }
 
-void Memory::SaveState(std::ostream& stream)
+void Memory::SaveState(StateWriter& state)
 {
-    using namespace std;
-
-    stream.write(reinterpret_cast<const char*> (m_pMap), 0x10000);
-    stream.write(reinterpret_cast<const char*> (&m_bIOEnabled), sizeof (m_bIOEnabled));
+    state.Write(m_pMap, 0x10000);
+    state.Write(&m_bIOEnabled, sizeof (m_bIOEnabled));
 }
 
-void Memory::LoadState(std::istream& stream)
+void Memory::LoadState(StateReader& state)
 {
-    using namespace std;
-
-    stream.read(reinterpret_cast<char*> (m_pMap), 0x10000);
-    stream.read(reinterpret_cast<char*> (&m_bIOEnabled), sizeof (m_bIOEnabled));
+    state.Read(m_pMap, 0x10000);
+    state.Read(&m_bIOEnabled, sizeof (m_bIOEnabled));
 }
 
 std::vector<Memory::stDisassembleRecord*>* Memory::GetBreakpointsCPU()
@@ -210,6 +229,16 @@ void Memory::SetRunToBreakpoint(Memory::stDisassembleRecord* pBreakpoint)
     m_pRunToBreakpoint = pBreakpoint;
 }
 
+bool Memory::HasBreakpoints()
+{
+    return !m_BreakpointsCPU.empty() || !m_BreakpointsMem.empty() || IsValidPointer(m_pRunToBreakpoint);
+}
+
+void Memory::EnableMemoryBreakpoints(bool enable)
+{
+    m_bMemoryBreakpointsEnabled = enable && !m_BreakpointsMem.empty();
+}
+
 void Memory::EnableBootromSMS(bool enable)
 {
     m_bBootromSMSEnabled = enable;
@@ -354,6 +383,7 @@ void Memory::SetPort3E(u8 port3E)
     if (oldSlot != m_MediaSlot)
     {
         ResetRomDisassembledMemory();
+        UpdatePageTable();
     }
 }
 
@@ -418,21 +448,21 @@ void Memory::ResetDisassembledMemory()
 {
     #ifndef GEARSYSTEM_DISABLE_DISASSEMBLER
 
-    if (IsValidPointer(m_pDisassembledROMMap))
-    {
-        for (int i = 0; i < MAX_ROM_SIZE; i++)
-        {
-            SafeDelete(m_pDisassembledROMMap[i]);
-        }
-    }
-    if (IsValidPointer(m_pDisassembledMap))
+    m_BreakpointsCPU.clear();
+    InitPointer(m_pRunToBreakpoint);
+
+    FreeDisassemblePages(m_pDisassembledROMMap, DISASSEMBLE_ROM_PAGE_COUNT);
+    FreeDisassemblePages(m_pDisassembledMap, DISASSEMBLE_RAM_PAGE_COUNT);
+
+    for (unsigned int i = 0; i < m_DisassemblePool.size(); i++)
     {
-        for (int i = 0; i < 0x10000; i++)
-        {
-            SafeDelete(m_pDisassembledMap[i]);
-        }
+        SafeDeleteArray(m_DisassemblePool[i]);
     }
 
+    m_DisassemblePool.clear();
+    m_DisassembleFreeList.clear();
+    m_iDisassemblePoolUsed = DISASSEMBLE_POOL_BLOCK_SIZE;
+
     #endif
 }
 
@@ -441,21 +471,90 @@ void Memory::ResetRomDisassembledMemory()
     #ifndef GEARSYSTEM_DISABLE_DISASSEMBLER
 
     m_BreakpointsCPU.clear();
+    InitPointer(m_pRunToBreakpoint);
+
+    FreeDisassemblePages(m_pDisassembledROMMap, DISASSEMBLE_ROM_PAGE_COUNT);
+    FreeDisassemblePages(m_pDisassembledMap, 0xC000 >> DISASSEMBLE_PAGE_SHIFT);
+
+    #endif
+}
+
+Memory::stDisassembleRecord* Memory::GetOrCreateDisassembleRecord(int offset, bool rom)
+{
+    stDisassembleRecord*** pages = rom ? m_pDisassembledROMMap : m_pDisassembledMap;
+    stDisassembleRecord** page = pages[offset >> DISASSEMBLE_PAGE_SHIFT];
 
-    if (IsValidPointer(m_pDisassembledROMMap))
+    if (!IsValidPointer(page))
     {
-        for (int i = 0; i < MAX_ROM_SIZE; i++)
+        page = new stDisassembleRecord*[DISASSEMBLE_PAGE_SIZE];
+        for (int i = 0; i < DISASSEMBLE_PAGE_SIZE; i++)
         {
-            SafeDelete(m_pDisassembledROMMap[i]);
+            InitPointer(page[i]);
         }
+        pages[offset >> DISASSEMBLE_PAGE_SHIFT] = page;
     }
-    if (IsValidPointer(m_pDisassembledMap))
+
+    stDisassembleRecord* record = page[offset & DISASSEMBLE_PAGE_MASK];
+
+    if (IsValidPointer(record))
+        return record;
+
+    record = AllocDisassembleRecord();
+    page[offset & DISASSEMBLE_PAGE_MASK] = record;
+
+    if (rom)
     {
-        for (int i = 0; i < 0xC000; i++)
+        record->address = offset & 0x3FFF;
+        record->bank = offset >> 14;
+    }
+    else
+    {
+        record->address = offset;
+        record->bank = 0;
+    }
+
+    record->name[0] = 0;
+    record->bytes[0] = 0;
+    record->size = 0;
+    for (int i = 0; i < 4; i++)
+        record->opcodes[i] = 0;
+    record->jump = false;
+    record->jump_address = 0;
+
+    return record;
+}
+
+Memory::stDisassembleRecord* Memory::AllocDisassembleRecord()
+{
+    if (!m_DisassembleFreeList.empty())
+    {
+        stDisassembleRecord* record = m_DisassembleFreeList.back();
+        m_DisassembleFreeList.pop_back();
+        return record;
+    }
+
+    if (m_iDisassemblePoolUsed == DISASSEMBLE_POOL_BLOCK_SIZE)
+    {
+        m_DisassemblePool.push_back(new stDisassembleRecord[DISASSEMBLE_POOL_BLOCK_SIZE]);
+        m_iDisassemblePoolUsed = 0;
+    }
+
+    return &m_DisassemblePool.back()[m_iDisassemblePoolUsed++];
+}
+
+void Memory::FreeDisassemblePages(stDisassembleRecord*** pPages, int count)
+{
+    for (int p = 0; p < count; p++)
+    {
+        if (!IsValidPointer(pPages[p]))
+            continue;
+
+        for (int i = 0; i < DISASSEMBLE_PAGE_SIZE; i++)
         {
-            SafeDelete(m_pDisassembledMap[i]);
+            if (IsValidPointer(pPages[p][i]))
+                m_DisassembleFreeList.push_back(pPages[p][i]);
         }
-    }
 
-    #endif
-}
\ No newline at end of file
+        SafeDeleteArray(pPages[p]);
+    }
+}
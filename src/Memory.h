@@ -24,6 +24,18 @@
 #include "MemoryRule.h"
 #include <vector>
 
+#define MEMORY_PAGE_SHIFT 10
+#define MEMORY_PAGE_SIZE (1 << MEMORY_PAGE_SHIFT)
+#define MEMORY_PAGE_MASK (MEMORY_PAGE_SIZE - 1)
+#define MEMORY_PAGE_COUNT (0x10000 >> MEMORY_PAGE_SHIFT)
+
+#define DISASSEMBLE_PAGE_SHIFT 14
+#define DISASSEMBLE_PAGE_SIZE (1 << DISASSEMBLE_PAGE_SHIFT)
+#define DISASSEMBLE_PAGE_MASK (DISASSEMBLE_PAGE_SIZE - 1)
+#define DISASSEMBLE_RAM_PAGE_COUNT (0x10000 >> DISASSEMBLE_PAGE_SHIFT)
+#define DISASSEMBLE_ROM_PAGE_COUNT (MAX_ROM_SIZE >> DISASSEMBLE_PAGE_SHIFT)
+#define DISASSEMBLE_POOL_BLOCK_SIZE 1024
+
 class Processor;
 
 class Memory
@@ -73,16 +85,21 @@ public:
     void Write(u16 address, u8 value);
     u8 Retrieve(u16 address);
     void Load(u16 address, u8 value);
-    stDisassembleRecord** GetDisassembledMemoryMap();
-    stDisassembleRecord** GetDisassembledROMMemoryMap();
+    void UpdatePageTable();
+    void MapReadPages(u16 address, int size, u8* pHost);
+    void MapWritePages(u16 address, int size, u8* pHost);
+    stDisassembleRecord* GetDisassembleRecord(int offset, bool rom);
+    stDisassembleRecord* GetOrCreateDisassembleRecord(int offset, bool rom);
     void LoadSlotsFromROM(u8* pTheROM, int size);
     void MemoryDump(const char* szFilePath);
-    void SaveState(std::ostream& stream);
-    void LoadState(std::istream& stream);
+    void SaveState(StateWriter& state);
+    void LoadState(StateReader& state);
     std::vector<stDisassembleRecord*>* GetBreakpointsCPU();
     std::vector<stMemoryBreakpoint>* GetBreakpointsMem();
     stDisassembleRecord* GetRunToBreakpoint();
     void SetRunToBreakpoint(stDisassembleRecord* pBreakpoint);
+    bool HasBreakpoints();
+    void EnableMemoryBreakpoints(bool enable);
     void EnableBootromSMS(bool enable);
     void EnableBootromGG(bool enable);
     void LoadBootromSMS(const char* szFilePath);
@@ -100,17 +117,25 @@ public:
 private:
     void LoadBootroom(const char* szFilePath, bool gg);
     void CheckBreakpoints(u16 address, bool write);
+    stDisassembleRecord* AllocDisassembleRecord();
+    void FreeDisassemblePages(stDisassembleRecord*** pPages, int count);
 
 private:
     Processor* m_pProcessor;
     MemoryRule* m_pCurrentMemoryRule;
     MemoryRule* m_pBootromMemoryRule;
     u8* m_pMap;
-    stDisassembleRecord** m_pDisassembledMap;
-    stDisassembleRecord** m_pDisassembledROMMap;
+    u8* m_pReadPages[MEMORY_PAGE_COUNT];
+    u8* m_pWritePages[MEMORY_PAGE_COUNT];
+    stDisassembleRecord** m_pDisassembledMap[DISASSEMBLE_RAM_PAGE_COUNT];
+    stDisassembleRecord** m_pDisassembledROMMap[DISASSEMBLE_ROM_PAGE_COUNT];
+    std::vector<stDisassembleRecord*> m_DisassemblePool;
+    std::vector<stDisassembleRecord*> m_DisassembleFreeList;
+    int m_iDisassemblePoolUsed;
     std::vector<stDisassembleRecord*> m_BreakpointsCPU;
     std::vector<stMemoryBreakpoint> m_BreakpointsMem;
     stDisassembleRecord* m_pRunToBreakpoint;
+    bool m_bMemoryBreakpointsEnabled;
     bool m_bBootromSMSEnabled;
     bool m_bBootromGGEnabled;
     bool m_bBootromSMSLoaded;
@@ -30,6 +30,10 @@ MemoryRule::~MemoryRule()
 {
 }
 
+void MemoryRule::MapPages()
+{
+}
+
 void MemoryRule::SaveRam(std::ostream&)
 {
 }
@@ -74,10 +78,10 @@ int MemoryRule::GetBank(int)
     return 0;
 }
 
-void MemoryRule::SaveState(std::ostream&)
+void MemoryRule::SaveState(StateWriter&)
 {
 }
 
-void MemoryRule::LoadState(std::istream&)
+void MemoryRule::LoadState(StateReader&)
 {
 }
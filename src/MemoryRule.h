@@ -21,6 +21,7 @@
 #define	MEMORYRULE_H
 
 #include "definitions.h"
+#include "StateSerializer.h"
 
 class Memory;
 class Cartridge;
@@ -34,6 +35,7 @@ public:
     virtual u8 PerformRead(u16 address) = 0;
     virtual void PerformWrite(u16 address, u8 value) = 0;
     virtual void Reset() = 0;
+    virtual void MapPages();
     virtual void SaveRam(std::ostream &file);
     virtual bool LoadRam(std::istream &file, s32 fileSize);
     virtual void SetRamChangedCallback(RamChangedCallback callback);
@@ -43,8 +45,8 @@ public:
     virtual int GetRamBank();
     virtual u8* GetPage(int index);
     virtual int GetBank(int index);
-    virtual void SaveState(std::ostream& stream);
-    virtual void LoadState(std::istream& stream);
+    virtual void SaveState(StateWriter& state);
+    virtual void LoadState(StateReader& state);
 
 protected:
     Memory* m_pMemory;
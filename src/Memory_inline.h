@@ -23,9 +23,15 @@
 inline u8 Memory::Read(u16 address)
 {
     #ifndef GEARSYSTEM_DISABLE_DISASSEMBLER
-    CheckBreakpoints(address, false);
+    if (m_bMemoryBreakpointsEnabled)
+        CheckBreakpoints(address, false);
     #endif
 
+    u8* pPage = m_pReadPages[address >> MEMORY_PAGE_SHIFT];
+
+    if (IsValidPointer(pPage))
+        return pPage[address & MEMORY_PAGE_MASK];
+
     if (m_MediaSlot == m_DesiredMediaSlot)
         return m_pCurrentMemoryRule->PerformRead(address);
 
@@ -41,10 +47,15 @@ inline u8 Memory::Read(u16 address)
 inline void Memory::Write(u16 address, u8 value)
 {
     #ifndef GEARSYSTEM_DISABLE_DISASSEMBLER
-    CheckBreakpoints(address, true);
+    if (m_bMemoryBreakpointsEnabled)
+        CheckBreakpoints(address, true);
     #endif
 
-    if (m_MediaSlot == m_DesiredMediaSlot)
+    u8* pPage = m_pWritePages[address >> MEMORY_PAGE_SHIFT];
+
+    if (IsValidPointer(pPage))
+        pPage[address & MEMORY_PAGE_MASK] = value;
+    else if (m_MediaSlot == m_DesiredMediaSlot)
         m_pCurrentMemoryRule->PerformWrite(address, value);
     else if (m_MediaSlot == BiosSlot)
         m_pBootromMemoryRule->PerformWrite(address, value);
@@ -62,14 +73,32 @@ inline void Memory::Load(u16 address, u8 value)
     m_pMap[address] = value;
 }
 
-inline Memory::stDisassembleRecord** Memory::GetDisassembledMemoryMap()
+inline void Memory::MapReadPages(u16 address, int size, u8* pHost)
 {
-    return m_pDisassembledMap;
+    int first = address >> MEMORY_PAGE_SHIFT;
+    int count = size >> MEMORY_PAGE_SHIFT;
+
+    for (int i = 0; i < count; i++)
+        m_pReadPages[first + i] = pHost + (i << MEMORY_PAGE_SHIFT);
 }
 
-inline Memory::stDisassembleRecord** Memory::GetDisassembledROMMemoryMap()
+inline void Memory::MapWritePages(u16 address, int size, u8* pHost)
 {
-    return m_pDisassembledROMMap;
+    int first = address >> MEMORY_PAGE_SHIFT;
+    int count = size >> MEMORY_PAGE_SHIFT;
+
+    for (int i = 0; i < count; i++)
+        m_pWritePages[first + i] = pHost + (i << MEMORY_PAGE_SHIFT);
+}
+
+inline Memory::stDisassembleRecord* Memory::GetDisassembleRecord(int offset, bool rom)
+{
+    stDisassembleRecord** page = rom ? m_pDisassembledROMMap[offset >> DISASSEMBLE_PAGE_SHIFT] : m_pDisassembledMap[offset >> DISASSEMBLE_PAGE_SHIFT];
+
+    if (!IsValidPointer(page))
+        return NULL;
+
+    return page[offset & DISASSEMBLE_PAGE_MASK];
 }
 
 #endif	/* MEMORY_INLINE_H */
@@ -36,6 +36,9 @@ Processor::Processor(Memory* pMemory)
     m_bBranchTaken = false;
     m_iTStates = 0;
     m_iInjectedTStates = 0;
+    m_iPendingTStates = 0;
+    m_iLastTStates = 0;
+    m_bSyncRequested = false;
     m_bAfterEI = false;
     m_iInterruptMode = 0;
     m_bINTRequested = false;
@@ -46,6 +49,14 @@ Processor::Processor(Memory* pMemory)
     m_ProActionReplayList.clear();
     m_bBreakpointHit = false;
     m_bRequestMemBreakpoint = false;
+    m_bDebugEnabled = false;
+    m_Interpreter = InterpreterSwitch;
+    InitPointer(m_pLockstepTrace);
+    m_LazyFlagsOp = LazyFlagsNone;
+    m_LazyFlagsA = 0;
+    m_LazyFlagsB = 0;
+    m_LazyFlagsCarry = 0;
+    m_LazyFlagsResult = 0;
 
     m_ProcessorState.AF = &AF;
     m_ProcessorState.BC = &BC;
@@ -86,12 +97,16 @@ void Processor::Reset()
     m_bBranchTaken = false;
     m_iTStates = 0;
     m_iInjectedTStates = 0;
+    m_iPendingTStates = 0;
+    m_iLastTStates = 0;
+    m_bSyncRequested = false;
     m_bAfterEI = false;
     m_iInterruptMode = 1;
     PC.SetValue(0x0000);
     SP.SetValue(0xDFF0);
     IX.SetValue(0xFFFF);
     IY.SetValue(0xFFFF);
+    m_LazyFlagsOp = LazyFlagsNone;
     AF.SetValue(0x0040);  // Zero flag set
     BC.SetValue(0x0000);
     DE.SetValue(0x0000);
@@ -123,62 +138,176 @@ IOPorts* Processor::GetIOPOrts()
     return m_pIOPorts;
 }
 
-unsigned int Processor::RunFor(unsigned int tstates)
+template <Processor::Interpreter interpreter>
+inline void Processor::ExecuteInstruction()
 {
-    u8 executed = 0;
+    m_iTStates = 0;
 
-    while (executed < tstates)
-    {
-        m_iTStates = 0;
-        m_bBreakpointHit = false;
-        m_bRequestMemBreakpoint = false;
+    bool interrupt = false;
 
-        if (!m_bInputLastCycle)
+    if (!m_bInputLastCycle)
+    {
+        if (m_bNMIRequested)
         {
-            if (m_bNMIRequested)
-            {
-                LeaveHalt();
-                m_bNMIRequested = false;
-                m_bIFF1 = false;
-                StackPush(&PC);
-                PC.SetValue(0x0066);
-                m_iTStates += 11;
-                IncreaseR();
-                WZ.SetValue(PC.GetValue());
-                DisassembleNextOpcode();
-                return m_iTStates;
-            }
-            else if (m_bIFF1 && m_bINTRequested && !m_bAfterEI)
-            {
-                LeaveHalt();
-                m_bIFF1 = false;
-                m_bIFF2 = false;
-                StackPush(&PC);
-                PC.SetValue(0x0038);
-                m_iTStates += 13;
-                IncreaseR();
-                WZ.SetValue(PC.GetValue());
-                UpdateProActionReplay();
-                DisassembleNextOpcode();
-                return m_iTStates;
-            }
-
-            m_bAfterEI = false;
+            LeaveHalt();
+            m_bNMIRequested = false;
+            m_bIFF1 = false;
+            StackPush(&PC);
+            PC.SetValue(0x0066);
+            m_iTStates += 11;
+            IncreaseR();
+            WZ.SetValue(PC.GetValue());
+            interrupt = true;
+        }
+        else if (m_bIFF1 && m_bINTRequested && !m_bAfterEI)
+        {
+            LeaveHalt();
+            m_bIFF1 = false;
+            m_bIFF2 = false;
+            StackPush(&PC);
+            PC.SetValue(0x0038);
+            m_iTStates += 13;
+            IncreaseR();
+            WZ.SetValue(PC.GetValue());
+            UpdateProActionReplay();
+            interrupt = true;
         }
+        else
+            m_bAfterEI = false;
+    }
+
+    if (!interrupt)
+    {
+        if (interpreter == InterpreterSwitch)
+            ExecuteOPCodeSwitch();
+        else
+            ExecuteOPCode();
+    }
+
+    m_iTStates += m_iInjectedTStates;
+    m_iInjectedTStates = 0;
 
-        ExecuteOPCode();
-        DisassembleNextOpcode();
+    m_iPendingTStates += m_iTStates;
+    m_iLastTStates = m_iTStates;
+}
+
+void Processor::ExecuteInstruction()
+{
+    switch (m_Interpreter)
+    {
+        case InterpreterSwitch:
+            ExecuteInstruction<InterpreterSwitch>();
+            break;
+        default:
+            ExecuteInstruction<InterpreterTable>();
+    }
+}
+
+// The interpreter is fixed for the whole run so the compiler can inline the
+// opcode dispatch into the loop instead of selecting it on every instruction
+template <Processor::Interpreter interpreter>
+unsigned int Processor::RunInstructions(unsigned int tstates)
+{
+    unsigned int executed = 0;
+
+    while (executed < tstates)
+    {
+        ExecuteInstruction<interpreter>();
 
         executed += m_iTStates;
 
-        if (m_iInjectedTStates > 0)
+        if (m_bSyncRequested)
+            break;
+    }
+
+    return executed;
+}
+
+unsigned int Processor::RunFor(unsigned int tstates)
+{
+    unsigned int executed = 0;
+
+    m_bSyncRequested = false;
+
+    if (m_bDebugEnabled || IsValidPointer(m_pLockstepTrace))
+    {
+        while (executed < tstates)
         {
-            executed += m_iInjectedTStates;
-            m_iInjectedTStates = 0;
+            m_bBreakpointHit = false;
+            m_bRequestMemBreakpoint = false;
+
+            ExecuteInstruction();
+            DisassembleNextOpcode();
+
+            if (IsValidPointer(m_pLockstepTrace))
+                RecordLockstep();
+
+            executed += m_iTStates;
+
+            if (m_bSyncRequested || m_bBreakpointHit)
+                break;
         }
+
+        return executed;
     }
 
-    return executed;
+    switch (m_Interpreter)
+    {
+        case InterpreterSwitch:
+            return RunInstructions<InterpreterSwitch>(tstates);
+        default:
+            return RunInstructions<InterpreterTable>(tstates);
+    }
+}
+
+void Processor::EnableDebug(bool enable)
+{
+    m_bDebugEnabled = enable;
+
+    if (!enable)
+    {
+        m_bBreakpointHit = false;
+        m_bRequestMemBreakpoint = false;
+    }
+}
+
+void Processor::SetInterpreter(Interpreter interpreter)
+{
+    m_Interpreter = interpreter;
+}
+
+Processor::Interpreter Processor::GetInterpreter()
+{
+    return m_Interpreter;
+}
+
+void Processor::SetLockstepTrace(std::vector<stLockstepRecord>* pTrace)
+{
+    m_pLockstepTrace = pTrace;
+}
+
+void Processor::RecordLockstep()
+{
+    stLockstepRecord record;
+    MaterializeFlags();
+    record.AF = AF.GetValue();
+    record.BC = BC.GetValue();
+    record.DE = DE.GetValue();
+    record.HL = HL.GetValue();
+    record.AF2 = AF2.GetValue();
+    record.BC2 = BC2.GetValue();
+    record.DE2 = DE2.GetValue();
+    record.HL2 = HL2.GetValue();
+    record.IX = IX.GetValue();
+    record.IY = IY.GetValue();
+    record.SP = SP.GetValue();
+    record.PC = PC.GetValue();
+    record.WZ = WZ.GetValue();
+    record.I = I;
+    record.R = R;
+    record.flags = (m_bIFF1 ? 0x01 : 0) | (m_bIFF2 ? 0x02 : 0) | (m_bHalt ? 0x04 : 0) | (m_bAfterEI ? 0x08 : 0);
+    record.tstates = static_cast<u8> (m_iTStates);
+    m_pLockstepTrace->push_back(record);
 }
 
 void Processor::InjectTStates(unsigned int tstates)
@@ -288,6 +417,90 @@ void Processor::ExecuteOPCode()
     }
 }
 
+void Processor::ExecuteOPCodeSwitch()
+{
+    u8 opcode = FetchOPCode();
+
+    switch (opcode)
+    {
+        case 0xDD:
+        case 0xFD:
+        {
+            int more_prefixes = false;
+            while ((opcode == 0xDD) | (opcode == 0xFD))
+            {
+                m_CurrentPrefix = opcode;
+                opcode = FetchOPCode();
+                if (more_prefixes)
+                    m_iTStates += 4;
+                more_prefixes = true;
+                IncreaseR();
+            }
+
+            if (m_CurrentPrefix == 0xDD)
+                ExecuteOPCodeSwitch<0xDD>(opcode);
+            else
+                ExecuteOPCodeSwitch<0xFD>(opcode);
+            break;
+        }
+        default:
+        {
+            m_CurrentPrefix = 0x00;
+            ExecuteOPCodeSwitch<0x00>(opcode);
+            break;
+        }
+    }
+}
+
+void Processor::ResolveLazyFlags()
+{
+    LazyFlagsOp op = m_LazyFlagsOp;
+    u8 result = m_LazyFlagsResult;
+    u8 flags = FLAG_NONE;
+
+    m_LazyFlagsOp = LazyFlagsNone;
+
+    switch (op)
+    {
+        case LazyFlagsADD:
+        case LazyFlagsSUB:
+        case LazyFlagsCP:
+        {
+            int full = (op == LazyFlagsADD) ?
+                    (m_LazyFlagsA + m_LazyFlagsB + m_LazyFlagsCarry) :
+                    (m_LazyFlagsA - m_LazyFlagsB - m_LazyFlagsCarry);
+            int carrybits = m_LazyFlagsA ^ m_LazyFlagsB ^ full;
+            // CP takes the undocumented flags from the operand
+            if (op == LazyFlagsCP)
+                flags = (kOPCodeSZXYTable[result] & (FLAG_SIGN | FLAG_ZERO)) | (m_LazyFlagsB & (FLAG_X | FLAG_Y));
+            else
+                flags = kOPCodeSZXYTable[result];
+            if (op != LazyFlagsADD)
+                flags |= FLAG_NEGATIVE;
+            flags |= (carrybits >> 8) & FLAG_CARRY;
+            flags |= carrybits & FLAG_HALF;
+            flags |= (((carrybits << 1) ^ carrybits) >> 6) & FLAG_PARITY;
+            break;
+        }
+        case LazyFlagsAND:
+            flags = kOPCodeSZXYPTable[result] | FLAG_HALF;
+            break;
+        case LazyFlagsLogic:
+            flags = kOPCodeSZXYPTable[result];
+            break;
+        case LazyFlagsINC:
+            flags = kOPCodeINCFlagsTable[result] | m_LazyFlagsCarry;
+            break;
+        case LazyFlagsDEC:
+            flags = kOPCodeDECFlagsTable[result] | m_LazyFlagsCarry;
+            break;
+        default:
+            return;
+    }
+
+    AF.SetLow(flags);
+}
+
 void Processor::InvalidOPCode()
 {
 #ifdef DEBUG_GEARSYSTEM
@@ -336,11 +549,6 @@ void Processor::DisassembleNextOpcode()
 
 bool Processor::Disassemble(u16 address)
 {
-    Memory::stDisassembleRecord** memoryMap = m_pMemory->GetDisassembledMemoryMap();
-    Memory::stDisassembleRecord** romMap = m_pMemory->GetDisassembledROMMemoryMap();
-
-    Memory::stDisassembleRecord** map = NULL;
-
     int offset = address;
     int bank = 0;
     bool rom = false;
@@ -350,66 +558,40 @@ bool Processor::Disassemble(u16 address)
     case 0x0000:
         bank = m_pMemory->GetCurrentRule()->GetBank(0);
         offset = (0x4000 * bank) + address;
-        map = romMap;
         rom = true;
         break;
     case 0x4000:
         bank = m_pMemory->GetCurrentRule()->GetBank(1);
         offset = (0x4000 * bank) + (address & 0x3FFF);
-        map = romMap;
         rom = true;
         break;
     case 0x8000:
         bank = m_pMemory->GetCurrentRule()->GetBank(2);
         offset = (0x4000 * bank) + (address & 0x3FFF);
-        map = romMap;
         rom = true;
         break;
     default:
-        map = memoryMap;
         rom = false;
     }
 
-    if (!IsValidPointer(map[offset]))
-    {
-        map[offset] = new Memory::stDisassembleRecord;
-
-        if (rom)
-        {
-            map[offset]->address = offset & 0x3FFF;
-            map[offset]->bank = offset >> 14;
-        }
-        else
-        {
-            map[offset]->address = offset;
-            map[offset]->bank = 0;
-        }
-
-        map[offset]->name[0] = 0;
-        map[offset]->bytes[0] = 0;
-        map[offset]->size = 0;
-        for (int i = 0; i < 4; i++)
-            map[offset]->opcodes[i] = 0;
-        map[offset]->jump = false;
-        map[offset]->jump_address = 0;
-    }
+    Memory::stDisassembleRecord* record = m_pMemory->GetOrCreateDisassembleRecord(offset, rom);
 
     u8 opcodes[6];
     bool changed = false;
-    int maxSize = std::min(map[offset]->size, 4);
+    int maxSize = std::min(record->size, 4);
 
     for (int i = 0; i < maxSize; i++)
     {
         opcodes[i] = m_pMemory->Read(address + i);
 
-        if (opcodes[i] != map[offset]->opcodes[i])
+        if (opcodes[i] != record->opcodes[i])
             changed = true;
     }
 
-    if ((map[offset]->size == 0) || changed)
+    if ((record->size == 0) || changed)
     {
-        map[offset]->bank = bank;
-        map[offset]->address = address;
+        record->bank = bank;
+        record->address = address;
 
         std::vector<u8> bytes; 
         u16 opcode_temp_addr = address;
@@ -469,25 +651,25 @@ bool Processor::Disassemble(u16 address)
                 info = kOPCodeNames[opcode];
         }
 
-        map[offset]->size = info.size + (first > 1 ? (first - 1) : 0);
-        map[offset]->bytes[0] = 0;
+        record->size = info.size + (first > 1 ? (first - 1) : 0);
+        record->bytes[0] = 0;
 
         for (int i = 0; i < (int)bytes.size(); i++)
         {
-            if (i < map[offset]->size)
+            if (i < record->size)
             {
                 char value[8];
                 sprintf(value, "%02X", bytes[i]);
-                strcat(map[offset]->bytes, value);
-                strcat(map[offset]->bytes, " ");
+                strcat(record->bytes, value);
+                strcat(record->bytes, " ");
             }
             else if (i < 4)
             {
-                strcat(map[offset]->bytes, "   ");
+                strcat(record->bytes, "   ");
             }
 
             if (i < 4)
-                map[offset]->opcodes[i] = bytes[i];
+                record->opcodes[i] = bytes[i];
         }
 
         first += prefixed ? 1 : 0;
@@ -495,32 +677,32 @@ bool Processor::Disassemble(u16 address)
         switch (info.type)
         {
             case 0:
-                strcpy(map[offset]->name, info.name);
+                strcpy(record->name, info.name);
                 break;
             case 1:
-                sprintf(map[offset]->name, info.name, bytes[first]);
+                sprintf(record->name, info.name, bytes[first]);
                 break;
             case 2:
-                sprintf(map[offset]->name, info.name, bytes[first + 1]);
+                sprintf(record->name, info.name, bytes[first + 1]);
                 break;
             case 3:
-                map[offset]->jump = true;
-                map[offset]->jump_address = (bytes[first + 2] << 8) | bytes[first + 1];
-                sprintf(map[offset]->name, info.name, map[offset]->jump_address);
+                record->jump = true;
+                record->jump_address = (bytes[first + 2] << 8) | bytes[first + 1];
+                sprintf(record->name, info.name, record->jump_address);
                 break;
             case 4:
-                sprintf(map[offset]->name, info.name, (s8)bytes[first + 1]);
+                sprintf(record->name, info.name, (s8)bytes[first + 1]);
                 break;
             case 5:
-                map[offset]->jump = true;
-                map[offset]->jump_address = address + info.size + (s8)bytes[first + 1];
-                sprintf(map[offset]->name, info.name, map[offset]->jump_address, (s8)bytes[first + 1]);
+                record->jump = true;
+                record->jump_address = address + info.size + (s8)bytes[first + 1];
+                sprintf(record->name, info.name, record->jump_address, (s8)bytes[first + 1]);
                 break;
             case 6:
-                sprintf(map[offset]->name, info.name, (s8)bytes[first + 1], bytes[first + 2]);
+                sprintf(record->name, info.name, (s8)bytes[first + 1], bytes[first + 2]);
                 break;
             default:
-                strcpy(map[offset]->name, "PARSE ERROR");
+                strcpy(record->name, "PARSE ERROR");
         }
     }
 
@@ -529,7 +711,7 @@ bool Processor::Disassemble(u16 address)
 
     if (IsValidPointer(runtobreakpoint))
     {
-        if (runtobreakpoint == map[offset])
+        if (runtobreakpoint == record)
         {
             m_pMemory->SetRunToBreakpoint(NULL);
             return true;
@@ -543,7 +725,7 @@ bool Processor::Disassemble(u16 address)
 
         for (std::size_t b = 0; b < size; b++)
         {
-            if ((*breakpoints)[b] == map[offset])
+            if ((*breakpoints)[b] == record)
             {
                 return true;
             }
@@ -568,9 +750,9 @@ void Processor::RequestMemoryBreakpoint()
     m_bRequestMemBreakpoint = true;
 }
 
-void Processor::SaveState(std::ostream& stream)
+void Processor::SaveState(StateWriter& state)
 {
-    using namespace std;
+    MaterializeFlags();
 
     u16 af = AF.GetValue();
     u16 bc = BC.GetValue();
@@ -588,60 +770,59 @@ void Processor::SaveState(std::ostream& stream)
     u8 i = I;
     u8 r = R;
 
-    stream.write(reinterpret_cast<const char*> (&af), sizeof(af));
-    stream.write(reinterpret_cast<const char*> (&bc), sizeof(bc));
-    stream.write(reinterpret_cast<const char*> (&de), sizeof(de));
-    stream.write(reinterpret_cast<const char*> (&hl), sizeof(hl));
-    stream.write(reinterpret_cast<const char*> (&af2), sizeof(af2));
-    stream.write(reinterpret_cast<const char*> (&bc2), sizeof(bc2));
-    stream.write(reinterpret_cast<const char*> (&de2), sizeof(de2));
-    stream.write(reinterpret_cast<const char*> (&hl2), sizeof(hl2));
-    stream.write(reinterpret_cast<const char*> (&sp), sizeof(sp));
-    stream.write(reinterpret_cast<const char*> (&pc), sizeof(pc));
-    stream.write(reinterpret_cast<const char*> (&ix), sizeof(ix));
-    stream.write(reinterpret_cast<const char*> (&iy), sizeof(iy));
-    stream.write(reinterpret_cast<const char*> (&wz), sizeof(wz));
-    stream.write(reinterpret_cast<const char*> (&i), sizeof(i));
-    stream.write(reinterpret_cast<const char*> (&r), sizeof(r));
-
-    stream.write(reinterpret_cast<const char*> (&m_bIFF1), sizeof(m_bIFF1));
-    stream.write(reinterpret_cast<const char*> (&m_bIFF2), sizeof(m_bIFF2));
-    stream.write(reinterpret_cast<const char*> (&m_bHalt), sizeof(m_bHalt));
-    stream.write(reinterpret_cast<const char*> (&m_bBranchTaken), sizeof(m_bBranchTaken));
-    stream.write(reinterpret_cast<const char*> (&m_iTStates), sizeof(m_iTStates));
-    stream.write(reinterpret_cast<const char*> (&m_bAfterEI), sizeof(m_bAfterEI));
-    stream.write(reinterpret_cast<const char*> (&m_iInterruptMode), sizeof(m_iInterruptMode));
-    stream.write(reinterpret_cast<const char*> (&m_CurrentPrefix), sizeof(m_CurrentPrefix));
-    stream.write(reinterpret_cast<const char*> (&m_bINTRequested), sizeof(m_bINTRequested));
-    stream.write(reinterpret_cast<const char*> (&m_bNMIRequested), sizeof(m_bNMIRequested));
-    stream.write(reinterpret_cast<const char*> (&m_bPrefixedCBOpcode), sizeof(m_bPrefixedCBOpcode));
-    stream.write(reinterpret_cast<const char*> (&m_PrefixedCBValue), sizeof(m_PrefixedCBValue));
-    stream.write(reinterpret_cast<const char*> (&m_bInputLastCycle), sizeof(m_bInputLastCycle));
+    state.Write(&af, sizeof(af));
+    state.Write(&bc, sizeof(bc));
+    state.Write(&de, sizeof(de));
+    state.Write(&hl, sizeof(hl));
+    state.Write(&af2, sizeof(af2));
+    state.Write(&bc2, sizeof(bc2));
+    state.Write(&de2, sizeof(de2));
+    state.Write(&hl2, sizeof(hl2));
+    state.Write(&sp, sizeof(sp));
+    state.Write(&pc, sizeof(pc));
+    state.Write(&ix, sizeof(ix));
+    state.Write(&iy, sizeof(iy));
+    state.Write(&wz, sizeof(wz));
+    state.Write(&i, sizeof(i));
+    state.Write(&r, sizeof(r));
+
+    state.Write(&m_bIFF1, sizeof(m_bIFF1));
+    state.Write(&m_bIFF2, sizeof(m_bIFF2));
+    state.Write(&m_bHalt, sizeof(m_bHalt));
+    state.Write(&m_bBranchTaken, sizeof(m_bBranchTaken));
+    state.Write(&m_iTStates, sizeof(m_iTStates));
+    state.Write(&m_bAfterEI, sizeof(m_bAfterEI));
+    state.Write(&m_iInterruptMode, sizeof(m_iInterruptMode));
+    state.Write(&m_CurrentPrefix, sizeof(m_CurrentPrefix));
+    state.Write(&m_bINTRequested, sizeof(m_bINTRequested));
+    state.Write(&m_bNMIRequested, sizeof(m_bNMIRequested));
+    state.Write(&m_bPrefixedCBOpcode, sizeof(m_bPrefixedCBOpcode));
+    state.Write(&m_PrefixedCBValue, sizeof(m_PrefixedCBValue));
+    state.Write(&m_bInputLastCycle, sizeof(m_bInputLastCycle));
 }
 
-void Processor::LoadState(std::istream& stream)
+void Processor::LoadState(StateReader& state)
 {
-    using namespace std;
-
     u16 af, bc, de, hl, af2, bc2, de2, hl2, sp, pc, ix, iy, wz;
     u8 i, r;
 
-    stream.read(reinterpret_cast<char*> (&af), sizeof(af));
-    stream.read(reinterpret_cast<char*> (&bc), sizeof(bc));
-    stream.read(reinterpret_cast<char*> (&de), sizeof(de));
-    stream.read(reinterpret_cast<char*> (&hl), sizeof(hl));
-    stream.read(reinterpret_cast<char*> (&af2), sizeof(af2));
-    stream.read(reinterpret_cast<char*> (&bc2), sizeof(bc2));
-    stream.read(reinterpret_cast<char*> (&de2), sizeof(de2));
-    stream.read(reinterpret_cast<char*> (&hl2), sizeof(hl2));
-    stream.read(reinterpret_cast<char*> (&sp), sizeof(sp));
-    stream.read(reinterpret_cast<char*> (&pc), sizeof(pc));
-    stream.read(reinterpret_cast<char*> (&ix), sizeof(ix));
-    stream.read(reinterpret_cast<char*> (&iy), sizeof(iy));
-    stream.read(reinterpret_cast<char*> (&wz), sizeof(wz));
-    stream.read(reinterpret_cast<char*> (&i), sizeof(i));
-    stream.read(reinterpret_cast<char*> (&r), sizeof(r));
-
+    state.Read(&af, sizeof(af));
+    state.Read(&bc, sizeof(bc));
+    state.Read(&de, sizeof(de));
+    state.Read(&hl, sizeof(hl));
+    state.Read(&af2, sizeof(af2));
+    state.Read(&bc2, sizeof(bc2));
+    state.Read(&de2, sizeof(de2));
+    state.Read(&hl2, sizeof(hl2));
+    state.Read(&sp, sizeof(sp));
+    state.Read(&pc, sizeof(pc));
+    state.Read(&ix, sizeof(ix));
+    state.Read(&iy, sizeof(iy));
+    state.Read(&wz, sizeof(wz));
+    state.Read(&i, sizeof(i));
+    state.Read(&r, sizeof(r));
+
+    m_LazyFlagsOp = LazyFlagsNone;
     AF.SetValue(af);
     BC.SetValue(bc);
     DE.SetValue(de);
@@ -658,19 +839,19 @@ void Processor::LoadState(std::istream& stream)
     I = i;
     R = r;
 
-    stream.read(reinterpret_cast<char*> (&m_bIFF1), sizeof(m_bIFF1));
-    stream.read(reinterpret_cast<char*> (&m_bIFF2), sizeof(m_bIFF2));
-    stream.read(reinterpret_cast<char*> (&m_bHalt), sizeof(m_bHalt));
-    stream.read(reinterpret_cast<char*> (&m_bBranchTaken), sizeof(m_bBranchTaken));
-    stream.read(reinterpret_cast<char*> (&m_iTStates), sizeof(m_iTStates));
-    stream.read(reinterpret_cast<char*> (&m_bAfterEI), sizeof(m_bAfterEI));
-    stream.read(reinterpret_cast<char*> (&m_iInterruptMode), sizeof(m_iInterruptMode));
-    stream.read(reinterpret_cast<char*> (&m_CurrentPrefix), sizeof(m_CurrentPrefix));
-    stream.read(reinterpret_cast<char*> (&m_bINTRequested), sizeof(m_bINTRequested));
-    stream.read(reinterpret_cast<char*> (&m_bNMIRequested), sizeof(m_bNMIRequested));
-    stream.read(reinterpret_cast<char*> (&m_bPrefixedCBOpcode), sizeof(m_bPrefixedCBOpcode));
-    stream.read(reinterpret_cast<char*> (&m_PrefixedCBValue), sizeof(m_PrefixedCBValue));
-    stream.read(reinterpret_cast<char*> (&m_bInputLastCycle), sizeof(m_bInputLastCycle));
+    state.Read(&m_bIFF1, sizeof(m_bIFF1));
+    state.Read(&m_bIFF2, sizeof(m_bIFF2));
+    state.Read(&m_bHalt, sizeof(m_bHalt));
+    state.Read(&m_bBranchTaken, sizeof(m_bBranchTaken));
+    state.Read(&m_iTStates, sizeof(m_iTStates));
+    state.Read(&m_bAfterEI, sizeof(m_bAfterEI));
+    state.Read(&m_iInterruptMode, sizeof(m_iInterruptMode));
+    state.Read(&m_CurrentPrefix, sizeof(m_CurrentPrefix));
+    state.Read(&m_bINTRequested, sizeof(m_bINTRequested));
+    state.Read(&m_bNMIRequested, sizeof(m_bNMIRequested));
+    state.Read(&m_bPrefixedCBOpcode, sizeof(m_bPrefixedCBOpcode));
+    state.Read(&m_PrefixedCBValue, sizeof(m_PrefixedCBValue));
+    state.Read(&m_bInputLastCycle, sizeof(m_bInputLastCycle));
 }
 
 void Processor::SetProActionReplayCheat(const char* szCheat)
@@ -701,6 +882,11 @@ void Processor::ClearProActionReplayCheats()
     m_ProActionReplayList.clear();
 }
 
+void Processor::CopyProActionReplayCheats(Processor* pProcessor)
+{
+    m_ProActionReplayList = pProcessor->m_ProActionReplayList;
+}
+
 void Processor::UpdateProActionReplay()
 {
     std::list<ProActionReplayCode>::iterator it;
@@ -713,6 +899,7 @@ void Processor::UpdateProActionReplay()
 
 Processor::ProcessorState* Processor::GetState()
 {
+    MaterializeFlags();
     return &m_ProcessorState;
 }
 
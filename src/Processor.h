@@ -22,6 +22,7 @@
 
 #include <list>
 #include "definitions.h"
+#include "opcode_flags.h"
 #include "SixteenBitRegister.h"
 #include "Memory.h"
 
@@ -54,21 +55,56 @@ public:
         bool* NMI;
     };
 
+    enum Interpreter
+    {
+        InterpreterTable,
+        InterpreterSwitch
+    };
+
+    struct stLockstepRecord
+    {
+        u16 AF;
+        u16 BC;
+        u16 DE;
+        u16 HL;
+        u16 AF2;
+        u16 BC2;
+        u16 DE2;
+        u16 HL2;
+        u16 IX;
+        u16 IY;
+        u16 SP;
+        u16 PC;
+        u16 WZ;
+        u8 I;
+        u8 R;
+        u8 flags;
+        u8 tstates;
+    };
+
 public:
     Processor(Memory* pMemory);
     ~Processor();
     void Init();
     void Reset();
     unsigned int RunFor(unsigned int tstates);
+    void EnableDebug(bool enable);
+    void SetInterpreter(Interpreter interpreter);
+    Interpreter GetInterpreter();
+    void SetLockstepTrace(std::vector<stLockstepRecord>* pTrace);
+    unsigned int ConsumePendingTStates();
+    unsigned int GetLastInstructionTStates();
+    void RequestSync();
     void InjectTStates(unsigned int tstates);
     void RequestINT(bool assert);
     void RequestNMI();
     void SetIOPOrts(IOPorts* pIOPorts);
     IOPorts* GetIOPOrts();
-    void SaveState(std::ostream& stream);
-    void LoadState(std::istream& stream);
+    void SaveState(StateWriter& state);
+    void LoadState(StateReader& state);
     void SetProActionReplayCheat(const char* szCheat);
     void ClearProActionReplayCheats();
+    void CopyProActionReplayCheats(Processor* pProcessor);
     ProcessorState* GetState();
     bool Disassemble(u16 address);
     void DisassembleNextOpcode();
@@ -103,6 +139,9 @@ private:
     bool m_bBranchTaken;
     unsigned int m_iTStates;
     unsigned int m_iInjectedTStates;
+    unsigned int m_iPendingTStates;
+    unsigned int m_iLastTStates;
+    bool m_bSyncRequested;
     bool m_bAfterEI;
     int m_iInterruptMode;
     IOPorts* m_pIOPorts;
@@ -114,6 +153,26 @@ private:
     bool m_bInputLastCycle;
     bool m_bBreakpointHit;
     bool m_bRequestMemBreakpoint;
+    bool m_bDebugEnabled;
+    Interpreter m_Interpreter;
+    std::vector<stLockstepRecord>* m_pLockstepTrace;
+
+    enum LazyFlagsOp
+    {
+        LazyFlagsNone,
+        LazyFlagsADD,
+        LazyFlagsSUB,
+        LazyFlagsCP,
+        LazyFlagsAND,
+        LazyFlagsLogic,
+        LazyFlagsINC,
+        LazyFlagsDEC
+    };
+    LazyFlagsOp m_LazyFlagsOp;
+    u8 m_LazyFlagsA;
+    u8 m_LazyFlagsB;
+    u8 m_LazyFlagsCarry;
+    u8 m_LazyFlagsResult;
 
     struct ProActionReplayCode
     {
@@ -127,13 +186,24 @@ private:
 private:
     u8 FetchOPCode();
     u16 FetchArg16();
+    void ExecuteInstruction();
+    template <Interpreter interpreter> void ExecuteInstruction();
+    template <Interpreter interpreter> unsigned int RunInstructions(unsigned int tstates);
     void ExecuteOPCode();
+    void ExecuteOPCodeSwitch();
+    template <u8 prefix> void ExecuteOPCodeSwitch(u8 opcode);
+    void ExecuteOPCodeSwitchCB(u8 opcode);
+    void ExecuteOPCodeSwitchED(u8 opcode);
+    void RecordLockstep();
     void LeaveHalt();
     void ClearAllFlags();
+    void SetLazyFlags(LazyFlagsOp op, u8 a, u8 b, u8 carry, u8 result);
+    void MaterializeFlags();
+    void ResolveLazyFlags();
+    bool IsSetLazyCarry();
     void ToggleZeroFlagFromResult(u16 result);
     void ToggleSignFlagFromResult(u8 result);
     void ToggleXYFlagsFromResult(u8 result);
-    void ToggleParityFlagFromResult(u8 result);
     void SetFlag(u8 flag);
     void FlipFlag(u8 flag);
     void ToggleFlag(u8 flag);
@@ -147,8 +217,11 @@ private:
     void InvalidOPCode();
     void UndocumentedOPCode();
     SixteenBitRegister* GetPrefixedRegister();
+    template <u8 prefix> SixteenBitRegister* GetPrefixedRegister();
     u16 GetEffectiveAddress();
+    template <u8 prefix> u16 GetEffectiveAddress();
     bool IsPrefixedInstruction();
+    template <u8 prefix> bool IsPrefixedInstruction();
     void OPCodes_LD(u8* reg1, u8 value);
     void OPCodes_LD(u8* reg, u16 address);
     void OPCodes_LD(u16 address, u8 reg);
@@ -179,14 +252,14 @@ private:
     void OPCodes_CPI();
     void OPCodes_CPD();
     void OPCodes_INC(u8* reg);
-    void OPCodes_INC_HL();
+    void OPCodes_INC_HL(u16 address);
     void OPCodes_DEC(u8* reg);
-    void OPCodes_DEC_HL();
+    void OPCodes_DEC_HL(u16 address);
     void OPCodes_ADD(u8 number);
     void OPCodes_ADC(u8 number);
     void OPCodes_SUB(u8 number);
     void OPCodes_SBC(u8 number);
-    void OPCodes_ADD_HL(u16 number);
+    void OPCodes_ADD_HL(SixteenBitRegister* reg, u16 number);
     void OPCodes_ADC_HL(u16 number);
     void OPCodes_SBC_HL(u16 number);
     void OPCodes_SLL(u8* reg);
@@ -807,41 +880,6 @@ private:
     void OPCodeED0xBB();
 };
 
-const bool kZ80ParityTable[256] = {
-    true, false, false, true, false, true, true, false,
-    false, true, true, false, true, false, false, true,
-    false, true, true, false, true, false, false, true,
-    true, false, false, true, false, true, true, false,
-    false, true, true, false, true, false, false, true,
-    true, false, false, true, false, true, true, false,
-    true, false, false, true, false, true, true, false,
-    false, true, true, false, true, false, false, true,
-    false, true, true, false, true, false, false, true,
-    true, false, false, true, false, true, true, false,
-    true, false, false, true, false, true, true, false,
-    false, true, true, false, true, false, false, true,
-    true, false, false, true, false, true, true, false,
-    false, true, true, false, true, false, false, true,
-    false, true, true, false, true, false, false, true,
-    true, false, false, true, false, true, true, false,
-    false, true, true, false, true, false, false, true,
-    true, false, false, true, false, true, true, false,
-    true, false, false, true, false, true, true, false,
-    false, true, true, false, true, false, false, true,
-    true, false, false, true, false, true, true, false,
-    false, true, true, false, true, false, false, true,
-    false, true, true, false, true, false, false, true,
-    true, false, false, true, false, true, true, false,
-    true, false, false, true, false, true, true, false,
-    false, true, true, false, true, false, false, true,
-    false, true, true, false, true, false, false, true,
-    true, false, false, true, false, true, true, false,
-    false, true, true, false, true, false, false, true,
-    true, false, false, true, false, true, true, false,
-    true, false, false, true, false, true, true, false,
-    false, true, true, false, true, false, false, true
-};
-
 #include "Processor_inline.h"
 
 #endif	/* PROCESSOR_H */
@@ -25,6 +25,23 @@
 #include "Processor.h"
 #include "IOPorts.h"
 
+inline unsigned int Processor::ConsumePendingTStates()
+{
+    unsigned int tstates = m_iPendingTStates;
+    m_iPendingTStates = 0;
+    return tstates;
+}
+
+inline unsigned int Processor::GetLastInstructionTStates()
+{
+    return m_iLastTStates;
+}
+
+inline void Processor::RequestSync()
+{
+    m_bSyncRequested = true;
+}
+
 inline u8 Processor::FetchOPCode()
 {
     u8 opcode = m_pMemory->Read(PC.GetValue());
@@ -83,39 +100,83 @@ inline void Processor::ToggleXYFlagsFromResult(u8 result)
         ClearFlag(FLAG_Y);
 }
 
-inline void Processor::ToggleParityFlagFromResult(u8 result)
-{
-    if (kZ80ParityTable[result])
-        ToggleFlag(FLAG_PARITY);
-    else
-        ClearFlag(FLAG_PARITY);
-}
-
 inline void Processor::SetFlag(u8 flag)
 {
+    m_LazyFlagsOp = LazyFlagsNone;
     AF.SetLow(flag);
 }
 
 inline void Processor::FlipFlag(u8 flag)
 {
+    MaterializeFlags();
     AF.SetLow(AF.GetLow() ^ flag);
 }
 
 inline void Processor::ToggleFlag(u8 flag)
 {
+    MaterializeFlags();
     AF.SetLow(AF.GetLow() | flag);
 }
 
 inline void Processor::ClearFlag(u8 flag)
 {
+    MaterializeFlags();
     AF.SetLow(AF.GetLow() & (~flag));
 }
 
 inline bool Processor::IsSetFlag(u8 flag)
 {
+    if (m_LazyFlagsOp != LazyFlagsNone)
+    {
+        // Carry, zero and sign are cheap to derive, the rest need the whole F
+        switch (flag)
+        {
+            case FLAG_CARRY:
+                return IsSetLazyCarry();
+            case FLAG_ZERO:
+                return m_LazyFlagsResult == 0;
+            case FLAG_SIGN:
+                return (m_LazyFlagsResult & 0x80) != 0;
+            default:
+                ResolveLazyFlags();
+        }
+    }
+
     return (AF.GetLow() & flag) != 0;
 }
 
+inline void Processor::SetLazyFlags(LazyFlagsOp op, u8 a, u8 b, u8 carry, u8 result)
+{
+    m_LazyFlagsOp = op;
+    m_LazyFlagsA = a;
+    m_LazyFlagsB = b;
+    m_LazyFlagsCarry = carry;
+    m_LazyFlagsResult = result;
+}
+
+inline void Processor::MaterializeFlags()
+{
+    if (m_LazyFlagsOp != LazyFlagsNone)
+        ResolveLazyFlags();
+}
+
+inline bool Processor::IsSetLazyCarry()
+{
+    switch (m_LazyFlagsOp)
+    {
+        case LazyFlagsADD:
+            return (m_LazyFlagsA + m_LazyFlagsB + m_LazyFlagsCarry) > 0xFF;
+        case LazyFlagsSUB:
+        case LazyFlagsCP:
+            return m_LazyFlagsA < (m_LazyFlagsB + m_LazyFlagsCarry);
+        case LazyFlagsINC:
+        case LazyFlagsDEC:
+            return m_LazyFlagsCarry != 0;
+        default:
+            return false;
+    }
+}
+
 inline void Processor::StackPush(SixteenBitRegister* reg)
 {
     SP.Decrement();
@@ -201,6 +262,46 @@ inline bool Processor::IsPrefixedInstruction()
     return (m_CurrentPrefix == 0xDD) || (m_CurrentPrefix == 0xFD);
 }
 
+template <u8 prefix>
+inline SixteenBitRegister* Processor::GetPrefixedRegister()
+{
+    switch (prefix)
+    {
+        case 0xDD:
+            return &IX;
+        case 0xFD:
+            return &IY;
+        default:
+            return &HL;
+    }
+}
+
+template <u8 prefix>
+inline u16 Processor::GetEffectiveAddress()
+{
+    if (!IsPrefixedInstruction<prefix>())
+        return HL.GetValue();
+
+    u16 address = GetPrefixedRegister<prefix>()->GetValue();
+    if (m_bPrefixedCBOpcode)
+    {
+        address += static_cast<s8> (m_PrefixedCBValue);
+    }
+    else
+    {
+        address += static_cast<s8> (m_pMemory->Read(PC.GetValue()));
+        PC.Increment();
+        WZ.SetValue(address);
+    }
+    return address;
+}
+
+template <u8 prefix>
+inline bool Processor::IsPrefixedInstruction()
+{
+    return (prefix == 0xDD) || (prefix == 0xFD);
+}
+
 inline void Processor::IncreaseR()
 {
     u8 r = R;
@@ -379,11 +480,8 @@ inline void Processor::OPCodes_IN_C(u8* reg)
     u8 result = m_pIOPorts->DoInput(BC.GetLow());
     if (IsValidPointer(reg))
         *reg = result;
-    IsSetFlag(FLAG_CARRY) ? SetFlag(FLAG_CARRY) : ClearAllFlags();
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    u8 flags = IsSetFlag(FLAG_CARRY) ? FLAG_CARRY : FLAG_NONE;
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_INI()
@@ -510,50 +608,27 @@ inline void Processor::OPCodes_OR(u8 number)
 {
     u8 result = AF.GetHigh() | number;
     AF.SetHigh(result);
-    ClearAllFlags();
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
-    ToggleParityFlagFromResult(result);
+    SetLazyFlags(LazyFlagsLogic, 0, 0, 0, result);
 }
 
 inline void Processor::OPCodes_XOR(u8 number)
 {
     u8 result = AF.GetHigh() ^ number;
     AF.SetHigh(result);
-    ClearAllFlags();
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
-    ToggleParityFlagFromResult(result);
+    SetLazyFlags(LazyFlagsLogic, 0, 0, 0, result);
 }
 
 inline void Processor::OPCodes_AND(u8 number)
 {
     u8 result = AF.GetHigh() & number;
     AF.SetHigh(result);
-    SetFlag(FLAG_HALF);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
-    ToggleParityFlagFromResult(result);
+    SetLazyFlags(LazyFlagsAND, 0, 0, 0, result);
 }
 
 inline void Processor::OPCodes_CP(u8 number)
 {
-    int result = AF.GetHigh() - number;
-    int carrybits = AF.GetHigh() ^ number ^ result;
-    u8 final_result = static_cast<u8> (result);
-    SetFlag(FLAG_NEGATIVE);
-    ToggleZeroFlagFromResult(final_result);
-    ToggleSignFlagFromResult(final_result);
-    ToggleXYFlagsFromResult(number);
-    if ((carrybits & 0x100) != 0)
-        ToggleFlag(FLAG_CARRY);
-    if ((carrybits & 0x10) != 0)
-        ToggleFlag(FLAG_HALF);
-    if ((((carrybits << 1) ^ carrybits) & 0x100) != 0)
-        ToggleFlag(FLAG_PARITY);
+    u8 a = AF.GetHigh();
+    SetLazyFlags(LazyFlagsCP, a, number, 0, a - number);
 }
 
 inline void Processor::OPCodes_CPI()
@@ -620,139 +695,70 @@ inline void Processor::OPCodes_CPD()
 
 inline void Processor::OPCodes_INC(u8* reg)
 {
+    u8 carry = IsSetFlag(FLAG_CARRY) ? 1 : 0;
     u8 result = *reg + 1;
     *reg = result;
-    IsSetFlag(FLAG_CARRY) ? SetFlag(FLAG_CARRY) : ClearAllFlags();
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
-    if ((result & 0x0F) == 0x00)
-        ToggleFlag(FLAG_HALF);
-    if (result == 0x80)
-        ToggleFlag(FLAG_PARITY);
+    SetLazyFlags(LazyFlagsINC, 0, 0, carry, result);
 }
 
-inline void Processor::OPCodes_INC_HL()
+inline void Processor::OPCodes_INC_HL(u16 address)
 {
-    u16 address = GetEffectiveAddress();
     u8 result = m_pMemory->Read(address) + 1;
     m_pMemory->Write(address, result);
-    IsSetFlag(FLAG_CARRY) ? SetFlag(FLAG_CARRY) : ClearAllFlags();
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
-    if ((result & 0x0F) == 0x00)
-        ToggleFlag(FLAG_HALF);
-    if (result == 0x80)
-        ToggleFlag(FLAG_PARITY);
+    SetLazyFlags(LazyFlagsINC, 0, 0, IsSetFlag(FLAG_CARRY) ? 1 : 0, result);
 }
 
 inline void Processor::OPCodes_DEC(u8* reg)
 {
+    u8 carry = IsSetFlag(FLAG_CARRY) ? 1 : 0;
     u8 result = *reg - 1;
     *reg = result;
-    IsSetFlag(FLAG_CARRY) ? SetFlag(FLAG_CARRY) : ClearAllFlags();
-    ToggleFlag(FLAG_NEGATIVE);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
-    if ((result & 0x0F) == 0x0F)
-        ToggleFlag(FLAG_HALF);
-    if (result == 0x7F)
-        ToggleFlag(FLAG_PARITY);
+    SetLazyFlags(LazyFlagsDEC, 0, 0, carry, result);
 }
 
-inline void Processor::OPCodes_DEC_HL()
+inline void Processor::OPCodes_DEC_HL(u16 address)
 {
-    u16 address = GetEffectiveAddress();
     u8 result = m_pMemory->Read(address) - 1;
     m_pMemory->Write(address, result);
-    IsSetFlag(FLAG_CARRY) ? SetFlag(FLAG_CARRY) : ClearAllFlags();
-    ToggleFlag(FLAG_NEGATIVE);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
-    if ((result & 0x0F) == 0x0F)
-        ToggleFlag(FLAG_HALF);
-    if (result == 0x7F)
-        ToggleFlag(FLAG_PARITY);
+    SetLazyFlags(LazyFlagsDEC, 0, 0, IsSetFlag(FLAG_CARRY) ? 1 : 0, result);
 }
 
 inline void Processor::OPCodes_ADD(u8 number)
 {
-    int result = AF.GetHigh() + number;
-    int carrybits = AF.GetHigh() ^ number ^ result;
-    u8 final_result = static_cast<u8> (result);
-    AF.SetHigh(final_result);
-    ClearAllFlags();
-    ToggleZeroFlagFromResult(final_result);
-    ToggleSignFlagFromResult(final_result);
-    ToggleXYFlagsFromResult(final_result);
-    if ((carrybits & 0x100) != 0)
-        ToggleFlag(FLAG_CARRY);
-    if ((carrybits & 0x10) != 0)
-        ToggleFlag(FLAG_HALF);
-    if ((((carrybits << 1) ^ carrybits) & 0x100) != 0)
-        ToggleFlag(FLAG_PARITY);
+    u8 a = AF.GetHigh();
+    u8 result = a + number;
+    AF.SetHigh(result);
+    SetLazyFlags(LazyFlagsADD, a, number, 0, result);
 }
 
 inline void Processor::OPCodes_ADC(u8 number)
 {
-    int result = AF.GetHigh() + number + (IsSetFlag(FLAG_CARRY) ? 1 : 0);
-    int carrybits = AF.GetHigh() ^ number ^ result;
-    u8 final_result = static_cast<u8> (result);
-    AF.SetHigh(final_result);
-    ClearAllFlags();
-    ToggleZeroFlagFromResult(final_result);
-    ToggleSignFlagFromResult(final_result);
-    ToggleXYFlagsFromResult(final_result);
-    if ((carrybits & 0x100) != 0)
-        ToggleFlag(FLAG_CARRY);
-    if ((carrybits & 0x10) != 0)
-        ToggleFlag(FLAG_HALF);
-    if ((((carrybits << 1) ^ carrybits) & 0x100) != 0)
-        ToggleFlag(FLAG_PARITY);
+    u8 a = AF.GetHigh();
+    u8 carry = IsSetFlag(FLAG_CARRY) ? 1 : 0;
+    u8 result = a + number + carry;
+    AF.SetHigh(result);
+    SetLazyFlags(LazyFlagsADD, a, number, carry, result);
 }
 
 inline void Processor::OPCodes_SUB(u8 number)
 {
-    int result = AF.GetHigh() - number;
-    int carrybits = AF.GetHigh() ^ number ^ result;
-    u8 final_result = static_cast<u8> (result);
-    AF.SetHigh(final_result);
-    SetFlag(FLAG_NEGATIVE);
-    ToggleZeroFlagFromResult(final_result);
-    ToggleSignFlagFromResult(final_result);
-    ToggleXYFlagsFromResult(final_result);
-    if ((carrybits & 0x100) != 0)
-        ToggleFlag(FLAG_CARRY);
-    if ((carrybits & 0x10) != 0)
-        ToggleFlag(FLAG_HALF);
-    if ((((carrybits << 1) ^ carrybits) & 0x100) != 0)
-        ToggleFlag(FLAG_PARITY);
+    u8 a = AF.GetHigh();
+    u8 result = a - number;
+    AF.SetHigh(result);
+    SetLazyFlags(LazyFlagsSUB, a, number, 0, result);
 }
 
 inline void Processor::OPCodes_SBC(u8 number)
 {
-    int result = AF.GetHigh() - number - (IsSetFlag(FLAG_CARRY) ? 1 : 0);
-    int carrybits = AF.GetHigh() ^ number ^ result;
-    u8 final_result = static_cast<u8> (result);
-    AF.SetHigh(final_result);
-    SetFlag(FLAG_NEGATIVE);
-    ToggleZeroFlagFromResult(final_result);
-    ToggleSignFlagFromResult(final_result);
-    ToggleXYFlagsFromResult(final_result);
-    if ((carrybits & 0x100) != 0)
-        ToggleFlag(FLAG_CARRY);
-    if ((carrybits & 0x10) != 0)
-        ToggleFlag(FLAG_HALF);
-    if ((((carrybits << 1) ^ carrybits) & 0x100) != 0)
-        ToggleFlag(FLAG_PARITY);
+    u8 a = AF.GetHigh();
+    u8 carry = IsSetFlag(FLAG_CARRY) ? 1 : 0;
+    u8 result = a - number - carry;
+    AF.SetHigh(result);
+    SetLazyFlags(LazyFlagsSUB, a, number, carry, result);
 }
 
-inline void Processor::OPCodes_ADD_HL(u16 number)
+inline void Processor::OPCodes_ADD_HL(SixteenBitRegister* reg, u16 number)
 {
-    SixteenBitRegister* reg = GetPrefixedRegister();
     WZ.SetValue(reg->GetValue() + 1);
     int result = reg->GetValue() + number;
     int carrybits = reg->GetValue() ^ number ^ result;
@@ -815,28 +821,22 @@ inline void Processor::OPCodes_SLL(u8* reg)
         address = GetEffectiveAddress();
         *reg = m_pMemory->Read(address);
     }
-    (*reg & 0x80) != 0 ? SetFlag(FLAG_CARRY) : ClearAllFlags();
+    u8 flags = ((*reg & 0x80) != 0) ? FLAG_CARRY : FLAG_NONE;
     u8 result = (*reg << 1) | 0x01;
     *reg = result;
     if (IsPrefixedInstruction())
         m_pMemory->Write(address, *reg);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_SLL_HL()
 {
     u16 address = GetEffectiveAddress();
     u8 result = m_pMemory->Read(address);
-    (result & 0x80) != 0 ? SetFlag(FLAG_CARRY) : ClearAllFlags();
+    u8 flags = ((result & 0x80) != 0) ? FLAG_CARRY : FLAG_NONE;
     result = (result << 1) | 0x01;
     m_pMemory->Write(address, result);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_SLA(u8* reg)
@@ -847,28 +847,22 @@ inline void Processor::OPCodes_SLA(u8* reg)
         address = GetEffectiveAddress();
         *reg = m_pMemory->Read(address);
     }
-    (*reg & 0x80) != 0 ? SetFlag(FLAG_CARRY) : ClearAllFlags();
+    u8 flags = ((*reg & 0x80) != 0) ? FLAG_CARRY : FLAG_NONE;
     u8 result = *reg << 1;
     *reg = result;
     if (IsPrefixedInstruction())
         m_pMemory->Write(address, *reg);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_SLA_HL()
 {
     u16 address = GetEffectiveAddress();
     u8 result = m_pMemory->Read(address);
-    (result & 0x80) != 0 ? SetFlag(FLAG_CARRY) : ClearAllFlags();
+    u8 flags = ((result & 0x80) != 0) ? FLAG_CARRY : FLAG_NONE;
     result <<= 1;
     m_pMemory->Write(address, result);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_SRA(u8* reg)
@@ -880,7 +874,7 @@ inline void Processor::OPCodes_SRA(u8* reg)
         *reg = m_pMemory->Read(address);
     }
     u8 result = *reg;
-    (result & 0x01) != 0 ? SetFlag(FLAG_CARRY) : ClearAllFlags();
+    u8 flags = ((result & 0x01) != 0) ? FLAG_CARRY : FLAG_NONE;
     if ((result & 0x80) != 0)
     {
         result >>= 1;
@@ -891,17 +885,14 @@ inline void Processor::OPCodes_SRA(u8* reg)
     *reg = result;
     if (IsPrefixedInstruction())
         m_pMemory->Write(address, *reg);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_SRA_HL()
 {
     u16 address = GetEffectiveAddress();
     u8 result = m_pMemory->Read(address);
-    (result & 0x01) != 0 ? SetFlag(FLAG_CARRY) : ClearAllFlags();
+    u8 flags = ((result & 0x01) != 0) ? FLAG_CARRY : FLAG_NONE;
     if ((result & 0x80) != 0)
     {
         result >>= 1;
@@ -910,10 +901,7 @@ inline void Processor::OPCodes_SRA_HL()
     else
         result >>= 1;
     m_pMemory->Write(address, result);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_SRL(u8* reg)
@@ -925,28 +913,22 @@ inline void Processor::OPCodes_SRL(u8* reg)
         *reg = m_pMemory->Read(address);
     }
     u8 result = *reg;
-    (result & 0x01) != 0 ? SetFlag(FLAG_CARRY) : ClearAllFlags();
+    u8 flags = ((result & 0x01) != 0) ? FLAG_CARRY : FLAG_NONE;
     result >>= 1;
     *reg = result;
     if (IsPrefixedInstruction())
         m_pMemory->Write(address, *reg);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_SRL_HL()
 {
     u16 address = GetEffectiveAddress();
     u8 result = m_pMemory->Read(address);
-    (result & 0x01) != 0 ? SetFlag(FLAG_CARRY) : ClearAllFlags();
+    u8 flags = ((result & 0x01) != 0) ? FLAG_CARRY : FLAG_NONE;
     result >>= 1;
     m_pMemory->Write(address, result);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_RLC(u8* reg, bool isRegisterA)
@@ -958,51 +940,43 @@ inline void Processor::OPCodes_RLC(u8* reg, bool isRegisterA)
         *reg = m_pMemory->Read(address);
     }
     u8 result = *reg;
+    u8 flags = FLAG_NONE;
     if ((result & 0x80) != 0)
     {
-        ToggleFlag(FLAG_CARRY);
+        flags = FLAG_CARRY;
         result <<= 1;
         result |= 0x1;
     }
     else
-    {
-        ClearFlag(FLAG_CARRY);
         result <<= 1;
-    }
     *reg = result;
     if (!isRegisterA && IsPrefixedInstruction())
         m_pMemory->Write(address, *reg);
-    ClearFlag(FLAG_HALF);
-    ClearFlag(FLAG_NEGATIVE);
-    ToggleXYFlagsFromResult(result);
-    if (!isRegisterA)
+    if (isRegisterA)
     {
-        ToggleZeroFlagFromResult(result);
-        ToggleSignFlagFromResult(result);
-        ToggleParityFlagFromResult(result);
+        MaterializeFlags();
+        u8 kept = AF.GetLow() & (FLAG_SIGN | FLAG_ZERO | FLAG_PARITY);
+        SetFlag(kept | flags | (kOPCodeSZXYTable[result] & (FLAG_X | FLAG_Y)));
     }
+    else
+        SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_RLC_HL()
 {
     u16 address = GetEffectiveAddress();
     u8 result = m_pMemory->Read(address);
+    u8 flags = FLAG_NONE;
     if ((result & 0x80) != 0)
     {
-        SetFlag(FLAG_CARRY);
+        flags = FLAG_CARRY;
         result <<= 1;
         result |= 0x1;
     }
     else
-    {
-        ClearAllFlags();
         result <<= 1;
-    }
     m_pMemory->Write(address, result);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_RL(u8* reg, bool isRegisterA)
@@ -1015,21 +989,20 @@ inline void Processor::OPCodes_RL(u8* reg, bool isRegisterA)
     }
     u8 carry = IsSetFlag(FLAG_CARRY) ? 1 : 0;
     u8 result = *reg;
-    ((result & 0x80) != 0) ? ToggleFlag(FLAG_CARRY) : ClearFlag(FLAG_CARRY);
+    u8 flags = ((result & 0x80) != 0) ? FLAG_CARRY : FLAG_NONE;
     result <<= 1;
     result |= carry;
     *reg = result;
     if (!isRegisterA && IsPrefixedInstruction())
         m_pMemory->Write(address, *reg);
-    ClearFlag(FLAG_HALF);
-    ClearFlag(FLAG_NEGATIVE);
-    ToggleXYFlagsFromResult(result);
-    if (!isRegisterA)
+    if (isRegisterA)
     {
-        ToggleZeroFlagFromResult(result);
-        ToggleSignFlagFromResult(result);
-        ToggleParityFlagFromResult(result);
+        MaterializeFlags();
+        u8 kept = AF.GetLow() & (FLAG_SIGN | FLAG_ZERO | FLAG_PARITY);
+        SetFlag(kept | flags | (kOPCodeSZXYTable[result] & (FLAG_X | FLAG_Y)));
     }
+    else
+        SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_RL_HL()
@@ -1037,14 +1010,11 @@ inline void Processor::OPCodes_RL_HL()
     u16 address = GetEffectiveAddress();
     u8 carry = IsSetFlag(FLAG_CARRY) ? 1 : 0;
     u8 result = m_pMemory->Read(address);
-    ((result & 0x80) != 0) ? SetFlag(FLAG_CARRY) : ClearAllFlags();
+    u8 flags = ((result & 0x80) != 0) ? FLAG_CARRY : FLAG_NONE;
     result <<= 1;
     result |= carry;
     m_pMemory->Write(address, result);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_RRC(u8* reg, bool isRegisterA)
@@ -1056,51 +1026,43 @@ inline void Processor::OPCodes_RRC(u8* reg, bool isRegisterA)
         *reg = m_pMemory->Read(address);
     }
     u8 result = *reg;
+    u8 flags = FLAG_NONE;
     if ((result & 0x01) != 0)
     {
-        ToggleFlag(FLAG_CARRY);
+        flags = FLAG_CARRY;
         result >>= 1;
         result |= 0x80;
     }
     else
-    {
-        ClearFlag(FLAG_CARRY);
         result >>= 1;
-    }
     *reg = result;
     if (!isRegisterA && IsPrefixedInstruction())
         m_pMemory->Write(address, *reg);
-    ClearFlag(FLAG_HALF);
-    ClearFlag(FLAG_NEGATIVE);
-    ToggleXYFlagsFromResult(result);
-    if (!isRegisterA)
+    if (isRegisterA)
     {
-        ToggleZeroFlagFromResult(result);
-        ToggleSignFlagFromResult(result);
-        ToggleParityFlagFromResult(result);
+        MaterializeFlags();
+        u8 kept = AF.GetLow() & (FLAG_SIGN | FLAG_ZERO | FLAG_PARITY);
+        SetFlag(kept | flags | (kOPCodeSZXYTable[result] & (FLAG_X | FLAG_Y)));
     }
+    else
+        SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_RRC_HL()
 {
     u16 address = GetEffectiveAddress();
     u8 result = m_pMemory->Read(address);
+    u8 flags = FLAG_NONE;
     if ((result & 0x01) != 0)
     {
-        SetFlag(FLAG_CARRY);
+        flags = FLAG_CARRY;
         result >>= 1;
         result |= 0x80;
     }
     else
-    {
-        ClearAllFlags();
         result >>= 1;
-    }
     m_pMemory->Write(address, result);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_RR(u8* reg, bool isRegisterA)
@@ -1113,21 +1075,20 @@ inline void Processor::OPCodes_RR(u8* reg, bool isRegisterA)
     }
     u8 carry = IsSetFlag(FLAG_CARRY) ? 0x80 : 0x00;
     u8 result = *reg;
-    ((result & 0x01) != 0) ? ToggleFlag(FLAG_CARRY) : ClearFlag(FLAG_CARRY);
+    u8 flags = ((result & 0x01) != 0) ? FLAG_CARRY : FLAG_NONE;
     result >>= 1;
     result |= carry;
     *reg = result;
     if (!isRegisterA && IsPrefixedInstruction())
         m_pMemory->Write(address, *reg);
-    ClearFlag(FLAG_HALF);
-    ClearFlag(FLAG_NEGATIVE);
-    ToggleXYFlagsFromResult(result);
-    if (!isRegisterA)
+    if (isRegisterA)
     {
-        ToggleZeroFlagFromResult(result);
-        ToggleSignFlagFromResult(result);
-        ToggleParityFlagFromResult(result);
+        MaterializeFlags();
+        u8 kept = AF.GetLow() & (FLAG_SIGN | FLAG_ZERO | FLAG_PARITY);
+        SetFlag(kept | flags | (kOPCodeSZXYTable[result] & (FLAG_X | FLAG_Y)));
     }
+    else
+        SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_RR_HL()
@@ -1135,14 +1096,11 @@ inline void Processor::OPCodes_RR_HL()
     u16 address = GetEffectiveAddress();
     u8 carry = IsSetFlag(FLAG_CARRY) ? 0x80 : 0x00;
     u8 result = m_pMemory->Read(address);
-    ((result & 0x01) != 0) ? SetFlag(FLAG_CARRY) : ClearAllFlags();
+    u8 flags = ((result & 0x01) != 0) ? FLAG_CARRY : FLAG_NONE;
     result >>= 1;
     result |= carry;
     m_pMemory->Write(address, result);
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
 }
 
 inline void Processor::OPCodes_BIT(u8* reg, int bit)
@@ -0,0 +1,304 @@
+/*
+ * Gearsystem - Sega Master System / Game Gear Emulator
+ * Copyright (C) 2013  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#include "Rewind.h"
+#include "GearsystemCore.h"
+#include "miniz/miniz.h"
+
+Rewind::Rewind(GearsystemCore* pCore)
+{
+    m_pCore = pCore;
+    InitPointer(m_pCompressor);
+    m_iCompressionFlags = 0;
+    InitPointer(m_pBuffer);
+    m_iBufferSize = 0;
+    m_iHead = 0;
+    m_iUsed = 0;
+    InitPointer(m_pState);
+    InitPointer(m_pScratch);
+    InitPointer(m_pCompressed);
+    m_iCapacity = 0;
+    m_iCompressedCapacity = 0;
+    m_iStateSize = 0;
+    m_bHasState = false;
+    m_iFrequency = 1;
+    m_iFrameCounter = 0;
+}
+
+Rewind::~Rewind()
+{
+    if (IsValidPointer(m_pCompressor))
+        tdefl_compressor_free(static_cast<tdefl_compressor*>(m_pCompressor));
+    SafeDeleteArray(m_pBuffer);
+    SafeDeleteArray(m_pState);
+    SafeDeleteArray(m_pScratch);
+    SafeDeleteArray(m_pCompressed);
+}
+
+void Rewind::Init()
+{
+    // Deltas are mostly zeros, the fastest level already shrinks them a lot
+    m_pCompressor = tdefl_compressor_alloc();
+    m_iCompressionFlags = tdefl_create_comp_flags_from_zip_params(MZ_BEST_SPEED, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY);
+    Reset();
+}
+
+void Rewind::Reset()
+{
+    DropSnapshots();
+    m_iStateSize = 0;
+    m_bHasState = false;
+    m_iFrameCounter = 0;
+}
+
+// A size of zero disables rewinding and frees the buffer
+void Rewind::SetBufferSize(size_t size)
+{
+    if (size == m_iBufferSize)
+        return;
+
+    SafeDeleteArray(m_pBuffer);
+    m_iBufferSize = size;
+
+    if (size > 0)
+        m_pBuffer = new u8[size];
+
+    Reset();
+}
+
+size_t Rewind::GetBufferSize()
+{
+    return m_iBufferSize;
+}
+
+void Rewind::SetFrequency(int frames)
+{
+    m_iFrequency = (frames < 1) ? 1 : frames;
+    m_iFrameCounter = 0;
+}
+
+int Rewind::GetFrequency()
+{
+    return m_iFrequency;
+}
+
+// Call once per emulated frame. Every m_iFrequency frames the state is
+// saved, the previous one is stored as a compressed delta against it and
+// the new one is kept uncompressed for the next capture or step back.
+bool Rewind::Capture()
+{
+    if ((m_iBufferSize == 0) || !IsValidPointer(m_pCompressor))
+        return false;
+
+    if (++m_iFrameCounter < m_iFrequency)
+        return false;
+
+    m_iFrameCounter = 0;
+
+    size_t size = m_pCore->GetStateSize();
+
+    if (size == 0)
+        return false;
+
+    EnsureCapacity(size);
+
+    if (!m_pCore->SaveState(m_pScratch, size))
+        return false;
+
+    if (m_bHasState)
+    {
+        bool delta = (size == m_iStateSize);
+
+        if (delta)
+        {
+            for (size_t i = 0; i < size; i++)
+                m_pState[i] ^= m_pScratch[i];
+        }
+
+        if (!Store(m_pState, m_iStateSize, delta))
+            DropSnapshots();
+    }
+
+    u8* state = m_pState;
+    m_pState = m_pScratch;
+    m_pScratch = state;
+    m_iStateSize = size;
+    m_bHasState = true;
+
+    return true;
+}
+
+// Restores the newest state and makes the one before it the next to be
+// restored. The oldest state stays put, so stepping back never runs dry.
+bool Rewind::StepBack()
+{
+    if (!m_bHasState)
+        return false;
+
+    if (!m_pCore->LoadState(m_pState, m_iStateSize))
+        return false;
+
+    m_iFrameCounter = 0;
+
+    if (m_Snapshots.empty())
+        return true;
+
+    stSnapshot snapshot = m_Snapshots.back();
+    m_Snapshots.pop_back();
+    m_iHead = snapshot.offset;
+    m_iUsed -= snapshot.compressed_size;
+
+    size_t size = tinfl_decompress_mem_to_mem(m_pScratch, snapshot.state_size, m_pBuffer + snapshot.offset, snapshot.compressed_size, 0);
+
+    if (size != snapshot.state_size)
+    {
+        Log("Rewind: unable to decompress snapshot");
+        DropSnapshots();
+        return true;
+    }
+
+    if (snapshot.delta)
+    {
+        for (size_t i = 0; i < size; i++)
+            m_pState[i] ^= m_pScratch[i];
+    }
+    else
+    {
+        u8* state = m_pState;
+        m_pState = m_pScratch;
+        m_pScratch = state;
+        m_iStateSize = size;
+    }
+
+    return true;
+}
+
+int Rewind::GetSnapshotCount()
+{
+    return m_bHasState ? static_cast<int>(m_Snapshots.size()) + 1 : 0;
+}
+
+size_t Rewind::GetMemoryUsage()
+{
+    return m_iUsed;
+}
+
+void Rewind::DropSnapshots()
+{
+    m_Snapshots.clear();
+    m_iHead = 0;
+    m_iUsed = 0;
+}
+
+void Rewind::EnsureCapacity(size_t size)
+{
+    if (size <= m_iCapacity)
+        return;
+
+    // Keep the newest state, the buffers grow while it is in use
+    u8* state = new u8[size];
+    if (m_bHasState)
+        memcpy(state, m_pState, m_iStateSize);
+
+    SafeDeleteArray(m_pState);
+    SafeDeleteArray(m_pScratch);
+    SafeDeleteArray(m_pCompressed);
+
+    m_pState = state;
+    m_pScratch = new u8[size];
+    m_iCapacity = size;
+    m_iCompressedCapacity = static_cast<size_t>(mz_compressBound(static_cast<mz_ulong>(size)));
+    m_pCompressed = new u8[m_iCompressedCapacity];
+}
+
+bool Rewind::Store(const u8* data, size_t size, bool delta)
+{
+    tdefl_compressor* compressor = static_cast<tdefl_compressor*>(m_pCompressor);
+
+    size_t in_size = size;
+    size_t out_size = m_iCompressedCapacity;
+
+    if (tdefl_init(compressor, NULL, NULL, m_iCompressionFlags) != TDEFL_STATUS_OKAY)
+        return false;
+
+    if (tdefl_compress(compressor, data, &in_size, m_pCompressed, &out_size, TDEFL_FINISH) != TDEFL_STATUS_DONE)
+        return false;
+
+    size_t offset = 0;
+
+    if (!Allocate(out_size, offset))
+        return false;
+
+    memcpy(m_pBuffer + offset, m_pCompressed, out_size);
+
+    stSnapshot snapshot;
+    snapshot.offset = offset;
+    snapshot.compressed_size = out_size;
+    snapshot.state_size = size;
+    snapshot.delta = delta;
+
+    m_Snapshots.push_back(snapshot);
+    m_iHead = offset + out_size;
+    m_iUsed += out_size;
+
+    return true;
+}
+
+// Finds room for a new snapshot in the ring, dropping the oldest ones as
+// needed. Snapshots never wrap, a block that does not fit before the end of
+// the buffer starts again at offset zero.
+bool Rewind::Allocate(size_t size, size_t& offset)
+{
+    if (size > m_iBufferSize)
+        return false;
+
+    for (;;)
+    {
+        if (m_Snapshots.empty())
+        {
+            m_iHead = 0;
+            offset = 0;
+            return true;
+        }
+
+        size_t tail = m_Snapshots.front().offset;
+
+        if (m_iHead > tail)
+        {
+            if ((m_iHead + size) <= m_iBufferSize)
+            {
+                offset = m_iHead;
+                return true;
+            }
+            if (size <= tail)
+            {
+                offset = 0;
+                return true;
+            }
+        }
+        else if ((m_iHead < tail) && ((m_iHead + size) <= tail))
+        {
+            offset = m_iHead;
+            return true;
+        }
+
+        m_iUsed -= m_Snapshots.front().compressed_size;
+        m_Snapshots.pop_front();
+    }
+}
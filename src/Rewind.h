@@ -0,0 +1,82 @@
+/*
+ * Gearsystem - Sega Master System / Game Gear Emulator
+ * Copyright (C) 2013  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#ifndef REWIND_H
+#define	REWIND_H
+
+#include <deque>
+#include "definitions.h"
+
+class GearsystemCore;
+
+class Rewind
+{
+public:
+    Rewind(GearsystemCore* pCore);
+    ~Rewind();
+    void Init();
+    void Reset();
+    void SetBufferSize(size_t size);
+    size_t GetBufferSize();
+    void SetFrequency(int frames);
+    int GetFrequency();
+    bool Capture();
+    bool StepBack();
+    int GetSnapshotCount();
+    size_t GetMemoryUsage();
+
+private:
+    // Compressed data needed to go from a state to the one captured right
+    // before it: an XOR delta when both have the same size, or the older
+    // state itself otherwise
+    struct stSnapshot
+    {
+        size_t offset;
+        size_t compressed_size;
+        size_t state_size;
+        bool delta;
+    };
+
+private:
+    void DropSnapshots();
+    void EnsureCapacity(size_t size);
+    bool Store(const u8* data, size_t size, bool delta);
+    bool Allocate(size_t size, size_t& offset);
+
+private:
+    GearsystemCore* m_pCore;
+    void* m_pCompressor;
+    int m_iCompressionFlags;
+    u8* m_pBuffer;
+    size_t m_iBufferSize;
+    size_t m_iHead;
+    size_t m_iUsed;
+    std::deque<stSnapshot> m_Snapshots;
+    u8* m_pState;
+    u8* m_pScratch;
+    u8* m_pCompressed;
+    size_t m_iCapacity;
+    size_t m_iCompressedCapacity;
+    size_t m_iStateSize;
+    bool m_bHasState;
+    int m_iFrequency;
+    int m_iFrameCounter;
+};
+
+#endif	/* REWIND_H */
@@ -58,6 +58,12 @@ void RomOnlyMemoryRule::PerformWrite(u16 address, u8 value)
 
 void RomOnlyMemoryRule::Reset()
 {
+    m_pMemory->UpdatePageTable();
+}
+
+void RomOnlyMemoryRule::MapPages()
+{
+    m_pMemory->MapReadPages(0x0000, 0x10000, m_pMemory->GetMemoryMap());
 }
 
 u8* RomOnlyMemoryRule::GetPage(int index)
@@ -30,6 +30,7 @@ public:
     virtual u8 PerformRead(u16 address);
     virtual void PerformWrite(u16 address, u8 value);
     virtual void Reset();
+    virtual void MapPages();
     virtual u8* GetPage(int index);
     virtual int GetBank(int index);
 };
@@ -0,0 +1,216 @@
+/*
+ * Gearsystem - Sega Master System / Game Gear Emulator
+ * Copyright (C) 2013  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#include "RunAhead.h"
+#include "GearsystemCore.h"
+#include "Audio.h"
+#include "Processor.h"
+#include "Video.h"
+
+RunAhead::RunAhead(GearsystemCore* pCore)
+{
+    m_pCore = pCore;
+    InitPointer(m_pSecondCore);
+    m_bSecondInstance = false;
+    m_bSecondInstanceReady = false;
+    m_iFrames = 0;
+    InitPointer(m_pState);
+    m_iStateCapacity = 0;
+    m_iStateSize = 0;
+}
+
+RunAhead::~RunAhead()
+{
+    SafeDelete(m_pSecondCore);
+    SafeDeleteArray(m_pState);
+}
+
+// Called when the main core loads or resets a game or its cheats change, the
+// second instance has to pick up the new cartridge before it can be used again
+void RunAhead::Reset()
+{
+    m_bSecondInstanceReady = false;
+}
+
+// Number of frames to run ahead of the displayed one, zero disables it
+void RunAhead::SetFrames(int frames)
+{
+    m_iFrames = (frames < 0) ? 0 : frames;
+}
+
+int RunAhead::GetFrames()
+{
+    return m_iFrames;
+}
+
+void RunAhead::EnableSecondInstance(bool enable)
+{
+    if (enable == m_bSecondInstance)
+        return;
+
+    m_bSecondInstance = enable;
+    m_bSecondInstanceReady = false;
+
+    if (!enable)
+        SafeDelete(m_pSecondCore);
+}
+
+bool RunAhead::IsSecondInstanceEnabled()
+{
+    return m_bSecondInstance;
+}
+
+// Runs the frame that counts, keeping its audio, and then shows the
+// picture the game would have produced m_iFrames later with the same input.
+// Runs a plain frame instead whenever states are not available, like while
+// the BIOS is running, or when the caller does not want the picture at all.
+// Only the last speculative frame is rendered and none of them is heard.
+bool RunAhead::RunToVBlank(u8* pFrameBuffer, s16* pSampleBuffer, int* pSampleCount, int flags)
+{
+    if ((m_iFrames == 0) || (flags & GS_RUN_SKIP_RENDER) || m_pCore->IsPaused() || !PrepareState())
+        return m_pCore->RunToVBlank(pFrameBuffer, pSampleBuffer, pSampleCount, false, false, flags);
+
+    m_pCore->RunToVBlank(NULL, pSampleBuffer, pSampleCount, false, false, flags | GS_RUN_SKIP_RENDER);
+
+    m_iStateSize = m_iStateCapacity;
+
+    if (!m_pCore->SaveState(m_pState, m_iStateSize))
+        return false;
+
+    if (m_bSecondInstance && PrepareSecondInstance())
+        RunSecondInstance(pFrameBuffer);
+    else
+        RunSingleInstance(pFrameBuffer);
+
+    return false;
+}
+
+bool RunAhead::PrepareState()
+{
+    size_t size = m_pCore->GetStateSize();
+
+    if (size == 0)
+        return false;
+
+    if (size > m_iStateCapacity)
+    {
+        SafeDeleteArray(m_pState);
+        m_pState = new u8[size];
+        m_iStateCapacity = size;
+    }
+
+    return true;
+}
+
+// Runs the speculative frames on the main core and rolls it back. The PSG
+// is frozen meanwhile, it is not in the state and must not hear the writes.
+void RunAhead::RunSingleInstance(u8* pFrameBuffer)
+{
+    Audio* audio = m_pCore->GetAudio();
+    audio->Freeze(true);
+
+    for (int i = 1; i <= m_iFrames; i++)
+        m_pCore->RunToVBlank(pFrameBuffer, NULL, NULL, false, false, SpeculativeFlags(i));
+
+    m_pCore->LoadState(m_pState, m_iStateSize);
+
+    audio->Freeze(false);
+}
+
+// Copies the main core into the second one and runs it ahead instead, so
+// the main core never rolls back and its audio stays untouched
+void RunAhead::RunSecondInstance(u8* pFrameBuffer)
+{
+    if (!m_pSecondCore->LoadState(m_pState, m_iStateSize))
+    {
+        m_bSecondInstanceReady = false;
+        RunSingleInstance(pFrameBuffer);
+        return;
+    }
+
+    SyncSecondInstance();
+
+    // Clean-line skipping trusts the frame buffer to hold what the core
+    // converted last. The main core may have drawn into it since, here or
+    // straight through GearsystemCore::RunToVBlank, so the second one starts
+    // over. Then the main core has to do the same the next time it draws.
+    if (m_pCore->GetVideo()->HasRenderTarget())
+        m_pSecondCore->GetVideo()->InvalidateRenderTarget();
+
+    for (int i = 1; i <= m_iFrames; i++)
+        m_pSecondCore->RunToVBlank(pFrameBuffer, NULL, NULL, false, false, SpeculativeFlags(i));
+
+    m_pCore->GetVideo()->InvalidateRenderTarget();
+}
+
+int RunAhead::SpeculativeFlags(int frame)
+{
+    int flags = GS_RUN_SKIP_AUDIO;
+
+    if (frame < m_iFrames)
+        flags |= GS_RUN_SKIP_RENDER;
+
+    return flags;
+}
+
+bool RunAhead::PrepareSecondInstance()
+{
+    if (m_bSecondInstanceReady)
+        return true;
+
+    Cartridge* cartridge = m_pCore->GetCartridge();
+
+    if (!IsValidPointer(m_pSecondCore))
+    {
+        m_pSecondCore = new GearsystemCore();
+        m_pSecondCore->Init(m_pCore->GetPixelFormat());
+    }
+
+    Cartridge::ForceConfiguration config;
+    config.type = cartridge->GetType();
+    config.zone = cartridge->GetZone();
+    config.region = cartridge->IsPAL() ? Cartridge::CartridgePAL : Cartridge::CartridgeNTSC;
+    config.system = cartridge->IsSG1000() ? Cartridge::CartridgeSG1000 : (cartridge->IsGameGear() ? Cartridge::CartridgeGG : Cartridge::CartridgeSMS);
+
+    // The ROM is copied as it is, Game Genie patches included
+    if (!m_pSecondCore->LoadROMFromBuffer(cartridge->GetROM(), cartridge->GetROMSize(), &config))
+    {
+        Log("Run-ahead: unable to load the ROM in the second instance");
+        return false;
+    }
+
+    // Pro Action Replay codes are not part of the state, they are copied too
+    m_pSecondCore->GetProcessor()->CopyProActionReplayCheats(m_pCore->GetProcessor());
+    m_pSecondCore->GetAudio()->Freeze(true);
+    SyncSecondInstance();
+
+    m_bSecondInstanceReady = true;
+
+    return true;
+}
+
+// Frontend settings are not part of the state either. They can change at
+// any time, so they are copied again before every run of the second core.
+void RunAhead::SyncSecondInstance()
+{
+    m_pSecondCore->SetGlassesConfig(m_pCore->GetGlassesConfig());
+    m_pSecondCore->EnableCleanLineSkipping(m_pCore->IsCleanLineSkippingEnabled());
+    m_pSecondCore->GetVideo()->SetOverscan(m_pCore->GetVideo()->GetOverscan());
+    m_pSecondCore->GetAudio()->DisableYM2413(m_pCore->GetAudio()->IsYM2413Disabled());
+}
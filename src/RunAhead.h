@@ -0,0 +1,58 @@
+/*
+ * Gearsystem - Sega Master System / Game Gear Emulator
+ * Copyright (C) 2013  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#ifndef RUNAHEAD_H
+#define	RUNAHEAD_H
+
+#include "definitions.h"
+
+class GearsystemCore;
+
+class RunAhead
+{
+public:
+    RunAhead(GearsystemCore* pCore);
+    ~RunAhead();
+    void Reset();
+    void SetFrames(int frames);
+    int GetFrames();
+    void EnableSecondInstance(bool enable);
+    bool IsSecondInstanceEnabled();
+    bool RunToVBlank(u8* pFrameBuffer, s16* pSampleBuffer, int* pSampleCount, int flags = GS_RUN_DEFAULT);
+
+private:
+    bool PrepareState();
+    void RunSingleInstance(u8* pFrameBuffer);
+    void RunSecondInstance(u8* pFrameBuffer);
+    bool PrepareSecondInstance();
+    void SyncSecondInstance();
+    int SpeculativeFlags(int frame);
+
+private:
+    GearsystemCore* m_pCore;
+    GearsystemCore* m_pSecondCore;
+    bool m_bSecondInstance;
+    bool m_bSecondInstanceReady;
+    int m_iFrames;
+    u8* m_pState;
+    size_t m_iStateCapacity;
+    size_t m_iStateSize;
+};
+
+#endif	/* RUNAHEAD_H */
@@ -66,6 +66,24 @@ void SG1000MemoryRule::PerformWrite(u16 address, u8 value)
 
 void SG1000MemoryRule::Reset()
 {
+    m_pMemory->UpdatePageTable();
+}
+
+void SG1000MemoryRule::MapPages()
+{
+    u8* pMap = m_pMemory->GetMemoryMap();
+
+    m_pMemory->MapReadPages(0x0000, 0x4000, pMap);
+
+    if (m_pCartridge->HasRAMWithoutBattery())
+        m_pMemory->MapReadPages(0x4000, 0x4000, pMap + 0x4000);
+    else
+        m_pMemory->MapReadPages(0x4000, 0x4000, pMap);
+
+    m_pMemory->MapReadPages(0x8000, 0x8000, pMap + 0x8000);
+
+    m_pMemory->MapWritePages(0x3000, 0x1000, pMap + 0x3000);
+    m_pMemory->MapWritePages(0x8000, 0x8000, pMap + 0x8000);
 }
 
 u8* SG1000MemoryRule::GetPage(int index)
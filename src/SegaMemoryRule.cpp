@@ -25,6 +25,8 @@
 SegaMemoryRule::SegaMemoryRule(Memory* pMemory, Cartridge* pCartridge, Input* pInput) : MemoryRule(pMemory, pCartridge, pInput)
 {
     m_pRAMBanks = new u8[0x8000];
+    for (int i = 0; i < 0x8000; i++)
+        m_pRAMBanks[i] = 0;
     Reset();
 }
 
@@ -146,6 +148,9 @@ void SegaMemoryRule::PerformWrite(u16 address, u8 value)
 
     if (m_iPersistRAM < 0)
         m_iPersistRAM = 0;
+
+    if (address >= 0xFFFC)
+        m_pMemory->UpdatePageTable();
 }
 
 void SegaMemoryRule::Reset()
@@ -159,6 +164,38 @@ void SegaMemoryRule::Reset()
         m_iMapperSlot[i] = i;
         m_iMapperSlotAddress[i] = i * 0x4000;
     }
+    m_pMemory->UpdatePageTable();
+}
+
+void SegaMemoryRule::MapPages()
+{
+    u8* pROM = m_pCartridge->GetROM();
+    u8* pMap = m_pMemory->GetMemoryMap();
+
+    if (!IsValidPointer(pROM))
+        return;
+
+    // First 1KB (fixed)
+    m_pMemory->MapReadPages(0x0000, 0x0400, pMap);
+    // ROM page 0 and 1
+    m_pMemory->MapReadPages(0x0400, 0x3C00, pROM + m_iMapperSlotAddress[0] + 0x0400);
+    m_pMemory->MapReadPages(0x4000, 0x4000, pROM + m_iMapperSlotAddress[1]);
+
+    if (m_bRAMEnabled)
+    {
+        // External RAM
+        m_pMemory->MapReadPages(0x8000, 0x4000, m_pRAMBanks + m_RAMBankStartAddress);
+        if (m_iPersistRAM >= 0)
+            m_pMemory->MapWritePages(0x8000, 0x4000, m_pRAMBanks + m_RAMBankStartAddress);
+    }
+    else
+    {
+        // ROM page 2
+        m_pMemory->MapReadPages(0x8000, 0x4000, pROM + m_iMapperSlotAddress[2]);
+    }
+
+    // RAM + RAM mirror, writes keep both copies in sync through PerformWrite
+    m_pMemory->MapReadPages(0xC000, 0x4000, pMap + 0xC000);
 }
 
 void SegaMemoryRule::SaveRam(std::ostream & file)
@@ -252,24 +289,23 @@ int SegaMemoryRule::GetBank(int index)
     }
 }
 
-void SegaMemoryRule::SaveState(std::ostream& stream)
+void SegaMemoryRule::SaveState(StateWriter& state)
 {
-    stream.write(reinterpret_cast<const char*> (m_pRAMBanks), 0x8000);
-    stream.write(reinterpret_cast<const char*> (m_iMapperSlot), sizeof(m_iMapperSlot));
-    stream.write(reinterpret_cast<const char*> (m_iMapperSlotAddress), sizeof(m_iMapperSlotAddress));
-    stream.write(reinterpret_cast<const char*> (&m_RAMBankStartAddress), sizeof(m_RAMBankStartAddress));
-    stream.write(reinterpret_cast<const char*> (&m_bRAMEnabled), sizeof(m_bRAMEnabled));
-    stream.write(reinterpret_cast<const char*> (&m_iPersistRAM), sizeof(m_iPersistRAM));
+    state.Write(m_pRAMBanks, 0x8000);
+    state.Write(m_iMapperSlot, sizeof(m_iMapperSlot));
+    state.Write(m_iMapperSlotAddress, sizeof(m_iMapperSlotAddress));
+    state.Write(&m_RAMBankStartAddress, sizeof(m_RAMBankStartAddress));
+    state.Write(&m_bRAMEnabled, sizeof(m_bRAMEnabled));
+    state.Write(&m_iPersistRAM, sizeof(m_iPersistRAM));
 }
 
-void SegaMemoryRule::LoadState(std::istream& stream)
+void SegaMemoryRule::LoadState(StateReader& state)
 {
-    using namespace std;
-
-    stream.read(reinterpret_cast<char*> (m_pRAMBanks), 0x8000);
-    stream.read(reinterpret_cast<char*> (m_iMapperSlot), sizeof(m_iMapperSlot));
-    stream.read(reinterpret_cast<char*> (m_iMapperSlotAddress), sizeof(m_iMapperSlotAddress));
-    stream.read(reinterpret_cast<char*> (&m_RAMBankStartAddress), sizeof(m_RAMBankStartAddress));
-    stream.read(reinterpret_cast<char*> (&m_bRAMEnabled), sizeof(m_bRAMEnabled));
-    stream.read(reinterpret_cast<char*> (&m_iPersistRAM), sizeof(m_iPersistRAM));
+    state.Read(m_pRAMBanks, 0x8000);
+    state.Read(m_iMapperSlot, sizeof(m_iMapperSlot));
+    state.Read(m_iMapperSlotAddress, sizeof(m_iMapperSlotAddress));
+    state.Read(&m_RAMBankStartAddress, sizeof(m_RAMBankStartAddress));
+    state.Read(&m_bRAMEnabled, sizeof(m_bRAMEnabled));
+    state.Read(&m_iPersistRAM, sizeof(m_iPersistRAM));
+    m_pMemory->UpdatePageTable();
 }
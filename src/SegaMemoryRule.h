@@ -30,6 +30,7 @@ public:
     virtual u8 PerformRead(u16 address);
     virtual void PerformWrite(u16 address, u8 value);
     virtual void Reset();
+    virtual void MapPages();
     virtual void SaveRam(std::ostream &file);
     virtual bool LoadRam(std::istream &file, s32 fileSize);
     virtual bool PersistedRAM();
@@ -38,8 +39,8 @@ public:
     virtual int GetRamBank();
     virtual u8* GetPage(int index);
     virtual int GetBank(int index);
-    virtual void SaveState(std::ostream& stream);
-    virtual void LoadState(std::istream& stream);
+    virtual void SaveState(StateWriter& state);
+    virtual void LoadState(StateReader& state);
 
 private:
     int m_iMapperSlot[3];
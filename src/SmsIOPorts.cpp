@@ -41,18 +41,14 @@ void SmsIOPorts::Reset()
     m_Port3F_HC = 0;
 }
 
-void SmsIOPorts::SaveState(std::ostream& stream)
+void SmsIOPorts::SaveState(StateWriter& state)
 {
-    using namespace std;
-
-    stream.write(reinterpret_cast<const char*> (&m_Port3F), sizeof(m_Port3F));
-    stream.write(reinterpret_cast<const char*> (&m_Port3F_HC), sizeof(m_Port3F_HC));
+    state.Write(&m_Port3F, sizeof(m_Port3F));
+    state.Write(&m_Port3F_HC, sizeof(m_Port3F_HC));
 }
 
-void SmsIOPorts::LoadState(std::istream& stream)
+void SmsIOPorts::LoadState(StateReader& state)
 {
-    using namespace std;
-
-    stream.read(reinterpret_cast<char*> (&m_Port3F), sizeof(m_Port3F));
-    stream.read(reinterpret_cast<char*> (&m_Port3F_HC), sizeof(m_Port3F_HC));
+    state.Read(&m_Port3F, sizeof(m_Port3F));
+    state.Read(&m_Port3F_HC, sizeof(m_Port3F_HC));
 }
@@ -37,8 +37,10 @@ public:
     void Reset();
     u8 DoInput(u8 port);
     void DoOutput(u8 port, u8 value);
-    void SaveState(std::ostream& stream);
-    void LoadState(std::istream& stream);
+    void SaveState(StateWriter& state);
+    void LoadState(StateReader& state);
+private:
+    void SyncDevices();
 private:
     Audio* m_pAudio;
     Video* m_pVideo;
@@ -59,8 +61,24 @@ private:
 #include "Processor.h"
 #include "YM2413.h"
 
+inline void SmsIOPorts::SyncDevices()
+{
+    // Bring audio and input up to date with the instructions executed
+    // since the last sync. The VDP only catches up when its ports are hit.
+    unsigned int clockCycles = m_pProcessor->ConsumePendingTStates();
+
+    if (clockCycles > 0)
+    {
+        m_pVideo->AddPendingCycles(clockCycles);
+        m_pAudio->Tick(clockCycles);
+        m_pInput->Tick(clockCycles);
+    }
+}
+
 inline u8 SmsIOPorts::DoInput(u8 port)
 {
+    SyncDevices();
+
     if (port < 0x40)
     {
         // Reads return $FF (SMS2)
@@ -71,6 +89,7 @@ inline u8 SmsIOPorts::DoInput(u8 port)
     {
         // Reads from even addresses return the V counter
         // Reads from odd addresses return the H counter
+        m_pVideo->Sync();
         if ((port & 0x01) == 0x00)
             return m_pVideo->GetVCounter();
         else
@@ -80,6 +99,7 @@ inline u8 SmsIOPorts::DoInput(u8 port)
     {
         // Reads from even addresses return the VDP data port contents
         // Reads from odd address return the VDP status flags
+        m_pVideo->Sync();
         if ((port & 0x01) == 0x00)
             return m_pVideo->GetDataPort();
         else
@@ -105,6 +125,8 @@ inline u8 SmsIOPorts::DoInput(u8 port)
 
 inline void SmsIOPorts::DoOutput(u8 port, u8 value)
 {
+    SyncDevices();
+
     if (port < 0x40)
     {
         // Writes to even addresses go to memory control register.
@@ -117,7 +139,10 @@ inline void SmsIOPorts::DoOutput(u8 port, u8 value)
         else
         {
             if (((value  & 0x01) && !(m_Port3F_HC & 0x01)) || ((value  & 0x08) && !(m_Port3F_HC & 0x08)))
+            {
+                m_pVideo->Sync();
                 m_pVideo->LatchHCounter();
+            }
             m_Port3F_HC = value & 0x05;
 
             m_Port3F =  ((value & 0x80) | (value & 0x20) << 1) & 0xC0;
@@ -136,6 +161,7 @@ inline void SmsIOPorts::DoOutput(u8 port, u8 value)
     {
         // Writes to even addresses go to the VDP data port.
         // Writes to odd addresses go to the VDP control port.
+        m_pVideo->Sync();
         if ((port & 0x01) == 0x00)
             m_pVideo->WriteData(value);
         else
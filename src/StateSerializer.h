@@ -0,0 +1,116 @@
+/*
+ * Gearsystem - Sega Master System / Game Gear Emulator
+ * Copyright (C) 2013  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#ifndef STATESERIALIZER_H
+#define	STATESERIALIZER_H
+
+#include "definitions.h"
+
+// Writes save state data straight into a caller owned buffer. With a NULL
+// buffer nothing is copied and it only adds up the size, which is how the
+// size of a state is known before saving it.
+class StateWriter
+{
+public:
+    StateWriter(u8* buffer, size_t capacity);
+    void Write(const void* data, size_t size);
+    size_t GetSize() const;
+    bool IsValid() const;
+
+private:
+    u8* m_pBuffer;
+    size_t m_iCapacity;
+    size_t m_iSize;
+};
+
+class StateReader
+{
+public:
+    StateReader(const u8* buffer, size_t size);
+    void Read(void* data, size_t size);
+    size_t GetPosition() const;
+    bool IsValid() const;
+
+private:
+    const u8* m_pBuffer;
+    size_t m_iSize;
+    size_t m_iPosition;
+    bool m_bValid;
+};
+
+
+inline StateWriter::StateWriter(u8* buffer, size_t capacity)
+{
+    m_pBuffer = buffer;
+    m_iCapacity = IsValidPointer(buffer) ? capacity : 0;
+    m_iSize = 0;
+}
+
+inline void StateWriter::Write(const void* data, size_t size)
+{
+    if (IsValidPointer(m_pBuffer) && (m_iSize + size <= m_iCapacity))
+        memcpy(m_pBuffer + m_iSize, data, size);
+
+    m_iSize += size;
+}
+
+inline size_t StateWriter::GetSize() const
+{
+    return m_iSize;
+}
+
+// False when a buffer was given and the state did not fit in it
+inline bool StateWriter::IsValid() const
+{
+    return !IsValidPointer(m_pBuffer) || (m_iSize <= m_iCapacity);
+}
+
+inline StateReader::StateReader(const u8* buffer, size_t size)
+{
+    m_pBuffer = buffer;
+    m_iSize = size;
+    m_iPosition = 0;
+    m_bValid = IsValidPointer(buffer);
+}
+
+inline void StateReader::Read(void* data, size_t size)
+{
+    if (m_bValid && (m_iPosition + size <= m_iSize))
+    {
+        memcpy(data, m_pBuffer + m_iPosition, size);
+        m_iPosition += size;
+    }
+    else
+    {
+        memset(data, 0, size);
+        m_bValid = false;
+    }
+}
+
+inline size_t StateReader::GetPosition() const
+{
+    return m_iPosition;
+}
+
+inline bool StateReader::IsValid() const
+{
+    return m_bValid;
+}
+
+#endif	/* STATESERIALIZER_H */
@@ -17,11 +17,28 @@
  *
  */
 
+#include <algorithm>
 #include "Video.h"
 #include "Memory.h"
 #include "Processor.h"
 #include "Cartridge.h"
 
+#if defined(IS_LITTLE_ENDIAN)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define GS_VIDEO_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GS_VIDEO_AVX2
+#include <immintrin.h>
+#endif
+#elif defined(GEARSYSTEM_ENABLE_NEON) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+// The NEON converters have not been checked against the scalar path on
+// hardware yet, so they stay opt-in until they are.
+#define GS_VIDEO_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 Video::Video(Memory* pMemory, Processor* pProcessor, Cartridge* pCartridge)
 {
     m_pMemory = pMemory;
@@ -29,9 +46,16 @@ Video::Video(Memory* pMemory, Processor* pProcessor, Cartridge* pCartridge)
     m_pCartridge = pCartridge;
     InitPointer(m_pInfoBuffer);
     InitPointer(m_pFrameBuffer);
+    InitPointer(m_pInternalFrameBuffer);
     InitPointer(m_pVdpVRAM);
     InitPointer(m_pVdpCRAM);
+    InitPointer(m_pTileCache);
+    InitPointer(m_pPreviousFrameBuffer);
+    InitPointer(m_LastRenderTarget.buffer);
     m_bFirstByteInSequence = false;
+    m_bSkipRender = false;
+    m_iSpriteLinesKey = 0;
+    m_bSpriteLinesDirty = true;
     for (int i = 0; i < 16; i++)
         m_VdpRegister[i] = 0;
     m_VdpCode = 0;
@@ -40,6 +64,7 @@ Video::Video(Memory* pMemory, Processor* pProcessor, Cartridge* pCartridge)
     m_iVCounter = 0;
     m_iHCounter = 0;
     m_iCycleCounter = 0;
+    m_iPendingCycles = 0;
     m_VdpStatus = 0;
     m_iVdpRegister10Counter = 0;
     m_ScrollX = 0;
@@ -60,22 +85,29 @@ Video::Video(Memory* pMemory, Processor* pProcessor, Cartridge* pCartridge)
     m_bDisplayEnabled = false;
     m_bSpriteOvrRequest = false;
     m_Overscan = OverscanDisabled;
+    for (int i = 0; i < 512; i++)
+        m_TileDirty[i] = true;
 }
 
 Video::~Video()
 {
     SafeDeleteArray(m_pInfoBuffer);
-    SafeDeleteArray(m_pFrameBuffer);
+    SafeDeleteArray(m_pInternalFrameBuffer);
     SafeDeleteArray(m_pVdpVRAM);
     SafeDeleteArray(m_pVdpCRAM);
+    SafeDeleteArray(m_pTileCache);
+    SafeDeleteArray(m_pPreviousFrameBuffer);
 }
 
 void Video::Init()
 {
-    m_pFrameBuffer = new u16[GS_RESOLUTION_MAX_WIDTH_WITH_OVERSCAN * GS_RESOLUTION_MAX_HEIGHT_WITH_OVERSCAN];
+    m_pInternalFrameBuffer = new u16[GS_RESOLUTION_MAX_WIDTH * GS_RESOLUTION_MAX_HEIGHT];
+    m_pFrameBuffer = m_pInternalFrameBuffer;
     m_pInfoBuffer = new u8[GS_RESOLUTION_MAX_WIDTH * GS_LINES_PER_FRAME_PAL];
     m_pVdpVRAM = new u8[0x4000];
     m_pVdpCRAM = new u8[0x40];
+    m_pTileCache = new u8[512 * 8 * 8 * 2];
+    m_pPreviousFrameBuffer = new u16[GS_RESOLUTION_MAX_WIDTH_WITH_OVERSCAN * GS_RESOLUTION_MAX_HEIGHT_WITH_OVERSCAN];
     InitPalettes(kSG1000_palette_888_normal,
         m_SG1000_palette_565_rgb_normal,
         m_SG1000_palette_555_rgb_normal,
@@ -86,6 +118,7 @@ void Video::Init()
         m_SG1000_palette_555_rgb_sms,
         m_SG1000_palette_565_bgr_sms,
         m_SG1000_palette_555_bgr_sms);
+    InitSpriteMasks();
     Reset(false, false);
 }
 
@@ -105,7 +138,7 @@ void Video::Reset(bool bGameGear, bool bPAL)
     m_ScrollX = 0;
     m_ScrollY = 0;
 
-    for (int i = 0; i < (GS_RESOLUTION_MAX_WIDTH_WITH_OVERSCAN * GS_RESOLUTION_MAX_HEIGHT_WITH_OVERSCAN); i++)
+    for (int i = 0; i < (GS_RESOLUTION_MAX_WIDTH * GS_RESOLUTION_MAX_HEIGHT); i++)
         m_pFrameBuffer[i] = 0;
     for (int i = 0; i < (GS_RESOLUTION_MAX_WIDTH * GS_LINES_PER_FRAME_PAL); i++)
         m_pInfoBuffer[i] = 0;
@@ -114,6 +147,10 @@ void Video::Reset(bool bGameGear, bool bPAL)
     for (int i = 0; i < 0x40; i++)
         m_pVdpCRAM[i] = 0;
 
+    InvalidateTileCache();
+    InvalidateSpriteCache();
+    InvalidateRenderTarget();
+
     m_VdpRegister[0] = 0x36; // Mode
     m_VdpRegister[1] = 0x80; // Mode
     m_VdpRegister[2] = 0xFF; // Screen Map Table Base
@@ -141,6 +178,7 @@ void Video::Reset(bool bGameGear, bool bPAL)
     m_LineEvents.render = false;
 
     m_iCycleCounter = 0;
+    m_iPendingCycles = 0;
     m_iVdpRegister10Counter = m_VdpRegister[10];
     m_iRenderLine = 0;
 
@@ -180,114 +218,208 @@ void Video::Reset(bool bGameGear, bool bPAL)
 
 bool Video::Tick(unsigned int clockCycles)
 {
-    int max_height = m_bExtendedMode224 ? 224 : 192;
     bool return_vblank = false;
 
     m_iCycleCounter += clockCycles;
 
-    ///// VINT /////
-    if (!m_LineEvents.vint && (m_iCycleCounter >= m_Timing[TIMING_VINT]))
+    // Lines fully covered by clockCycles are completed here. Events of the
+    // line reached at the end wait for the next tick, as they would if the
+    // CPU had ticked the VDP after every instruction.
+    do
     {
-        m_LineEvents.vint = true;
-        if ((m_iRenderLine == (max_height + 1)) && (IsSetBit(m_VdpRegister[1], 5)))
-            m_pProcessor->RequestINT(true);
-    }
+        int max_height = m_bExtendedMode224 ? 224 : 192;
 
-    ///// DISPLAY ON/OFF /////
-    if (!m_LineEvents.display && (m_iCycleCounter >= m_Timing[TIMING_DISPLAY]))
-    {
-        m_LineEvents.display = true;
-        m_bDisplayEnabled = IsSetBit(m_VdpRegister[1], 6);
-    }
+        ///// VINT /////
+        if (!m_LineEvents.vint && (m_iCycleCounter >= m_Timing[TIMING_VINT]))
+        {
+            m_LineEvents.vint = true;
+            if ((m_iRenderLine == (max_height + 1)) && (IsSetBit(m_VdpRegister[1], 5)))
+                m_pProcessor->RequestINT(true);
+        }
 
-    ///// SCROLLX /////
-    if (!m_LineEvents.scrollx && (m_iCycleCounter >= m_Timing[TIMING_XSCROLL]))
-    {
-        m_LineEvents.scrollx = true;
-        m_ScrollX = m_VdpRegister[8];   // latch scroll X
-    }
+        ///// DISPLAY ON/OFF /////
+        if (!m_LineEvents.display && (m_iCycleCounter >= m_Timing[TIMING_DISPLAY]))
+        {
+            m_LineEvents.display = true;
+            m_bDisplayEnabled = IsSetBit(m_VdpRegister[1], 6);
+        }
 
-    ///// HINT /////
-    if (!m_LineEvents.hint && (m_iCycleCounter >= m_Timing[TIMING_HINT]))
-    {
-        m_LineEvents.hint = true;
-        if (m_iRenderLine <= max_height)
+        ///// SCROLLX /////
+        if (!m_LineEvents.scrollx && (m_iCycleCounter >= m_Timing[TIMING_XSCROLL]))
         {
-            if (m_iVdpRegister10Counter == 0)
+            m_LineEvents.scrollx = true;
+            m_ScrollX = m_VdpRegister[8];   // latch scroll X
+        }
+
+        ///// HINT /////
+        if (!m_LineEvents.hint && (m_iCycleCounter >= m_Timing[TIMING_HINT]))
+        {
+            m_LineEvents.hint = true;
+            if (m_iRenderLine <= max_height)
             {
-                m_iVdpRegister10Counter = m_VdpRegister[10];
-                if (!m_bSG1000 && IsSetBit(m_VdpRegister[0], 4))
-                    m_pProcessor->RequestINT(true);
+                if (m_iVdpRegister10Counter == 0)
+                {
+                    m_iVdpRegister10Counter = m_VdpRegister[10];
+                    if (!m_bSG1000 && IsSetBit(m_VdpRegister[0], 4))
+                        m_pProcessor->RequestINT(true);
+                }
+                else
+                {
+                    m_iVdpRegister10Counter--;
+                }
             }
             else
+                m_iVdpRegister10Counter = m_VdpRegister[10];
+        }
+
+        ///// VCOUNT /////
+        if (!m_LineEvents.vcounter && (m_iCycleCounter >= m_Timing[TIMING_VCOUNT]))
+        {
+            m_LineEvents.vcounter = true;
+            m_iVCounter++;
+            if (m_iVCounter >= m_iLinesPerFrame)
             {
-                m_iVdpRegister10Counter--;
+                m_ScrollY = m_VdpRegister[9];   // latch scroll Y
+                m_iVCounter = 0;
             }
         }
-        else
-            m_iVdpRegister10Counter = m_VdpRegister[10];
-    }
 
-    ///// VCOUNT /////
-    if (!m_LineEvents.vcounter && (m_iCycleCounter >= m_Timing[TIMING_VCOUNT]))
-    {
-        m_LineEvents.vcounter = true;
-        m_iVCounter++;
-        if (m_iVCounter >= m_iLinesPerFrame)
+        ///// FLAG VINT /////
+        if (!m_LineEvents.vintFlag && (m_iCycleCounter >= m_Timing[TIMING_FLAG_VINT]))
         {
-            m_ScrollY = m_VdpRegister[9];   // latch scroll Y
-            m_iVCounter = 0;
+            m_LineEvents.vintFlag = true;
+            if (m_iRenderLine == (max_height + 1))
+                m_VdpStatus = SetBit(m_VdpStatus, 7);
         }
-    }
 
-    ///// FLAG VINT /////
-    if (!m_LineEvents.vintFlag && (m_iCycleCounter >= m_Timing[TIMING_FLAG_VINT]))
-    {
-        m_LineEvents.vintFlag = true;
-        if (m_iRenderLine == (max_height + 1))
-            m_VdpStatus = SetBit(m_VdpStatus, 7);
-    }
+        ///// SPRITE OVR /////
+        if (!m_LineEvents.spriteovr && (m_iCycleCounter >= m_Timing[TIMING_SPRITEOVR]) && !m_bSG1000)
+        {
+            m_LineEvents.spriteovr = true;
 
-    ///// SPRITE OVR /////
-    if (!m_LineEvents.spriteovr && (m_iCycleCounter >= m_Timing[TIMING_SPRITEOVR]) && !m_bSG1000)
-    {
-        m_LineEvents.spriteovr = true;
+            if (m_bSpriteOvrRequest)
+            {
+                m_bSpriteOvrRequest = false;
+                m_VdpStatus = SetBit(m_VdpStatus, 6);
+            }
+        }
 
-        if (m_bSpriteOvrRequest)
+        ///// RENDER /////
+        if (!m_LineEvents.render && (m_iCycleCounter >= m_Timing[TIMING_RENDER]))
         {
-            m_bSpriteOvrRequest = false;
-            m_VdpStatus = SetBit(m_VdpStatus, 6);
+            m_LineEvents.render = true;
+            ScanLine(m_iRenderLine);
         }
-    }
 
-    ///// RENDER /////
-    if (!m_LineEvents.render && (m_iCycleCounter >= m_Timing[TIMING_RENDER]))
-    {
-        m_LineEvents.render = true;
-        ScanLine(m_iRenderLine);
+        ///// END OF LINE /////
+        if (m_iCycleCounter >= GS_CYCLES_PER_LINE)
+        {
+            if (m_iRenderLine == (max_height - 1))
+            {
+                return_vblank = true;
+            }
+            m_iRenderLine++;
+            m_iRenderLine %= m_iLinesPerFrame;
+            m_iCycleCounter -= GS_CYCLES_PER_LINE;
+            m_LineEvents.hint = false;
+            m_LineEvents.scrollx = false;
+            m_LineEvents.vcounter = false;
+            m_LineEvents.vint = false;
+            m_LineEvents.vintFlag = false;
+            m_LineEvents.render = false;
+            m_LineEvents.display = false;
+            m_LineEvents.spriteovr = false;
+        }
     }
+    while (m_iCycleCounter >= GS_CYCLES_PER_LINE);
+
+    return return_vblank;
+}
+
+bool Video::Sync()
+{
+    unsigned int pending = m_iPendingCycles;
+
+    if (pending == 0)
+        return false;
+
+    m_iPendingCycles = 0;
+
+    // The last instruction is ticked on its own so that a line it ends
+    // does not fire the events of the following line too early
+    unsigned int last = m_pProcessor->GetLastInstructionTStates();
+
+    if (last > pending)
+        last = pending;
 
-    ///// END OF LINE /////
-    if (m_iCycleCounter >= GS_CYCLES_PER_LINE)
+    bool vblank = false;
+
+    if (pending > last)
+        vblank = Tick(pending - last);
+
+    if (Tick(last))
+        vblank = true;
+
+    return vblank;
+}
+
+unsigned int Video::GetCyclesToNextEvent()
+{
+    int max_height = m_bExtendedMode224 ? 224 : 192;
+    bool hint_enabled = !m_bSG1000 && IsSetBit(m_VdpRegister[0], 4);
+    bool vint_enabled = IsSetBit(m_VdpRegister[1], 5);
+    bool hint_pending = !m_LineEvents.hint;
+    bool vint_pending = !m_LineEvents.vint;
+    int line = m_iRenderLine;
+    int counter = m_iVdpRegister10Counter;
+    int line_start = -m_iCycleCounter;
+
+    // Walk the lines ahead until the VDP may assert the interrupt line or
+    // the frame ends. Nothing else the VDP does is visible to the CPU
+    // without an I/O access, and those sync the VDP on their own.
+    for (int i = 0; i <= m_iLinesPerFrame; i++)
     {
-        if (m_iRenderLine == (max_height - 1))
+        int next = -1;
+
+        if (hint_pending)
+        {
+            if (line <= max_height)
+            {
+                if (counter == 0)
+                {
+                    counter = m_VdpRegister[10];
+                    if (hint_enabled)
+                        next = m_Timing[TIMING_HINT];
+                }
+                else
+                    counter--;
+            }
+            else
+                counter = m_VdpRegister[10];
+        }
+
+        if (vint_pending && vint_enabled && (line == (max_height + 1)))
+        {
+            if ((next < 0) || (m_Timing[TIMING_VINT] < next))
+                next = m_Timing[TIMING_VINT];
+        }
+
+        if ((next < 0) && (line == (max_height - 1)))
+            next = GS_CYCLES_PER_LINE;
+
+        if (next >= 0)
         {
-            return_vblank = true;
+            int cycles = line_start + next;
+            return (cycles > 0) ? cycles : 1;
         }
-        m_iRenderLine++;
-        m_iRenderLine %= m_iLinesPerFrame;
-        m_iCycleCounter -= GS_CYCLES_PER_LINE;
-        m_LineEvents.hint = false;
-        m_LineEvents.scrollx = false;
-        m_LineEvents.vcounter = false;
-        m_LineEvents.vint = false;
-        m_LineEvents.vintFlag = false;
-        m_LineEvents.render = false;
-        m_LineEvents.display = false;
-        m_LineEvents.spriteovr = false;
+
+        line_start += GS_CYCLES_PER_LINE;
+        line = (line + 1) % m_iLinesPerFrame;
+        hint_pending = true;
+        vint_pending = true;
     }
 
-    return return_vblank;
+    return (line_start > 0) ? line_start : 1;
 }
 
 void Video::LatchHCounter()
@@ -384,7 +516,13 @@ void Video::WriteData(u8 data)
         case VDP_WRITE_VRAM_OPERATION:
         case VDP_WRITE_REG_OPERATION:
         {
-            m_pVdpVRAM[m_VdpAddress] = data;
+            if (m_pVdpVRAM[m_VdpAddress] != data)
+            {
+                m_pVdpVRAM[m_VdpAddress] = data;
+                m_TileDirty[m_VdpAddress >> 5] = true;
+                if ((m_VdpAddress & 0x3FC0) == ((m_VdpRegister[5] << 7) & 0x3F00))
+                    m_bSpriteLinesDirty = true;
+            }
             break;
         }
         case VDP_WRITE_CRAM_OPERATION:
@@ -440,6 +578,11 @@ void Video::WriteControl(u8 control)
                 {
                     Log("--> ** Attempting to write on VDP REG %d: %X", reg, control);
                 }
+
+                // Interrupt enables, screen height and line counter
+                // reload affect when the next interrupt is due
+                if ((reg < 2) || (reg == 10))
+                    m_pProcessor->RequestSync();
                 break;
             }
         }
@@ -457,7 +600,28 @@ void Video::ScanLine(int line)
         ParseSpritesSMSGG(next_line);
     }
 
-    if (m_bDisplayEnabled)
+    if (m_bSkipRender)
+    {
+        // Only the guest visible side effects are kept: the background
+        // passes leave their info row cleared and the sprite passes still
+        // run for collision and overflow, without touching the frame buffer
+        if (m_bSG1000 || !m_bDisplayEnabled)
+        {
+            if (line < max_height)
+            {
+                memset(m_pInfoBuffer + (line * m_iScreenWidth), 0, m_iScreenWidth);
+                if (m_bDisplayEnabled)
+                    RenderSpritesSG1000(line);
+            }
+        }
+        else
+        {
+            memset(m_pInfoBuffer + (line * m_iScreenWidth), 0, m_iScreenWidth);
+            EvaluateSpritesSMSGG(next_line);
+            MarkSpritePixelsSMSGG(next_line);
+        }
+    }
+    else if (m_bDisplayEnabled)
     {
         // DISPLAY ON
         if (m_bSG1000)
@@ -471,6 +635,7 @@ void Video::ScanLine(int line)
         else
         {
             RenderBackgroundSMSGG(line);
+            EvaluateSpritesSMSGG(next_line);
             RenderSpritesSMSGG(next_line);
         }
     }
@@ -524,6 +689,13 @@ void Video::RenderBackgroundSMSGG(int line)
     int tile_y_offset = map_y & 7;
 
     int palette_color = 0;
+    int palette_offset = 0;
+    bool priority = false;
+    bool vscroll_locked = false;
+
+    // The row of the current tile is fetched once and reused for its pixels
+    int fetched_tile_x = -1;
+    const u8* tile_row = NULL;
 
     int scx_begin = m_bGameGear ? GS_RESOLUTION_GG_X_OFFSET : 0;
     int scx_end = scx_begin + m_iScreenWidth;
@@ -544,40 +716,35 @@ void Video::RenderBackgroundSMSGG(int line)
             }
             else
             {
-                if (IsSetBit(m_VdpRegister[0], 7) && (scx >= 192))
+                if (IsSetBit(m_VdpRegister[0], 7) && (scx >= 192) && !vscroll_locked)
                 {
                     map_y = scy;
                     tile_y = map_y >> 3;
                     tile_y_offset = map_y & 7;
+                    vscroll_locked = true;
+                    fetched_tile_x = -1;
                 }
                 u8 map_x = scx - origin_x;
-
                 int tile_x = map_x >> 3;
-                int tile_x_offset = map_x & 7;
-
-                int tile_addr = map_address + (((tile_y << 5) + tile_x) << 1);
-                int tile_index = m_pVdpVRAM[tile_addr];
-                int tile_info = m_pVdpVRAM[tile_addr + 1];
-                if (IsSetBit(tile_info, 0))
-                    tile_index = (tile_index | 0x0100) & 0x1FF;
-
-                bool hflip = IsSetBit(tile_info, 1);
-                bool vflip = IsSetBit(tile_info, 2);
-                int palette_offset = IsSetBit(tile_info, 3) ? 16 : 0;
-                bool priority = IsSetBit(tile_info, 4);
 
-                int tile_data_addr = tile_index << 5;
-                tile_data_addr += ((vflip ? 7 - tile_y_offset : tile_y_offset) << 2);
-
-                int tile_pixel_x = 7 - tile_x_offset;
-                if (hflip)
-                    tile_pixel_x = tile_x_offset;
+                if (tile_x != fetched_tile_x)
+                {
+                    int tile_addr = map_address + (((tile_y << 5) + tile_x) << 1);
+                    int tile_index = m_pVdpVRAM[tile_addr];
+                    int tile_info = m_pVdpVRAM[tile_addr + 1];
+                    if (IsSetBit(tile_info, 0))
+                        tile_index = (tile_index | 0x0100) & 0x1FF;
+
+                    bool hflip = IsSetBit(tile_info, 1);
+                    bool vflip = IsSetBit(tile_info, 2);
+                    palette_offset = IsSetBit(tile_info, 3) ? 16 : 0;
+                    priority = IsSetBit(tile_info, 4);
+
+                    tile_row = GetTileRow(tile_index, vflip ? 7 - tile_y_offset : tile_y_offset, hflip);
+                    fetched_tile_x = tile_x;
+                }
 
-                palette_color = ((m_pVdpVRAM[tile_data_addr] >> tile_pixel_x) & 0x01) +
-                        (((m_pVdpVRAM[tile_data_addr + 1] >> tile_pixel_x) & 0x01) << 1) +
-                        (((m_pVdpVRAM[tile_data_addr + 2] >> tile_pixel_x) & 0x01) << 2) +
-                        (((m_pVdpVRAM[tile_data_addr + 3] >> tile_pixel_x) & 0x01) << 3) +
-                        palette_offset;
+                palette_color = tile_row[map_x & 7] + palette_offset;
 
                 bool final_priority = priority && ((palette_color - palette_offset) != 0);
 
@@ -603,12 +770,129 @@ void Video::RenderBackgroundSMSGG(int line)
     }
 }
 
+// While enabled, ScanLine keeps sprite collision, sprite overflow and the
+// per-pixel priority info exactly as a full render would, but the frame
+// buffer is left untouched
+void Video::SetSkipRender(bool skip)
+{
+    m_bSkipRender = skip;
+}
+
+bool Video::IsSkipRenderEnabled()
+{
+    return m_bSkipRender;
+}
+
+void Video::InitSpriteMasks()
+{
+    for (int planes = 0; planes < 256; planes++)
+    {
+        u16 normal = 0;
+        u16 zoomed = 0;
+
+        for (int x = 0; x < 8; x++)
+        {
+            if (IsSetBit(planes, 7 - x))
+            {
+                normal |= 1 << x;
+                zoomed |= 3 << (x << 1);
+            }
+        }
+
+        m_SpriteRowMask[0][planes] = normal;
+        m_SpriteRowMask[1][planes] = zoomed;
+    }
+}
+
+void Video::InvalidateTileCache()
+{
+    for (int i = 0; i < 512; i++)
+        m_TileDirty[i] = true;
+}
+
+void Video::InvalidateSpriteCache()
+{
+    m_bSpriteLinesDirty = true;
+}
+
+void Video::DecodeTile(int tile)
+{
+    const u8* tile_data = m_pVdpVRAM + (tile << 5);
+    u8* normal = m_pTileCache + (tile << 6);
+    u8* flipped = normal + 0x8000;
+
+    for (int row = 0; row < 8; row++)
+    {
+        u8 plane0 = tile_data[0];
+        u8 plane1 = tile_data[1];
+        u8 plane2 = tile_data[2];
+        u8 plane3 = tile_data[3];
+
+        for (int x = 0; x < 8; x++)
+        {
+            int bit = 7 - x;
+            u8 color = ((plane0 >> bit) & 0x01) |
+                    (((plane1 >> bit) & 0x01) << 1) |
+                    (((plane2 >> bit) & 0x01) << 2) |
+                    (((plane3 >> bit) & 0x01) << 3);
+            normal[x] = color;
+            flipped[7 - x] = color;
+        }
+
+        tile_data += 4;
+        normal += 8;
+        flipped += 8;
+    }
+
+    m_TileDirty[tile] = false;
+}
+
 void Video::ParseSpritesSMSGG(int line)
 {
-    u16 sprite_table_address = (m_VdpRegister[5] << 7) & 0x3F00;
-    int buffer_index = 0;
     int max_height = m_bExtendedMode224 ? 224 : 192;
 
+    UpdateSpriteLines();
+
+    const SpriteLine& sprite_line = m_SpriteLines[line];
+
+    for (int i = 0; i < sprite_line.count; i++)
+    {
+        m_NextLineSprites[i] = sprite_line.sprites[i];
+    }
+
+    for (int i = sprite_line.count; i < 8; i++)
+    {
+        m_NextLineSprites[i] = -1;
+    }
+
+    if (sprite_line.overflow && (line < max_height))
+        m_bSpriteOvrRequest = true;
+}
+
+// Walks the sprite attribute table once for the whole frame instead of
+// once per line. Sprites are added in table order, so each line keeps the
+// first 8 sprites and flags the overflow exactly like a per-line scan.
+void Video::UpdateSpriteLines()
+{
+    u16 sprite_table_address = (m_VdpRegister[5] << 7) & 0x3F00;
+    int key = sprite_table_address | ((m_VdpRegister[1] & 0x03) << 14) | (m_bExtendedMode224 ? 0x10000 : 0);
+
+    if (!m_bSpriteLinesDirty && (key == m_iSpriteLinesKey))
+        return;
+
+    m_bSpriteLinesDirty = false;
+    m_iSpriteLinesKey = key;
+
+    for (int line = 0; line < GS_LINES_PER_FRAME_PAL; line++)
+    {
+        m_SpriteLines[line].count = 0;
+        m_SpriteLines[line].overflow = false;
+    }
+
+    int sprite_height = IsSetBit(m_VdpRegister[1], 1) ? 16 : 8;
+    if (IsSetBit(m_VdpRegister[1], 0))
+        sprite_height <<= 1;
+
     for (int sprite = 0; sprite < 64; sprite++)
     {
         int sprite_index = sprite_table_address + sprite;
@@ -619,34 +903,122 @@ void Video::ParseSpritesSMSGG(int line)
         }
 
         int sprite_y = m_pVdpVRAM[sprite_index] + 1;
-        int sprite_height = IsSetBit(m_VdpRegister[1], 1) ? 16 : 8;
-        bool sprite_zoom = IsSetBit(m_VdpRegister[1], 0);
-        if (sprite_zoom)
-            sprite_height <<= 1;
-        int sprite_y2 = sprite_y + sprite_height;
 
-        int sprite_y_offscreen = ((sprite_y > 240) && (sprite_y <= 256)) ? sprite_y - 256 : sprite_y;
-        int sprite_y_offscreen2 = sprite_y_offscreen + sprite_height;
+        AddSpriteToLines(sprite, sprite_y, sprite_height);
 
-        if (((line >= sprite_y) && (line < sprite_y2)) || ((line >= sprite_y_offscreen) && (line < sprite_y_offscreen2)))
-        {
-            if (buffer_index > 7)
-            {
-                if (line < max_height)
-                    m_bSpriteOvrRequest = true;
-                break;
-            }
+        if ((sprite_y > 240) && (sprite_y <= 256))
+            AddSpriteToLines(sprite, sprite_y - 256, sprite_height);
+    }
+}
 
-            m_NextLineSprites[buffer_index] = sprite;
+void Video::AddSpriteToLines(int sprite, int first_line, int height)
+{
+    int begin = std::max(first_line, 0);
+    int end = std::min(first_line + height, GS_LINES_PER_FRAME_PAL);
 
-            buffer_index++;
-        }
+    for (int line = begin; line < end; line++)
+    {
+        SpriteLine& sprite_line = m_SpriteLines[line];
+
+        if (sprite_line.count < 8)
+            sprite_line.sprites[sprite_line.count++] = static_cast<u8>(sprite);
+        else
+            sprite_line.overflow = true;
+    }
+}
+
+// Sprite collision for the line, independent of any pixel output. Every
+// opaque sprite row becomes a bit mask clipped to the visible columns and
+// is tested against the sprites already placed on the line with a single
+// AND per 64 pixel word.
+void Video::EvaluateSpritesSMSGG(int line)
+{
+    for (int w = 0; w < 4; w++)
+        m_SpriteLineMask[w] = 0;
+
+    int max_height = m_bExtendedMode224 ? 224 : 192;
+
+    if ((line >= max_height) && (line < 240))
+        return;
+
+    u16 sprite_table_address = (m_VdpRegister[5] << 7) & 0x3F00;
+    u16 sprite_table_address_2 = sprite_table_address + 0x80;
+    bool sprite_height_16 = IsSetBit(m_VdpRegister[1], 1);
+    bool sprite_zoom = IsSetBit(m_VdpRegister[1], 0);
+    int sprite_shift = IsSetBit(m_VdpRegister[0], 3) ? 8 : 0;
+    u16 sprite_tiles_address = (m_VdpRegister[6] << 11) & 0x2000;
+    const u16* row_masks = m_SpriteRowMask[sprite_zoom ? 1 : 0];
+
+    int scx_begin = m_bGameGear ? GS_RESOLUTION_GG_X_OFFSET : 0;
+    int scx_end = scx_begin + m_iScreenWidth;
+
+    if (IsSetBit(m_VdpRegister[0], 5))
+        scx_begin = std::max(scx_begin, 8);
+
+    u64 window[5];
+
+    for (int w = 0; w < 4; w++)
+    {
+        int first = std::max(scx_begin - (w << 6), 0);
+        int last = std::min(scx_end - (w << 6), 64);
+
+        if (first >= last)
+            window[w] = 0;
+        else if ((last - first) == 64)
+            window[w] = ~0ULL;
+        else
+            window[w] = ((1ULL << (last - first)) - 1) << first;
     }
 
-    for (int i = buffer_index; i < 8; i++)
+    window[4] = 0;
+
+    bool sprite_collision = false;
+
+    for (int i = 0; i < 8; i++)
     {
-        m_NextLineSprites[i] = -1;
+        if (m_NextLineSprites[i] < 0)
+            continue;
+
+        int sprite = m_NextLineSprites[i];
+
+        u16 sprite_info_address = sprite_table_address_2 + (sprite << 1);
+        int sprite_y = m_pVdpVRAM[sprite_table_address + sprite] + 1;
+
+        if ((sprite_y > 240) && (sprite_y <= 256) && (line < max_height))
+        {
+            sprite_y -= 256;
+        }
+
+        int sprite_x = m_pVdpVRAM[sprite_info_address] - sprite_shift;
+
+        int sprite_tile = m_pVdpVRAM[sprite_info_address + 1];
+        sprite_tile &= sprite_height_16 ? 0xFE : 0xFF;
+        int sprite_tile_addr = sprite_tiles_address + (sprite_tile << 5) +  (((line - sprite_y) >> (sprite_zoom ? 1 : 0)) << 2);
+
+        u8 planes = m_pVdpVRAM[sprite_tile_addr] | m_pVdpVRAM[sprite_tile_addr + 1] |
+                m_pVdpVRAM[sprite_tile_addr + 2] | m_pVdpVRAM[sprite_tile_addr + 3];
+        u64 mask = row_masks[planes];
+
+        if (sprite_x < 0)
+        {
+            mask >>= -sprite_x;
+            sprite_x = 0;
+        }
+
+        int w = sprite_x >> 6;
+        int shift = sprite_x & 63;
+        u64 low = (mask << shift) & window[w];
+        u64 high = ((shift > 48) ? (mask >> (64 - shift)) : 0) & window[w + 1];
+
+        if ((low & m_SpriteLineMask[w]) || (high & m_SpriteLineMask[(w + 1) & 3]))
+            sprite_collision = true;
+
+        m_SpriteLineMask[w] |= low;
+        m_SpriteLineMask[(w + 1) & 3] |= high;
     }
+
+    if (sprite_collision)
+        m_VdpStatus = SetBit(m_VdpStatus, 5);
 }
 
 void Video::RenderSpritesSMSGG(int line)
@@ -659,7 +1031,6 @@ void Video::RenderSpritesSMSGG(int line)
     int y_offset = m_bExtendedMode224 ? GS_RESOLUTION_GG_Y_OFFSET_EXTENDED : GS_RESOLUTION_GG_Y_OFFSET;
     u16 sprite_table_address = (m_VdpRegister[5] << 7) & 0x3F00;
     u16 sprite_table_address_2 = sprite_table_address + 0x80;
-    int sprite_collision = false;
     int scy_adjust = m_bGameGear ? y_offset : 0;
     int line_width_info = line * m_iScreenWidth;
     int line_width_screen = (line - scy_adjust) * m_iScreenWidth;
@@ -745,15 +1116,28 @@ void Video::RenderSpritesSMSGG(int line)
                     m_pFrameBuffer[pixel_screen] = ColorFromPalette(palette_color);
             }
 
-            if ((m_pInfoBuffer[pixel_info] & 0x01) != 0)
-                sprite_collision = true;
-
             m_pInfoBuffer[pixel_info] |= 0x01;
         }
     }
+}
 
-    if (sprite_collision)
-        m_VdpStatus = SetBit(m_VdpStatus, 5);
+// Sets the info bits RenderSpritesSMSGG would leave behind for the line,
+// straight from the mask built by EvaluateSpritesSMSGG
+void Video::MarkSpritePixelsSMSGG(int line)
+{
+    int scx_begin = m_bGameGear ? GS_RESOLUTION_GG_X_OFFSET : 0;
+    u8* info = m_pInfoBuffer + (line * m_iScreenWidth) - scx_begin;
+
+    for (int w = 0; w < 4; w++)
+    {
+        u64 mask = m_SpriteLineMask[w];
+
+        for (int x = w << 6; mask != 0; x++, mask >>= 1)
+        {
+            if (mask & 1)
+                info[x] |= 0x01;
+        }
+    }
 }
 
 void Video::RenderBackgroundSG1000(int line)
@@ -896,7 +1280,8 @@ void Video::RenderSpritesSG1000(int line)
 
             if (sprite_pixel && (sprite_count < 5) && ((m_pInfoBuffer[pixel] & 0x08) == 0))
             {
-                m_pFrameBuffer[pixel] = sprite_color;
+                if (!m_bSkipRender)
+                    m_pFrameBuffer[pixel] = sprite_color;
                 m_pInfoBuffer[pixel] |= 0x08;
             }
 
@@ -911,195 +1296,565 @@ void Video::RenderSpritesSG1000(int line)
         m_VdpStatus = SetBit(m_VdpStatus, 5);
 }
 
-void Video::Render24bit(u16* srcFrameBuffer, u8* dstFrameBuffer, GS_Color_Format pixelFormat, int size, bool overscan)
+static const stChannelScale kScale2bitTo5bit = { 21, 0, 1 };
+static const stChannelScale kScale2bitTo6bit = { 21, 0, 0 };
+static const stChannelScale kScale2bitTo8bit = { 85, 0, 0 };
+static const stChannelScale kScale4bitTo5bit = { 17, 0, 3 };
+static const stChannelScale kScale4bitTo6bit = { 67, 9, 4 };
+static const stChannelScale kScale4bitTo8bit = { 17, 0, 0 };
+
+typedef void (*ConvertLine16Func)(const u16* src, u16* dst, int count, const stPixelConversion& c);
+typedef void (*ConvertLine24Func)(const u16* src, u8* dst, int count, const stPixelConversion& c);
+
+static void ConvertLine16Scalar(const u16* src, u16* dst, int count, const stPixelConversion& c)
+{
+    for (int i = 0; i < count; i++)
+    {
+        u16 color = src[i];
+        dst[i] = (c.lut[(color >> c.shift_first) & c.mask] << c.out_shift) |
+                (c.lut_g[(color >> c.shift_g) & c.mask] << 5) |
+                c.lut[(color >> c.shift_last) & c.mask];
+    }
+}
+
+static void ConvertLine24Scalar(const u16* src, u8* dst, int count, const stPixelConversion& c)
 {
-    int x = 0;
-    int y = 0;
-    int overscan_h_l = 0;
-    int overscan_v = 0;
-    int overscan_content_v = 0;
-    int overscan_content_h = 0;
-    int overscan_total_width = GS_RESOLUTION_MAX_WIDTH;
-    int overscan_total_height = 0;
-    bool overscan_enabled = false;
-    int overscan_color = m_bSG1000 ? m_VdpRegister[7] & 0x0F : ColorFromPalette((m_VdpRegister[7] & 0x0F) + 16);
-    int buffer_size = size * 3;    
-    int shift_g = m_bGameGear ? 4 : 2;
-    int shift_b = m_bGameGear ? 8 : 4;
-    int mask = m_bGameGear ? 0x0F : 0x03;
-    bool bgr = (pixelFormat == GS_PIXEL_BGR888);
-    const u8* lut = m_bGameGear ? k4bitTo8bit : k2bitTo8bit;
-    const u8* sg1000_palette = m_pCartridge->IsSG1000() ? kSG1000_palette_888_normal : kSG1000_palette_888_sms;
+    for (int i = 0; i < count; i++, dst += 3)
+    {
+        u16 color = src[i];
+        dst[0] = c.lut[(color >> c.shift_first) & c.mask];
+        dst[1] = c.lut_g[(color >> c.shift_g) & c.mask];
+        dst[2] = c.lut[(color >> c.shift_last) & c.mask];
+    }
+}
 
-    if (m_bGameGear)
-        overscan = false;
+static void ConvertLine16SG1000(const u16* src, u16* dst, int count, const stPixelConversion& c)
+{
+    for (int i = 0; i < count; i++)
+        dst[i] = c.sg1000_palette_16[src[i]];
+}
+
+static void ConvertLine24SG1000(const u16* src, u8* dst, int count, const stPixelConversion& c)
+{
+    for (int i = 0; i < count; i++, dst += 3)
+    {
+        const u8* color = c.sg1000_palette_24 + (src[i] * 3);
+        dst[0] = color[c.sg1000_first];
+        dst[1] = color[1];
+        dst[2] = color[c.sg1000_last];
+    }
+}
+
+#if defined(GS_VIDEO_SSE2)
+
+static inline __m128i ScaleChannelSSE2(__m128i value, const stChannelScale& scale)
+{
+    __m128i result = _mm_mullo_epi16(value, _mm_set1_epi16(scale.mul));
+    result = _mm_add_epi16(result, _mm_set1_epi16(scale.add));
+    return _mm_srl_epi16(result, _mm_cvtsi32_si128(scale.shift));
+}
+
+static void ConvertLine16SSE2(const u16* src, u16* dst, int count, const stPixelConversion& c)
+{
+    const __m128i mask = _mm_set1_epi16(c.mask);
+    const __m128i shift_first = _mm_cvtsi32_si128(c.shift_first);
+    const __m128i shift_g = _mm_cvtsi32_si128(c.shift_g);
+    const __m128i shift_last = _mm_cvtsi32_si128(c.shift_last);
+    const __m128i out_shift = _mm_cvtsi32_si128(c.out_shift);
+    int i = 0;
+
+    for (; (i + 8) <= count; i += 8)
+    {
+        __m128i color = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i first = ScaleChannelSSE2(_mm_and_si128(_mm_srl_epi16(color, shift_first), mask), c.scale);
+        __m128i green = ScaleChannelSSE2(_mm_and_si128(_mm_srl_epi16(color, shift_g), mask), c.scale_g);
+        __m128i last = ScaleChannelSSE2(_mm_and_si128(_mm_srl_epi16(color, shift_last), mask), c.scale);
+        __m128i result = _mm_or_si128(_mm_sll_epi16(first, out_shift), _mm_slli_epi16(green, 5));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(result, last));
+    }
+
+    ConvertLine16Scalar(src + i, dst + i, count - i, c);
+}
 
-    if (overscan && (m_Overscan != OverscanDisabled))
+static inline __m128i ScaleChannel8bitSSE2(__m128i value, const stPixelConversion& c)
+{
+    __m128i fix = _mm_and_si128(_mm_cmpeq_epi16(value, _mm_set1_epi16(5)), _mm_set1_epi16(c.fix));
+    return _mm_add_epi16(ScaleChannelSSE2(value, c.scale), fix);
+}
+
+static void ConvertLine24SSE2(const u16* src, u8* dst, int count, const stPixelConversion& c)
+{
+    const __m128i mask = _mm_set1_epi16(c.mask);
+    const __m128i shift_first = _mm_cvtsi32_si128(c.shift_first);
+    const __m128i shift_g = _mm_cvtsi32_si128(c.shift_g);
+    const __m128i shift_last = _mm_cvtsi32_si128(c.shift_last);
+    u32 pixels[8];
+    int i = 0;
+
+    // Every pixel is stored as 4 bytes overlapping the next one, so the
+    // loop stops while at least one pixel is left for the scalar tail
+    for (; (i + 8) < count; i += 8)
     {
-        overscan_enabled = true;
-        overscan_content_v = m_bExtendedMode224 ? GS_RESOLUTION_SMS_HEIGHT_EXTENDED : GS_RESOLUTION_SMS_HEIGHT;
-        overscan_v = m_bPAL ? GS_RESOLUTION_SMS_OVERSCAN_V_PAL : GS_RESOLUTION_SMS_OVERSCAN_V;
-        overscan_v -= m_bExtendedMode224 ? 16 : 0;
-        overscan_total_height = overscan_content_v + (overscan_v * 2);
+        __m128i color = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i first = ScaleChannel8bitSSE2(_mm_and_si128(_mm_srl_epi16(color, shift_first), mask), c);
+        __m128i green = ScaleChannel8bitSSE2(_mm_and_si128(_mm_srl_epi16(color, shift_g), mask), c);
+        __m128i last = ScaleChannel8bitSSE2(_mm_and_si128(_mm_srl_epi16(color, shift_last), mask), c);
+        __m128i first_green = _mm_or_si128(first, _mm_slli_epi16(green, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), _mm_unpacklo_epi16(first_green, last));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + 4), _mm_unpackhi_epi16(first_green, last));
+
+        u8* out = dst + (i * 3);
+        for (int p = 0; p < 8; p++)
+            memcpy(out + (p * 3), &pixels[p], 4);
     }
 
-    if (overscan && (m_Overscan == OverscanFull320))
+    ConvertLine24Scalar(src + i, dst + (i * 3), count - i, c);
+}
+
+#endif
+
+#if defined(GS_VIDEO_AVX2)
+
+static bool HasAVX2()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+__attribute__((target("avx2")))
+static inline __m256i ScaleChannelAVX2(__m256i value, const stChannelScale& scale)
+{
+    __m256i result = _mm256_mullo_epi16(value, _mm256_set1_epi16(scale.mul));
+    result = _mm256_add_epi16(result, _mm256_set1_epi16(scale.add));
+    return _mm256_srl_epi16(result, _mm_cvtsi32_si128(scale.shift));
+}
+
+__attribute__((target("avx2")))
+static void ConvertLine16AVX2(const u16* src, u16* dst, int count, const stPixelConversion& c)
+{
+    const __m256i mask = _mm256_set1_epi16(c.mask);
+    const __m128i shift_first = _mm_cvtsi32_si128(c.shift_first);
+    const __m128i shift_g = _mm_cvtsi32_si128(c.shift_g);
+    const __m128i shift_last = _mm_cvtsi32_si128(c.shift_last);
+    const __m128i out_shift = _mm_cvtsi32_si128(c.out_shift);
+    int i = 0;
+
+    for (; (i + 16) <= count; i += 16)
     {
-        overscan_content_h = GS_RESOLUTION_MAX_WIDTH;
-        overscan_h_l = GS_RESOLUTION_SMS_OVERSCAN_H_320_L;
-        overscan_total_width = overscan_content_h + overscan_h_l + GS_RESOLUTION_SMS_OVERSCAN_H_320_R;
+        __m256i color = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i first = ScaleChannelAVX2(_mm256_and_si256(_mm256_srl_epi16(color, shift_first), mask), c.scale);
+        __m256i green = ScaleChannelAVX2(_mm256_and_si256(_mm256_srl_epi16(color, shift_g), mask), c.scale_g);
+        __m256i last = ScaleChannelAVX2(_mm256_and_si256(_mm256_srl_epi16(color, shift_last), mask), c.scale);
+        __m256i result = _mm256_or_si256(_mm256_sll_epi16(first, out_shift), _mm256_slli_epi16(green, 5));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(result, last));
     }
 
-    if (overscan && (m_Overscan == OverscanFull284))
+    ConvertLine16SSE2(src + i, dst + i, count - i, c);
+}
+
+#endif
+
+#if defined(GS_VIDEO_NEON)
+
+static inline uint16x8_t ScaleChannelNEON(uint16x8_t value, const stChannelScale& scale)
+{
+    uint16x8_t result = vmlaq_u16(vdupq_n_u16(scale.add), value, vdupq_n_u16(scale.mul));
+    return vshlq_u16(result, vdupq_n_s16(-scale.shift));
+}
+
+static void ConvertLine16NEON(const u16* src, u16* dst, int count, const stPixelConversion& c)
+{
+    const uint16x8_t mask = vdupq_n_u16(c.mask);
+    const int16x8_t shift_first = vdupq_n_s16(-c.shift_first);
+    const int16x8_t shift_g = vdupq_n_s16(-c.shift_g);
+    const int16x8_t shift_last = vdupq_n_s16(-c.shift_last);
+    const int16x8_t out_shift = vdupq_n_s16(c.out_shift);
+    int i = 0;
+
+    for (; (i + 8) <= count; i += 8)
     {
-        overscan_content_h = GS_RESOLUTION_MAX_WIDTH;
-        overscan_h_l = GS_RESOLUTION_SMS_OVERSCAN_H_284_L;
-        overscan_total_width = overscan_content_h + overscan_h_l + GS_RESOLUTION_SMS_OVERSCAN_H_284_R;
+        uint16x8_t color = vld1q_u16(src + i);
+        uint16x8_t first = ScaleChannelNEON(vandq_u16(vshlq_u16(color, shift_first), mask), c.scale);
+        uint16x8_t green = ScaleChannelNEON(vandq_u16(vshlq_u16(color, shift_g), mask), c.scale_g);
+        uint16x8_t last = ScaleChannelNEON(vandq_u16(vshlq_u16(color, shift_last), mask), c.scale);
+        uint16x8_t result = vorrq_u16(vshlq_u16(first, out_shift), vshlq_n_u16(green, 5));
+        vst1q_u16(dst + i, vorrq_u16(result, last));
     }
 
-    for (int i = 0, j = 0; j < buffer_size; j += 3)
+    ConvertLine16Scalar(src + i, dst + i, count - i, c);
+}
+
+static inline uint8x8_t ScaleChannel8bitNEON(uint16x8_t value, const stPixelConversion& c)
+{
+    uint16x8_t fix = vandq_u16(vceqq_u16(value, vdupq_n_u16(5)), vdupq_n_u16(c.fix));
+    return vmovn_u16(vaddq_u16(ScaleChannelNEON(value, c.scale), fix));
+}
+
+static void ConvertLine24NEON(const u16* src, u8* dst, int count, const stPixelConversion& c)
+{
+    const uint16x8_t mask = vdupq_n_u16(c.mask);
+    const int16x8_t shift_first = vdupq_n_s16(-c.shift_first);
+    const int16x8_t shift_g = vdupq_n_s16(-c.shift_g);
+    const int16x8_t shift_last = vdupq_n_s16(-c.shift_last);
+    int i = 0;
+
+    for (; (i + 8) <= count; i += 8)
     {
-        u16 src_color = 0;
-        if (overscan_enabled)
-        {
-            bool is_h_overscan = (overscan_h_l > 0) && (x < overscan_h_l || x >= (overscan_h_l + overscan_content_h));
-            bool is_v_overscan = (overscan_v > 0) && (y < overscan_v || y >= (overscan_v + overscan_content_v));
+        uint16x8_t color = vld1q_u16(src + i);
+        uint8x8x3_t pixels;
+        pixels.val[0] = ScaleChannel8bitNEON(vandq_u16(vshlq_u16(color, shift_first), mask), c);
+        pixels.val[1] = ScaleChannel8bitNEON(vandq_u16(vshlq_u16(color, shift_g), mask), c);
+        pixels.val[2] = ScaleChannel8bitNEON(vandq_u16(vshlq_u16(color, shift_last), mask), c);
+        vst3_u8(dst + (i * 3), pixels);
+    }
 
-            if (is_h_overscan || is_v_overscan)
-                src_color = m_bSG1000 ? overscan_color * 3 : overscan_color;
-            else
-                src_color = m_bSG1000 ? srcFrameBuffer[i++] * 3 : srcFrameBuffer[i++];
+    ConvertLine24Scalar(src + i, dst + (i * 3), count - i, c);
+}
 
-            if (++x == overscan_total_width)
-            {
-                x = 0;
-                if (++y == overscan_total_height)
-                {
-                    y = 0;
-                }
-            }
-        }
-        else
-            src_color = m_bSG1000 ? srcFrameBuffer[i++] * 3 : srcFrameBuffer[i++];
+#endif
 
-        if (m_bSG1000)
+static ConvertLine16Func SelectConvertLine16(const stPixelConversion& c)
+{
+    if (c.sg1000)
+        return ConvertLine16SG1000;
+#if defined(GS_VIDEO_AVX2)
+    if (HasAVX2())
+        return ConvertLine16AVX2;
+#endif
+#if defined(GS_VIDEO_SSE2)
+    return ConvertLine16SSE2;
+#elif defined(GS_VIDEO_NEON)
+    return ConvertLine16NEON;
+#else
+    return ConvertLine16Scalar;
+#endif
+}
+
+static ConvertLine24Func SelectConvertLine24(const stPixelConversion& c)
+{
+    if (c.sg1000)
+        return ConvertLine24SG1000;
+#if defined(GS_VIDEO_SSE2)
+    return ConvertLine24SSE2;
+#elif defined(GS_VIDEO_NEON)
+    return ConvertLine24NEON;
+#else
+    return ConvertLine24Scalar;
+#endif
+}
+
+void Video::GetOverscanLayout(bool overscan, OverscanLayout& layout)
+{
+    layout.enabled = false;
+    layout.left = 0;
+    layout.width = GS_RESOLUTION_MAX_WIDTH;
+    layout.right = 0;
+    layout.top = 0;
+    layout.height = 0;
+
+    if (m_bGameGear || !overscan || (m_Overscan == OverscanDisabled))
+        return;
+
+    layout.enabled = true;
+    layout.height = m_bExtendedMode224 ? GS_RESOLUTION_SMS_HEIGHT_EXTENDED : GS_RESOLUTION_SMS_HEIGHT;
+    layout.top = m_bPAL ? GS_RESOLUTION_SMS_OVERSCAN_V_PAL : GS_RESOLUTION_SMS_OVERSCAN_V;
+    layout.top -= m_bExtendedMode224 ? 16 : 0;
+
+    if (m_Overscan == OverscanFull320)
+    {
+        layout.left = GS_RESOLUTION_SMS_OVERSCAN_H_320_L;
+        layout.right = GS_RESOLUTION_SMS_OVERSCAN_H_320_R;
+    }
+    else if (m_Overscan == OverscanFull284)
+    {
+        layout.left = GS_RESOLUTION_SMS_OVERSCAN_H_284_L;
+        layout.right = GS_RESOLUTION_SMS_OVERSCAN_H_284_R;
+    }
+}
+
+void Video::SetupPixelConversion(GS_Color_Format pixelFormat, stPixelConversion& conversion)
+{
+    bool bgr = (pixelFormat == GS_PIXEL_BGR888) || (pixelFormat == GS_PIXEL_BGR555) || (pixelFormat == GS_PIXEL_BGR565);
+    bool green_6bit = (pixelFormat == GS_PIXEL_RGB565) || (pixelFormat == GS_PIXEL_BGR565);
+    bool is_24bit = (pixelFormat == GS_PIXEL_RGB888) || (pixelFormat == GS_PIXEL_BGR888);
+    int shift_b = m_bGameGear ? 8 : 4;
+
+    conversion.sg1000 = m_bSG1000;
+    conversion.mask = m_bGameGear ? 0x0F : 0x03;
+    conversion.shift_first = bgr ? shift_b : 0;
+    conversion.shift_g = m_bGameGear ? 4 : 2;
+    conversion.shift_last = bgr ? 0 : shift_b;
+    conversion.out_shift = green_6bit ? 11 : 10;
+    conversion.fix = 0;
+
+    // Each kXbitToYbit table is exactly (value * mul + add) >> shift, which
+    // is what the SIMD kernels evaluate. k4bitTo8bit has 86 instead of 85 at
+    // index 5, so that single entry gets a fix up.
+    if (is_24bit)
+    {
+        conversion.lut = m_bGameGear ? k4bitTo8bit : k2bitTo8bit;
+        conversion.lut_g = conversion.lut;
+        conversion.scale = m_bGameGear ? kScale4bitTo8bit : kScale2bitTo8bit;
+        conversion.scale_g = conversion.scale;
+        conversion.fix = m_bGameGear ? 1 : 0;
+    }
+    else
+    {
+        conversion.lut = m_bGameGear ? k4bitTo5bit : k2bitTo5bit;
+        conversion.scale = m_bGameGear ? kScale4bitTo5bit : kScale2bitTo5bit;
+
+        if (green_6bit)
         {
-            dstFrameBuffer[j + 0] = bgr ? sg1000_palette[src_color + 2] : sg1000_palette[src_color];
-            dstFrameBuffer[j + 1] = sg1000_palette[src_color + 1];
-            dstFrameBuffer[j + 2] = bgr ? sg1000_palette[src_color] : sg1000_palette[src_color + 2];
+            conversion.lut_g = m_bGameGear ? k4bitTo6bit : k2bitTo6bit;
+            conversion.scale_g = m_bGameGear ? kScale4bitTo6bit : kScale2bitTo6bit;
         }
         else
         {
-            dstFrameBuffer[j + 0] = lut[bgr ? (src_color >> shift_b) & mask : src_color & mask];
-            dstFrameBuffer[j + 1] = lut[(src_color >> shift_g) & mask];
-            dstFrameBuffer[j + 2] = lut[bgr ? src_color & mask : (src_color >> shift_b) & mask];
+            conversion.lut_g = conversion.lut;
+            conversion.scale_g = conversion.scale;
         }
     }
-}
 
-void Video::Render16bit(u16* srcFrameBuffer, u8* dstFrameBuffer, GS_Color_Format pixelFormat, int size, bool overscan)
-{
-    int x = 0;
-    int y = 0;
-    int overscan_h_l = 0;
-    int overscan_v = 0;
-    int overscan_content_v = 0;
-    int overscan_content_h = 0;
-    int overscan_total_width = GS_RESOLUTION_MAX_WIDTH;
-    int overscan_total_height = 0;
-    bool overscan_enabled = false;
-    int overscan_color = m_bSG1000 ? m_VdpRegister[7] & 0x0F : ColorFromPalette((m_VdpRegister[7] & 0x0F) + 16);
-    int buffer_size = size * 2;    
-    int shift_g = m_bGameGear ? 4 : 2;
-    int shift_b = m_bGameGear ? 8 : 4;
-    int mask = m_bGameGear ? 0x0F : 0x03;
-    bool bgr = ((pixelFormat == GS_PIXEL_BGR555) || (pixelFormat == GS_PIXEL_BGR565));
-    bool green_6bit = (pixelFormat == GS_PIXEL_RGB565) || (pixelFormat == GS_PIXEL_BGR565);
-    const u8* lut = m_bGameGear ? k4bitTo5bit : k2bitTo5bit;
-    const u8* lut_g = m_bGameGear ? (green_6bit ? k4bitTo6bit : k4bitTo5bit) : (green_6bit ? k2bitTo6bit : k2bitTo5bit);
-    int shift = green_6bit ? 11 : 10;
-    const u16* pal;
+    conversion.sg1000_first = bgr ? 2 : 0;
+    conversion.sg1000_last = bgr ? 0 : 2;
+    conversion.sg1000_palette_24 = m_pCartridge->IsSG1000() ? kSG1000_palette_888_normal : kSG1000_palette_888_sms;
 
     if (m_pCartridge->IsSG1000())
     {
         if (bgr)
-            pal = green_6bit ? m_SG1000_palette_565_bgr_normal : m_SG1000_palette_555_bgr_normal;
+            conversion.sg1000_palette_16 = green_6bit ? m_SG1000_palette_565_bgr_normal : m_SG1000_palette_555_bgr_normal;
         else
-            pal = green_6bit ? m_SG1000_palette_565_rgb_normal : m_SG1000_palette_555_rgb_normal;
+            conversion.sg1000_palette_16 = green_6bit ? m_SG1000_palette_565_rgb_normal : m_SG1000_palette_555_rgb_normal;
     }
     else
     {
         if (bgr)
-            pal = green_6bit ? m_SG1000_palette_565_bgr_sms : m_SG1000_palette_555_bgr_sms;
+            conversion.sg1000_palette_16 = green_6bit ? m_SG1000_palette_565_bgr_sms : m_SG1000_palette_555_bgr_sms;
         else
-            pal = green_6bit ? m_SG1000_palette_565_rgb_sms : m_SG1000_palette_555_rgb_sms;
+            conversion.sg1000_palette_16 = green_6bit ? m_SG1000_palette_565_rgb_sms : m_SG1000_palette_555_rgb_sms;
     }
+}
 
-    if (m_bGameGear)
-        overscan = false;
+void Video::Render24bit(u16* srcFrameBuffer, u8* dstFrameBuffer, GS_Color_Format pixelFormat, int size, bool overscan, bool skipCleanLines)
+{
+    stPixelConversion conversion;
+    SetupPixelConversion(pixelFormat, conversion);
 
-    if (overscan && (m_Overscan != OverscanDisabled))
-    {
-        overscan_enabled = true;
-        overscan_content_v = m_bExtendedMode224 ? GS_RESOLUTION_SMS_HEIGHT_EXTENDED : GS_RESOLUTION_SMS_HEIGHT;
-        overscan_v = m_bPAL ? GS_RESOLUTION_SMS_OVERSCAN_V_PAL : GS_RESOLUTION_SMS_OVERSCAN_V;
-        overscan_v -= m_bExtendedMode224 ? 16 : 0;
-        overscan_total_height = overscan_content_v + (overscan_v * 2);
-    }
+    ConvertLine24Func convert = SelectConvertLine24(conversion);
 
-    if (overscan && (m_Overscan == OverscanFull320))
-    {
-        overscan_content_h = GS_RESOLUTION_MAX_WIDTH;
-        overscan_h_l = GS_RESOLUTION_SMS_OVERSCAN_H_320_L;
-        overscan_total_width = overscan_content_h + overscan_h_l + GS_RESOLUTION_SMS_OVERSCAN_H_320_R;
-    }
+    OverscanLayout layout;
+    GetOverscanLayout(overscan, layout);
+
+    skipCleanLines = skipCleanLines && (srcFrameBuffer == m_pFrameBuffer);
+    bool same_target = skipCleanLines && IsSameRenderTarget(dstFrameBuffer, pixelFormat, size, layout);
 
-    if (overscan && (m_Overscan == OverscanFull284))
+    if (!layout.enabled)
     {
-        overscan_content_h = GS_RESOLUTION_MAX_WIDTH;
-        overscan_h_l = GS_RESOLUTION_SMS_OVERSCAN_H_284_L;
-        overscan_total_width = overscan_content_h + overscan_h_l + GS_RESOLUTION_SMS_OVERSCAN_H_284_R;
+        if (!skipCleanLines)
+        {
+            convert(srcFrameBuffer, dstFrameBuffer, size, conversion);
+            return;
+        }
+
+        for (int offset = 0; offset < size; offset += m_iScreenWidth)
+        {
+            int count = std::min(m_iScreenWidth, size - offset);
+
+            if (IsLineDirty(srcFrameBuffer + offset, count, same_target))
+                convert(srcFrameBuffer + offset, dstFrameBuffer + (offset * 3), count, conversion);
+        }
+        return;
     }
 
-    for (int i = 0, j = 0; j < buffer_size; j += 2)
+    u16 overscan_color = m_bSG1000 ? m_VdpRegister[7] & 0x0F : ColorFromPalette((m_VdpRegister[7] & 0x0F) + 16);
+    u8 border[3];
+    convert(&overscan_color, border, 1, conversion);
+
+    int total_height = layout.height + (layout.top * 2);
+    int remaining = size;
+    int y = 0;
+
+    while (remaining > 0)
     {
-        u16 src_color = 0;
-        if (overscan_enabled)
-        {
-            bool is_h_overscan = (overscan_h_l > 0) && (x < overscan_h_l || x >= (overscan_h_l + overscan_content_h));
-            bool is_v_overscan = (overscan_v > 0) && (y < overscan_v || y >= (overscan_v + overscan_content_v));
+        bool v_overscan = (layout.top > 0) && ((y < layout.top) || (y >= (layout.top + layout.height)));
+        int segments[3] = { layout.left, layout.width, layout.right };
 
-            if (is_h_overscan || is_v_overscan)
-                src_color = overscan_color;
-            else
-                src_color = srcFrameBuffer[i++];
+        for (int s = 0; (s < 3) && (remaining > 0); s++)
+        {
+            int count = std::min(segments[s], remaining);
 
-            if (++x == overscan_total_width)
+            if (v_overscan || (s != 1))
             {
-                x = 0;
-                if (++y == overscan_total_height)
+                for (int x = 0; x < count; x++)
                 {
-                    y = 0;
+                    dstFrameBuffer[0] = border[0];
+                    dstFrameBuffer[1] = border[1];
+                    dstFrameBuffer[2] = border[2];
+                    dstFrameBuffer += 3;
                 }
             }
+            else
+            {
+                if (!skipCleanLines || IsLineDirty(srcFrameBuffer, count, same_target))
+                    convert(srcFrameBuffer, dstFrameBuffer, count, conversion);
+                srcFrameBuffer += count;
+                dstFrameBuffer += count * 3;
+            }
+
+            remaining -= count;
         }
-        else
-            src_color = srcFrameBuffer[i++];
 
-        if (m_bSG1000)
+        if (++y == total_height)
+            y = 0;
+    }
+}
+
+void Video::Render16bit(u16* srcFrameBuffer, u8* dstFrameBuffer, GS_Color_Format pixelFormat, int size, bool overscan, bool skipCleanLines)
+{
+    stPixelConversion conversion;
+    SetupPixelConversion(pixelFormat, conversion);
+
+    ConvertLine16Func convert = SelectConvertLine16(conversion);
+    u16* dst = reinterpret_cast<u16*>(dstFrameBuffer);
+
+    OverscanLayout layout;
+    GetOverscanLayout(overscan, layout);
+
+    skipCleanLines = skipCleanLines && (srcFrameBuffer == m_pFrameBuffer);
+    bool same_target = skipCleanLines && IsSameRenderTarget(dstFrameBuffer, pixelFormat, size, layout);
+
+    if (!layout.enabled)
+    {
+        if (!skipCleanLines)
         {
-            *(u16*)(&dstFrameBuffer[j]) = pal[src_color];
+            convert(srcFrameBuffer, dst, size, conversion);
+            return;
         }
-        else
+
+        for (int offset = 0; offset < size; offset += m_iScreenWidth)
+        {
+            int count = std::min(m_iScreenWidth, size - offset);
+
+            if (IsLineDirty(srcFrameBuffer + offset, count, same_target))
+                convert(srcFrameBuffer + offset, dst + (offset), count, conversion);
+        }
+        return;
+    }
+
+    u16 overscan_color = m_bSG1000 ? m_VdpRegister[7] & 0x0F : ColorFromPalette((m_VdpRegister[7] & 0x0F) + 16);
+    u16 border = 0;
+    convert(&overscan_color, &border, 1, conversion);
+
+    int total_height = layout.height + (layout.top * 2);
+    int remaining = size;
+    int y = 0;
+
+    while (remaining > 0)
+    {
+        bool v_overscan = (layout.top > 0) && ((y < layout.top) || (y >= (layout.top + layout.height)));
+        int segments[3] = { layout.left, layout.width, layout.right };
+
+        for (int s = 0; (s < 3) && (remaining > 0); s++)
         {
-            u8 red, green, blue;
+            int count = std::min(segments[s], remaining);
 
-            red = bgr ? (src_color >> shift_b) & mask : src_color & mask;
-            green = (src_color >> shift_g) & mask;
-            blue = bgr ? src_color & mask : (src_color >> shift_b) & mask;
+            if (v_overscan || (s != 1))
+                std::fill_n(dst, count, border);
+            else
+            {
+                if (!skipCleanLines || IsLineDirty(srcFrameBuffer, count, same_target))
+                    convert(srcFrameBuffer, dst, count, conversion);
+                srcFrameBuffer += count;
+            }
 
-            *(u16*)(&dstFrameBuffer[j]) = (lut[red] << shift) | (lut_g[green] << 5) | lut[blue];
+            dst += count;
+            remaining -= count;
         }
+
+        if (++y == total_height)
+            y = 0;
+    }
+}
+
+bool Video::IsSameRenderTarget(u8* dstFrameBuffer, GS_Color_Format pixelFormat, int size, const OverscanLayout& layout)
+{
+    RenderTarget target;
+    target.buffer = dstFrameBuffer;
+    target.format = pixelFormat;
+    target.size = size;
+    target.game_gear = m_bGameGear;
+    target.sg1000 = m_bSG1000;
+    target.sg1000_palette = m_pCartridge->IsSG1000();
+    target.layout = layout;
+
+    const RenderTarget& last = m_LastRenderTarget;
+
+    bool same = (target.buffer == last.buffer) && (target.format == last.format) &&
+            (target.size == last.size) && (target.game_gear == last.game_gear) &&
+            (target.sg1000 == last.sg1000) && (target.sg1000_palette == last.sg1000_palette) &&
+            (target.layout.enabled == last.layout.enabled) && (target.layout.left == last.layout.left) &&
+            (target.layout.width == last.layout.width) && (target.layout.top == last.layout.top) &&
+            (target.layout.height == last.layout.height);
+
+    m_LastRenderTarget = target;
+
+    return same;
+}
+
+// Forgets the last destination so the next render converts every line, for
+// when something else may have written into that buffer since
+void Video::InvalidateRenderTarget()
+{
+    InitPointer(m_LastRenderTarget.buffer);
+}
+
+bool Video::HasRenderTarget()
+{
+    return IsValidPointer(m_LastRenderTarget.buffer);
+}
+
+// A line only needs converting again when it differs from the copy kept at
+// its last conversion, or when the destination may not hold that result
+bool Video::IsLineDirty(const u16* src, int count, bool sameTarget)
+{
+    u16* previous = m_pPreviousFrameBuffer + (src - m_pFrameBuffer);
+    size_t bytes = count * sizeof(u16);
+
+    if (sameTarget && (memcmp(previous, src, bytes) == 0))
+        return false;
+
+    memcpy(previous, src, bytes);
+    return true;
+}
+
+// Lets the VDP draw straight into a buffer owned by the caller, which must
+// hold GS_RESOLUTION_MAX_WIDTH * GS_RESOLUTION_MAX_HEIGHT pixels. Passing NULL
+// goes back to the internal buffer.
+void Video::SetFrameBuffer(u16* pFrameBuffer)
+{
+    m_pFrameBuffer = IsValidPointer(pFrameBuffer) ? pFrameBuffer : m_pInternalFrameBuffer;
+}
+
+void Video::GetFrameView(GS_FrameView& view)
+{
+    view.buffer = m_pFrameBuffer;
+    view.width = m_iScreenWidth;
+    view.height = m_bGameGear ? GS_RESOLUTION_GG_HEIGHT : (m_bExtendedMode224 ? GS_RESOLUTION_SMS_HEIGHT_EXTENDED : GS_RESOLUTION_SMS_HEIGHT);
+    view.pitch = m_iScreenWidth;
+    view.cram = m_pVdpCRAM;
+    view.cram_size = m_bGameGear ? 0x40 : 0x20;
+
+    if (m_bSG1000)
+    {
+        view.format = GS_NATIVE_SG1000;
+        view.palette = m_pCartridge->IsSG1000() ? kSG1000_palette_888_normal : kSG1000_palette_888_sms;
+        view.backdrop = m_VdpRegister[7] & 0x0F;
+    }
+    else
+    {
+        view.format = m_bGameGear ? GS_NATIVE_GG : GS_NATIVE_SMS;
+        InitPointer(view.palette);
+        view.backdrop = ColorFromPalette((m_VdpRegister[7] & 0x0F) + 16);
     }
 }
 
@@ -1133,76 +1888,76 @@ void Video::InitPalettes(const u8* src, u16* dest_565_rgb, u16* dest_555_rgb, u1
     }
 }
 
-void Video::SaveState(std::ostream& stream)
-{
-    using namespace std;
-
-    stream.write(reinterpret_cast<const char*> (m_pInfoBuffer), GS_RESOLUTION_MAX_WIDTH * GS_LINES_PER_FRAME_PAL);
-    stream.write(reinterpret_cast<const char*> (m_pVdpVRAM), 0x4000);
-    stream.write(reinterpret_cast<const char*> (m_pVdpCRAM), 0x40);
-    stream.write(reinterpret_cast<const char*> (&m_bFirstByteInSequence), sizeof(m_bFirstByteInSequence));
-    stream.write(reinterpret_cast<const char*> (m_VdpRegister), sizeof(m_VdpRegister));
-    stream.write(reinterpret_cast<const char*> (&m_VdpCode), sizeof(m_VdpCode));
-    stream.write(reinterpret_cast<const char*> (&m_VdpBuffer), sizeof(m_VdpBuffer));
-    stream.write(reinterpret_cast<const char*> (&m_VdpAddress), sizeof(m_VdpAddress));
-    stream.write(reinterpret_cast<const char*> (&m_iVCounter), sizeof(m_iVCounter));
-    stream.write(reinterpret_cast<const char*> (&m_iHCounter), sizeof(m_iHCounter));
-    stream.write(reinterpret_cast<const char*> (&m_iCycleCounter), sizeof(m_iCycleCounter));
-    stream.write(reinterpret_cast<const char*> (&m_VdpStatus), sizeof(m_VdpStatus));
-    stream.write(reinterpret_cast<const char*> (&m_iVdpRegister10Counter), sizeof(m_iVdpRegister10Counter));
-    stream.write(reinterpret_cast<const char*> (&m_ScrollX), sizeof(m_ScrollX));
-    stream.write(reinterpret_cast<const char*> (&m_ScrollY), sizeof(m_ScrollY));
-    stream.write(reinterpret_cast<const char*> (&m_iLinesPerFrame), sizeof(m_iLinesPerFrame));
+void Video::SaveState(StateWriter& state)
+{
+    state.Write(m_pInfoBuffer, GS_RESOLUTION_MAX_WIDTH * GS_LINES_PER_FRAME_PAL);
+    state.Write(m_pVdpVRAM, 0x4000);
+    state.Write(m_pVdpCRAM, 0x40);
+    state.Write(&m_bFirstByteInSequence, sizeof(m_bFirstByteInSequence));
+    state.Write(m_VdpRegister, sizeof(m_VdpRegister));
+    state.Write(&m_VdpCode, sizeof(m_VdpCode));
+    state.Write(&m_VdpBuffer, sizeof(m_VdpBuffer));
+    state.Write(&m_VdpAddress, sizeof(m_VdpAddress));
+    state.Write(&m_iVCounter, sizeof(m_iVCounter));
+    state.Write(&m_iHCounter, sizeof(m_iHCounter));
+    state.Write(&m_iCycleCounter, sizeof(m_iCycleCounter));
+    state.Write(&m_VdpStatus, sizeof(m_VdpStatus));
+    state.Write(&m_iVdpRegister10Counter, sizeof(m_iVdpRegister10Counter));
+    state.Write(&m_ScrollX, sizeof(m_ScrollX));
+    state.Write(&m_ScrollY, sizeof(m_ScrollY));
+    state.Write(&m_iLinesPerFrame, sizeof(m_iLinesPerFrame));
     bool bogus = false;
-    stream.write(reinterpret_cast<const char*> (&bogus), sizeof(bogus));
-    stream.write(reinterpret_cast<const char*> (&m_bExtendedMode224), sizeof(m_bExtendedMode224));
-    stream.write(reinterpret_cast<const char*> (&m_LineEvents), sizeof(m_LineEvents));
-    stream.write(reinterpret_cast<const char*> (&m_iRenderLine), sizeof(m_iRenderLine));
-
-    stream.write(reinterpret_cast<const char*> (&m_bGameGear), sizeof(m_bGameGear));
-    stream.write(reinterpret_cast<const char*> (&m_bPAL), sizeof(m_bPAL));
-    stream.write(reinterpret_cast<const char*> (&m_iScreenWidth), sizeof(m_iScreenWidth));
-    stream.write(reinterpret_cast<const char*> (&m_bSG1000), sizeof(m_bSG1000));
-    stream.write(reinterpret_cast<const char*> (&m_iSG1000Mode), sizeof(m_iSG1000Mode));
-    stream.write(reinterpret_cast<const char*> (&m_Timing), sizeof(m_Timing));
-    stream.write(reinterpret_cast<const char*> (&m_NextLineSprites), sizeof(m_NextLineSprites));
-    stream.write(reinterpret_cast<const char*> (&m_bDisplayEnabled), sizeof(m_bDisplayEnabled));
-    stream.write(reinterpret_cast<const char*> (&m_bSpriteOvrRequest), sizeof(m_bSpriteOvrRequest));
-}
-
-void Video::LoadState(std::istream& stream)
-{
-    using namespace std;
-
-    stream.read(reinterpret_cast<char*> (m_pInfoBuffer), GS_RESOLUTION_MAX_WIDTH * GS_LINES_PER_FRAME_PAL);
-    stream.read(reinterpret_cast<char*> (m_pVdpVRAM), 0x4000);
-    stream.read(reinterpret_cast<char*> (m_pVdpCRAM), 0x40);
-    stream.read(reinterpret_cast<char*> (&m_bFirstByteInSequence), sizeof(m_bFirstByteInSequence));
-    stream.read(reinterpret_cast<char*> (m_VdpRegister), sizeof(m_VdpRegister));
-    stream.read(reinterpret_cast<char*> (&m_VdpCode), sizeof(m_VdpCode));
-    stream.read(reinterpret_cast<char*> (&m_VdpBuffer), sizeof(m_VdpBuffer));
-    stream.read(reinterpret_cast<char*> (&m_VdpAddress), sizeof(m_VdpAddress));
-    stream.read(reinterpret_cast<char*> (&m_iVCounter), sizeof(m_iVCounter));
-    stream.read(reinterpret_cast<char*> (&m_iHCounter), sizeof(m_iHCounter));
-    stream.read(reinterpret_cast<char*> (&m_iCycleCounter), sizeof(m_iCycleCounter));
-    stream.read(reinterpret_cast<char*> (&m_VdpStatus), sizeof(m_VdpStatus));
-    stream.read(reinterpret_cast<char*> (&m_iVdpRegister10Counter), sizeof(m_iVdpRegister10Counter));
-    stream.read(reinterpret_cast<char*> (&m_ScrollX), sizeof(m_ScrollX));
-    stream.read(reinterpret_cast<char*> (&m_ScrollY), sizeof(m_ScrollY));
-    stream.read(reinterpret_cast<char*> (&m_iLinesPerFrame), sizeof(m_iLinesPerFrame));
+    state.Write(&bogus, sizeof(bogus));
+    state.Write(&m_bExtendedMode224, sizeof(m_bExtendedMode224));
+    state.Write(&m_LineEvents, sizeof(m_LineEvents));
+    state.Write(&m_iRenderLine, sizeof(m_iRenderLine));
+
+    state.Write(&m_bGameGear, sizeof(m_bGameGear));
+    state.Write(&m_bPAL, sizeof(m_bPAL));
+    state.Write(&m_iScreenWidth, sizeof(m_iScreenWidth));
+    state.Write(&m_bSG1000, sizeof(m_bSG1000));
+    state.Write(&m_iSG1000Mode, sizeof(m_iSG1000Mode));
+    state.Write(&m_Timing, sizeof(m_Timing));
+    state.Write(&m_NextLineSprites, sizeof(m_NextLineSprites));
+    state.Write(&m_bDisplayEnabled, sizeof(m_bDisplayEnabled));
+    state.Write(&m_bSpriteOvrRequest, sizeof(m_bSpriteOvrRequest));
+}
+
+void Video::LoadState(StateReader& state)
+{
+    state.Read(m_pInfoBuffer, GS_RESOLUTION_MAX_WIDTH * GS_LINES_PER_FRAME_PAL);
+    state.Read(m_pVdpVRAM, 0x4000);
+    InvalidateTileCache();
+    InvalidateSpriteCache();
+    state.Read(m_pVdpCRAM, 0x40);
+    state.Read(&m_bFirstByteInSequence, sizeof(m_bFirstByteInSequence));
+    state.Read(m_VdpRegister, sizeof(m_VdpRegister));
+    state.Read(&m_VdpCode, sizeof(m_VdpCode));
+    state.Read(&m_VdpBuffer, sizeof(m_VdpBuffer));
+    state.Read(&m_VdpAddress, sizeof(m_VdpAddress));
+    state.Read(&m_iVCounter, sizeof(m_iVCounter));
+    state.Read(&m_iHCounter, sizeof(m_iHCounter));
+    state.Read(&m_iCycleCounter, sizeof(m_iCycleCounter));
+    state.Read(&m_VdpStatus, sizeof(m_VdpStatus));
+    state.Read(&m_iVdpRegister10Counter, sizeof(m_iVdpRegister10Counter));
+    state.Read(&m_ScrollX, sizeof(m_ScrollX));
+    state.Read(&m_ScrollY, sizeof(m_ScrollY));
+    state.Read(&m_iLinesPerFrame, sizeof(m_iLinesPerFrame));
     bool bogus;
-    stream.read(reinterpret_cast<char*> (&bogus), sizeof(bogus));
-    stream.read(reinterpret_cast<char*> (&m_bExtendedMode224), sizeof(m_bExtendedMode224));
-    stream.read(reinterpret_cast<char*> (&m_LineEvents), sizeof(m_LineEvents));
-    stream.read(reinterpret_cast<char*> (&m_iRenderLine), sizeof(m_iRenderLine));
-
-    stream.read(reinterpret_cast<char*> (&m_bGameGear), sizeof(m_bGameGear));
-    stream.read(reinterpret_cast<char*> (&m_bPAL), sizeof(m_bPAL));
-    stream.read(reinterpret_cast<char*> (&m_iScreenWidth), sizeof(m_iScreenWidth));
-    stream.read(reinterpret_cast<char*> (&m_bSG1000), sizeof(m_bSG1000));
-    stream.read(reinterpret_cast<char*> (&m_iSG1000Mode), sizeof(m_iSG1000Mode));
-    stream.read(reinterpret_cast<char*> (&m_Timing), sizeof(m_Timing));
-    stream.read(reinterpret_cast<char*> (&m_NextLineSprites), sizeof(m_NextLineSprites));
-    stream.read(reinterpret_cast<char*> (&m_bDisplayEnabled), sizeof(m_bDisplayEnabled));
-    stream.read(reinterpret_cast<char*> (&m_bSpriteOvrRequest), sizeof(m_bSpriteOvrRequest));
+    state.Read(&bogus, sizeof(bogus));
+    state.Read(&m_bExtendedMode224, sizeof(m_bExtendedMode224));
+    state.Read(&m_LineEvents, sizeof(m_LineEvents));
+    state.Read(&m_iRenderLine, sizeof(m_iRenderLine));
+
+    state.Read(&m_bGameGear, sizeof(m_bGameGear));
+    state.Read(&m_bPAL, sizeof(m_bPAL));
+    state.Read(&m_iScreenWidth, sizeof(m_iScreenWidth));
+    state.Read(&m_bSG1000, sizeof(m_bSG1000));
+    state.Read(&m_iSG1000Mode, sizeof(m_iSG1000Mode));
+    state.Read(&m_Timing, sizeof(m_Timing));
+    state.Read(&m_NextLineSprites, sizeof(m_NextLineSprites));
+    state.Read(&m_bDisplayEnabled, sizeof(m_bDisplayEnabled));
+    state.Read(&m_bSpriteOvrRequest, sizeof(m_bSpriteOvrRequest));
+
+    m_iPendingCycles = 0;
 }
@@ -21,6 +21,7 @@
 #define	VIDEO_H
 
 #include "definitions.h"
+#include "StateSerializer.h"
 
 #define VDP_READ_VRAM_OPERATION 0x00
 #define VDP_WRITE_VRAM_OPERATION 0x01
@@ -31,6 +32,32 @@ class Memory;
 class Processor;
 class Cartridge;
 
+struct stChannelScale
+{
+    u16 mul;
+    u16 add;
+    u16 shift;
+};
+
+struct stPixelConversion
+{
+    bool sg1000;
+    int mask;
+    int shift_first;
+    int shift_g;
+    int shift_last;
+    int out_shift;
+    int fix;
+    const u8* lut;
+    const u8* lut_g;
+    stChannelScale scale;
+    stChannelScale scale_g;
+    int sg1000_first;
+    int sg1000_last;
+    const u8* sg1000_palette_24;
+    const u16* sg1000_palette_16;
+};
+
 class Video
 {
 public:
@@ -48,6 +75,9 @@ public:
     void Init();
     void Reset(bool bGameGear, bool bPAL);
     bool Tick(unsigned int clockCycles);
+    void AddPendingCycles(unsigned int clockCycles);
+    bool Sync();
+    unsigned int GetCyclesToNextEvent();
     u8 GetVCounter();
     u8 GetHCounter();
     u8 GetDataPort();
@@ -57,26 +87,74 @@ public:
     void WriteData(u8 data);
     void WriteControl(u8 control);
     void LatchHCounter();
-    void SaveState(std::ostream& stream);
-    void LoadState(std::istream& stream);
+    void SaveState(StateWriter& state);
+    void LoadState(StateReader& state);
     u8* GetVRAM();
     u8* GetCRAM();
     u8* GetRegisters();
     int GetSG1000Mode();
     u16 ColorFromPalette(int palette_color);
     u16* GetFrameBuffer();
-    void Render24bit(u16* srcFrameBuffer, u8* dstFrameBuffer, GS_Color_Format pixelFormat, int size, bool overscan = false);
-    void Render16bit(u16* srcFrameBuffer, u8* dstFrameBuffer, GS_Color_Format pixelFormat, int size, bool overscan = false);
+    void SetFrameBuffer(u16* pFrameBuffer);
+    void GetFrameView(GS_FrameView& view);
+    void Render24bit(u16* srcFrameBuffer, u8* dstFrameBuffer, GS_Color_Format pixelFormat, int size, bool overscan = false, bool skipCleanLines = false);
+    void Render16bit(u16* srcFrameBuffer, u8* dstFrameBuffer, GS_Color_Format pixelFormat, int size, bool overscan = false, bool skipCleanLines = false);
     void SetOverscan(Overscan overscan);
     Overscan GetOverscan();
+    void InvalidateTileCache();
+    void InvalidateSpriteCache();
+    void SetSkipRender(bool skip);
+    bool IsSkipRenderEnabled();
+    void InvalidateRenderTarget();
+    bool HasRenderTarget();
+
+private:
+    struct OverscanLayout
+    {
+        bool enabled;
+        int left;
+        int width;
+        int right;
+        int top;
+        int height;
+    };
+
+    struct RenderTarget
+    {
+        u8* buffer;
+        GS_Color_Format format;
+        int size;
+        bool game_gear;
+        bool sg1000;
+        bool sg1000_palette;
+        OverscanLayout layout;
+    };
+
+    struct SpriteLine
+    {
+        u8 count;
+        bool overflow;
+        u8 sprites[8];
+    };
 
 private:
     void ScanLine(int line);
     void RenderBackgroundSMSGG(int line);
     void RenderBackgroundSG1000(int line);
     void ParseSpritesSMSGG(int line);
+    void UpdateSpriteLines();
+    void AddSpriteToLines(int sprite, int first_line, int height);
+    void EvaluateSpritesSMSGG(int line);
     void RenderSpritesSMSGG(int line);
+    void MarkSpritePixelsSMSGG(int line);
     void RenderSpritesSG1000(int line);
+    const u8* GetTileRow(int tile, int row, bool hflip);
+    void SetupPixelConversion(GS_Color_Format pixelFormat, stPixelConversion& conversion);
+    void GetOverscanLayout(bool overscan, OverscanLayout& layout);
+    bool IsSameRenderTarget(u8* dstFrameBuffer, GS_Color_Format pixelFormat, int size, const OverscanLayout& layout);
+    bool IsLineDirty(const u16* src, int count, bool sameTarget);
+    void DecodeTile(int tile);
+    void InitSpriteMasks();
     void InitPalettes(const u8* src, u16* dest_565_rgb, u16* dest_555_rgb, u16* dest_565_bgr, u16* dest_555_bgr);
 
 private:
@@ -85,6 +163,7 @@ private:
     Cartridge* m_pCartridge;
     u8* m_pInfoBuffer;
     u16* m_pFrameBuffer;
+    u16* m_pInternalFrameBuffer;
     u8* m_pVdpVRAM;
     u8* m_pVdpCRAM;
     bool m_bFirstByteInSequence;
@@ -95,6 +174,7 @@ private:
     int m_iVCounter;
     int m_iHCounter;
     int m_iCycleCounter;
+    unsigned int m_iPendingCycles;
     u8 m_VdpStatus;
     int m_iVdpRegister10Counter;
     u8 m_ScrollX;
@@ -139,6 +219,29 @@ private:
     int m_NextLineSprites[8];
     bool m_bDisplayEnabled;
     bool m_bSpriteOvrRequest;
+    bool m_bSkipRender;
+
+    // Decoded 4bpp tile rows, one color index per pixel: 512 tiles x 8 rows
+    // x 8 pixels for the normal variant, followed by the h-flipped one
+    u8* m_pTileCache;
+    bool m_TileDirty[512];
+
+    // Opaque pixels of a sprite pattern row indexed by its OR-ed bitplanes,
+    // bit 0 is the leftmost pixel. Normal and zoomed variants.
+    u16 m_SpriteRowMask[2][256];
+    // Opaque sprite pixels of the last evaluated line, one bit per pixel
+    u64 m_SpriteLineMask[4];
+
+    // Sprites on each line as ParseSpritesSMSGG would find them, rebuilt
+    // when the Y table changes or when the SAT address, the sprite size or
+    // the screen height do, which are packed in m_iSpriteLinesKey
+    SpriteLine m_SpriteLines[GS_LINES_PER_FRAME_PAL];
+    int m_iSpriteLinesKey;
+    bool m_bSpriteLinesDirty;
+
+    // Copy of the frame buffer as it was last converted to m_LastRenderTarget
+    u16* m_pPreviousFrameBuffer;
+    RenderTarget m_LastRenderTarget;
 
     u16 m_SG1000_palette_565_rgb_normal[16];
     u16 m_SG1000_palette_555_rgb_normal[16];
@@ -150,6 +253,11 @@ private:
     u16 m_SG1000_palette_555_bgr_sms[16];
 };
 
+inline void Video::AddPendingCycles(unsigned int clockCycles)
+{
+    m_iPendingCycles += clockCycles;
+}
+
 inline u8* Video::GetVRAM()
 {
     return m_pVdpVRAM;
@@ -188,6 +296,14 @@ inline u16* Video::GetFrameBuffer()
     return m_pFrameBuffer;
 }
 
+inline const u8* Video::GetTileRow(int tile, int row, bool hflip)
+{
+    if (m_TileDirty[tile])
+        DecodeTile(tile);
+
+    return m_pTileCache + (hflip ? 0x8000 : 0) + (tile << 6) + (row << 3);
+}
+
 const u8 kVdpHCounter[228] = {
 
   0xE9,0xEA,0xEA,0xEB,0xEC,0xED,0xED,0xEE,0xEF,0xF0,0xF0,0xF1,0xF2,0xF3,0xF3,0xF4,
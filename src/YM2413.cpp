@@ -19,43 +19,64 @@
 
 #include "YM2413.h"
 
+// emu2413 builds its shared lookup tables lazily on the first OPLL_new().
+// Creating that first chip inside a function local static runs it exactly
+// once, even when several cores are initialized from different threads.
+static bool InitOPLLTables()
+{
+    OPLL_delete(OPLL_new());
+    return true;
+}
+
 YM2413::YM2413()
 {
     InitPointer(m_pBuffer);
     InitPointer(m_pOPLL);
+    InitPointer(m_pOutput);
     m_iCycleCounter = 0;
-    m_iSampleCounter = 0;
+    m_iFrameCycles = 0;
     m_iBufferIndex = 0;
     m_ElapsedCycles = 0;
     m_iClockRate = 0;
     m_RegisterF2 = 0;
     m_CurrentSample = 0;
     m_bEnabled = false;
-    m_iCyclesPerSample = 0;
+    m_bSynthesis = true;
+    m_bOutputPending = false;
 }
 
 YM2413::~YM2413()
 {
     OPLL_delete(m_pOPLL);
     SafeDeleteArray(m_pBuffer);
+    SafeDelete(m_pOutput);
 }
 
 void YM2413::Init(int clockRate)
 {
+    static const bool tables_initialized = InitOPLLTables();
+    (void)tables_initialized;
+
     m_pBuffer = new s16[GS_AUDIO_BUFFER_SIZE];
+    for (int i = 0; i < GS_AUDIO_BUFFER_SIZE; i++)
+        m_pBuffer[i] = 0;
     m_pOPLL = OPLL_new();
     OPLL_setChipType(m_pOPLL, 0);
+
+    m_pOutput = new Blip_Buffer();
+    m_pOutput->set_sample_rate(GS_AUDIO_SAMPLE_RATE);
+    m_Synth.volume(1.0);
+
     Reset(clockRate);
 }
 
 void YM2413::Reset(int clockRate)
 {
     m_iClockRate = clockRate;
-    m_iCyclesPerSample = m_iClockRate / GS_AUDIO_SAMPLE_RATE;
     m_ElapsedCycles = 0;
     m_CurrentSample = 0;
     m_iCycleCounter = 0;
-    m_iSampleCounter = 0;
+    m_iFrameCycles = 0;
     m_iBufferIndex = 0;
     m_RegisterF2 = 0;
     m_CurrentSample = 0;
@@ -63,6 +84,11 @@ void YM2413::Reset(int clockRate)
 
     OPLL_reset(m_pOPLL);
 
+    m_pOutput->clock_rate(m_iClockRate);
+    m_pOutput->clear();
+    m_Synth.output(m_pOutput);
+    m_bOutputPending = false;
+
     for (int i = 0; i < GS_AUDIO_BUFFER_SIZE; i++)
     {
         m_pBuffer[i] = 0;
@@ -93,19 +119,33 @@ void YM2413::Tick(unsigned int clockCycles)
     m_ElapsedCycles += clockCycles;
 }
 
+// The chip output is resampled to GS_AUDIO_SAMPLE_RATE through a band-limited
+// buffer clocked at the master clock, the same way the PSG is, so both
+// produce the same amount of samples for a frame
 int YM2413::EndFrame(s16* pSampleBuffer)
 {
-    if (!m_bEnabled)
-    {
-        m_iBufferIndex = 0;
-        return 0;
-    }
-
     Sync();
 
     int ret = 0;
 
-    if (IsValidPointer(pSampleBuffer))
+    if (m_bOutputPending)
+    {
+        m_pOutput->end_frame(m_iFrameCycles);
+
+        int count = static_cast<int>(m_pOutput->read_samples(m_pBuffer, GS_AUDIO_BUFFER_SIZE / 2));
+
+        // Spread the mono samples in place, back to front
+        for (int i = count - 1; i >= 0; i--)
+        {
+            m_pBuffer[(i << 1) + 1] = m_pBuffer[i];
+            m_pBuffer[i << 1] = m_pBuffer[i];
+        }
+
+        m_iBufferIndex = count << 1;
+        m_bOutputPending = false;
+    }
+
+    if (m_bEnabled && IsValidPointer(pSampleBuffer))
     {
         ret = m_iBufferIndex;
 
@@ -116,6 +156,7 @@ int YM2413::EndFrame(s16* pSampleBuffer)
     }
 
     m_iBufferIndex = 0;
+    m_iFrameCycles = 0;
 
     return ret;
 }
@@ -125,145 +166,149 @@ void YM2413::Enable(bool bEnabled)
     m_bEnabled = bEnabled;
 }
 
+// Without synthesis the chip still accepts register writes but its clock is
+// only advanced, no samples are generated for the frame
+void YM2413::EnableSynthesis(bool bEnabled)
+{
+    m_bSynthesis = bEnabled;
+}
+
+// The chip produces a sample every 72 master cycles. Instead of counting
+// cycles one by one, the ticks that fall inside the elapsed time are worked
+// out up front and each new sample goes into the output buffer at its own
+// master clock time.
 void YM2413::Sync()
 {
-    if (!m_bEnabled)
-    {
-        m_ElapsedCycles = 0;
-        return;
-    }
+    int elapsed = m_ElapsedCycles;
+    m_ElapsedCycles = 0;
 
-    for (int i = 0; i < m_ElapsedCycles; i++)
+    if (m_bEnabled)
     {
-        m_iCycleCounter ++;
-        if (m_iCycleCounter >= 72)
-        {
-            m_iCycleCounter -= 72;
-            m_CurrentSample = OPLL_calc(m_pOPLL);
-        }
+        int cycles = m_iCycleCounter + elapsed;
 
-        m_iSampleCounter++;
-        if (m_iSampleCounter >= m_iCyclesPerSample)
+        if (m_bSynthesis)
         {
-            m_iSampleCounter -= m_iCyclesPerSample;
+            int ticks = cycles / 72;
+            int time = m_iFrameCycles + 72 - m_iCycleCounter;
 
-            m_pBuffer[m_iBufferIndex] = m_CurrentSample;
-            m_pBuffer[m_iBufferIndex + 1] = m_CurrentSample;
-            m_iBufferIndex += 2;
-
-            if (m_iBufferIndex >= GS_AUDIO_BUFFER_SIZE)
+            for (int i = 0; i < ticks; i++, time += 72)
             {
-                Log("YM2413 Audio buffer overflow");
-                m_iBufferIndex = 0;
+                m_CurrentSample = OPLL_calc(m_pOPLL);
+                m_Synth.update(time, m_CurrentSample);
             }
+
+            if (ticks > 0)
+                m_bOutputPending = true;
         }
+
+        m_iCycleCounter = cycles % 72;
     }
 
-    m_ElapsedCycles = 0;
+    m_iFrameCycles += elapsed;
 }
 
-void YM2413::SaveState(std::ostream& stream)
+void YM2413::SaveState(StateWriter& state)
 {
-    stream.write(reinterpret_cast<const char*>(&m_iCycleCounter), sizeof(int));
-    stream.write(reinterpret_cast<const char*>(&m_iSampleCounter), sizeof(int));
-    stream.write(reinterpret_cast<const char*>(&m_iBufferIndex), sizeof(int));
-    stream.write(reinterpret_cast<const char*>(&m_ElapsedCycles), sizeof(int));
-    stream.write(reinterpret_cast<const char*>(&m_iClockRate), sizeof(int));
-    stream.write(reinterpret_cast<const char*>(&m_RegisterF2), sizeof(u8));
-    stream.write(reinterpret_cast<const char*>(m_pBuffer), sizeof(s16) * GS_AUDIO_BUFFER_SIZE);
-    stream.write(reinterpret_cast<const char*>(&m_CurrentSample), sizeof(m_CurrentSample));
-    stream.write(reinterpret_cast<const char*>(&m_bEnabled), sizeof(m_bEnabled));
-    stream.write(reinterpret_cast<const char*>(&m_pOPLL->chip_type), sizeof(m_pOPLL->chip_type));
-    stream.write(reinterpret_cast<const char*>(&m_pOPLL->adr), sizeof(m_pOPLL->adr));
-    stream.write(reinterpret_cast<const char*>(m_pOPLL->reg), sizeof(m_pOPLL->reg));
-    stream.write(reinterpret_cast<const char*>(&m_pOPLL->test_flag), sizeof(m_pOPLL->test_flag));
-    stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot_key_status), sizeof(m_pOPLL->slot_key_status));
-    stream.write(reinterpret_cast<const char*>(&m_pOPLL->rhythm_mode), sizeof(m_pOPLL->rhythm_mode));
-    stream.write(reinterpret_cast<const char*>(&m_pOPLL->eg_counter), sizeof(m_pOPLL->eg_counter));
-    stream.write(reinterpret_cast<const char*>(&m_pOPLL->pm_phase), sizeof(m_pOPLL->pm_phase));
-    stream.write(reinterpret_cast<const char*>(&m_pOPLL->am_phase), sizeof(m_pOPLL->am_phase));
-    stream.write(reinterpret_cast<const char*>(&m_pOPLL->lfo_am), sizeof(m_pOPLL->lfo_am));
-    stream.write(reinterpret_cast<const char*>(&m_pOPLL->noise), sizeof(m_pOPLL->noise));
-    stream.write(reinterpret_cast<const char*>(&m_pOPLL->short_noise), sizeof(m_pOPLL->short_noise));
-    stream.write(reinterpret_cast<const char*>(m_pOPLL->patch_number), sizeof(m_pOPLL->patch_number));
-    stream.write(reinterpret_cast<const char*>(m_pOPLL->patch), sizeof(m_pOPLL->patch));
-    stream.write(reinterpret_cast<const char*>(&m_pOPLL->mask), sizeof(m_pOPLL->mask));
-    stream.write(reinterpret_cast<const char*>(m_pOPLL->ch_out), sizeof(m_pOPLL->ch_out));
-    stream.write(reinterpret_cast<const char*>(m_pOPLL->mix_out), sizeof(m_pOPLL->mix_out));
+    state.Write(&m_iCycleCounter, sizeof(int));
+    state.Write(&m_iFrameCycles, sizeof(int));
+    state.Write(&m_iBufferIndex, sizeof(int));
+    state.Write(&m_ElapsedCycles, sizeof(int));
+    state.Write(&m_iClockRate, sizeof(int));
+    state.Write(&m_RegisterF2, sizeof(u8));
+    state.Write(m_pBuffer, sizeof(s16) * GS_AUDIO_BUFFER_SIZE);
+    state.Write(&m_CurrentSample, sizeof(m_CurrentSample));
+    state.Write(&m_bEnabled, sizeof(m_bEnabled));
+    state.Write(&m_pOPLL->chip_type, sizeof(m_pOPLL->chip_type));
+    state.Write(&m_pOPLL->adr, sizeof(m_pOPLL->adr));
+    state.Write(m_pOPLL->reg, sizeof(m_pOPLL->reg));
+    state.Write(&m_pOPLL->test_flag, sizeof(m_pOPLL->test_flag));
+    state.Write(&m_pOPLL->slot_key_status, sizeof(m_pOPLL->slot_key_status));
+    state.Write(&m_pOPLL->rhythm_mode, sizeof(m_pOPLL->rhythm_mode));
+    state.Write(&m_pOPLL->eg_counter, sizeof(m_pOPLL->eg_counter));
+    state.Write(&m_pOPLL->pm_phase, sizeof(m_pOPLL->pm_phase));
+    state.Write(&m_pOPLL->am_phase, sizeof(m_pOPLL->am_phase));
+    state.Write(&m_pOPLL->lfo_am, sizeof(m_pOPLL->lfo_am));
+    state.Write(&m_pOPLL->noise, sizeof(m_pOPLL->noise));
+    state.Write(&m_pOPLL->short_noise, sizeof(m_pOPLL->short_noise));
+    state.Write(m_pOPLL->patch_number, sizeof(m_pOPLL->patch_number));
+    state.Write(m_pOPLL->patch, sizeof(m_pOPLL->patch));
+    state.Write(&m_pOPLL->mask, sizeof(m_pOPLL->mask));
+    state.Write(m_pOPLL->ch_out, sizeof(m_pOPLL->ch_out));
+    state.Write(m_pOPLL->mix_out, sizeof(m_pOPLL->mix_out));
     for (int i = 0; i < 18; i++)
     {
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].number), sizeof(m_pOPLL->slot[i].number));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].type), sizeof(m_pOPLL->slot[i].type));
-        stream.write(reinterpret_cast<const char*>(m_pOPLL->slot[i].output), sizeof(m_pOPLL->slot[i].output));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].pg_phase), sizeof(m_pOPLL->slot[i].pg_phase));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].pg_out), sizeof(m_pOPLL->slot[i].pg_out));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].pg_keep), sizeof(m_pOPLL->slot[i].pg_keep));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].blk_fnum), sizeof(m_pOPLL->slot[i].blk_fnum));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].fnum), sizeof(m_pOPLL->slot[i].fnum));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].blk), sizeof(m_pOPLL->slot[i].blk));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].eg_state), sizeof(m_pOPLL->slot[i].eg_state));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].volume), sizeof(m_pOPLL->slot[i].volume));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].key_flag), sizeof(m_pOPLL->slot[i].key_flag));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].sus_flag), sizeof(m_pOPLL->slot[i].sus_flag));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].tll), sizeof(m_pOPLL->slot[i].tll));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].rks), sizeof(m_pOPLL->slot[i].rks));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].eg_rate_h), sizeof(m_pOPLL->slot[i].eg_rate_h));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].eg_rate_l), sizeof(m_pOPLL->slot[i].eg_rate_l));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].eg_shift), sizeof(m_pOPLL->slot[i].eg_shift));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].eg_out), sizeof(m_pOPLL->slot[i].eg_out));
-        stream.write(reinterpret_cast<const char*>(&m_pOPLL->slot[i].update_requests), sizeof(m_pOPLL->slot[i].update_requests));
+        state.Write(&m_pOPLL->slot[i].number, sizeof(m_pOPLL->slot[i].number));
+        state.Write(&m_pOPLL->slot[i].type, sizeof(m_pOPLL->slot[i].type));
+        state.Write(m_pOPLL->slot[i].output, sizeof(m_pOPLL->slot[i].output));
+        state.Write(&m_pOPLL->slot[i].pg_phase, sizeof(m_pOPLL->slot[i].pg_phase));
+        state.Write(&m_pOPLL->slot[i].pg_out, sizeof(m_pOPLL->slot[i].pg_out));
+        state.Write(&m_pOPLL->slot[i].pg_keep, sizeof(m_pOPLL->slot[i].pg_keep));
+        state.Write(&m_pOPLL->slot[i].blk_fnum, sizeof(m_pOPLL->slot[i].blk_fnum));
+        state.Write(&m_pOPLL->slot[i].fnum, sizeof(m_pOPLL->slot[i].fnum));
+        state.Write(&m_pOPLL->slot[i].blk, sizeof(m_pOPLL->slot[i].blk));
+        state.Write(&m_pOPLL->slot[i].eg_state, sizeof(m_pOPLL->slot[i].eg_state));
+        state.Write(&m_pOPLL->slot[i].volume, sizeof(m_pOPLL->slot[i].volume));
+        state.Write(&m_pOPLL->slot[i].key_flag, sizeof(m_pOPLL->slot[i].key_flag));
+        state.Write(&m_pOPLL->slot[i].sus_flag, sizeof(m_pOPLL->slot[i].sus_flag));
+        state.Write(&m_pOPLL->slot[i].tll, sizeof(m_pOPLL->slot[i].tll));
+        state.Write(&m_pOPLL->slot[i].rks, sizeof(m_pOPLL->slot[i].rks));
+        state.Write(&m_pOPLL->slot[i].eg_rate_h, sizeof(m_pOPLL->slot[i].eg_rate_h));
+        state.Write(&m_pOPLL->slot[i].eg_rate_l, sizeof(m_pOPLL->slot[i].eg_rate_l));
+        state.Write(&m_pOPLL->slot[i].eg_shift, sizeof(m_pOPLL->slot[i].eg_shift));
+        state.Write(&m_pOPLL->slot[i].eg_out, sizeof(m_pOPLL->slot[i].eg_out));
+        state.Write(&m_pOPLL->slot[i].update_requests, sizeof(m_pOPLL->slot[i].update_requests));
     }
 }
 
-void YM2413::LoadState(std::istream& stream)
+void YM2413::LoadState(StateReader& state)
 {
-    stream.read(reinterpret_cast<char*>(&m_iCycleCounter), sizeof(int));
-    stream.read(reinterpret_cast<char*>(&m_iSampleCounter), sizeof(int));
-    stream.read(reinterpret_cast<char*>(&m_iBufferIndex), sizeof(int));
-    stream.read(reinterpret_cast<char*>(&m_ElapsedCycles), sizeof(int));
-    stream.read(reinterpret_cast<char*>(&m_iClockRate), sizeof(int));
-    stream.read(reinterpret_cast<char*>(&m_RegisterF2), sizeof(u8));
-    stream.read(reinterpret_cast<char*>(m_pBuffer), sizeof(s16) * GS_AUDIO_BUFFER_SIZE);
-    stream.read(reinterpret_cast<char*>(&m_CurrentSample), sizeof(m_CurrentSample));
-    stream.read(reinterpret_cast<char*>(&m_bEnabled), sizeof(m_bEnabled));
-    stream.read(reinterpret_cast<char*>(&m_pOPLL->chip_type), sizeof(m_pOPLL->chip_type));
-    stream.read(reinterpret_cast<char*>(&m_pOPLL->adr), sizeof(m_pOPLL->adr));
-    stream.read(reinterpret_cast<char*>(m_pOPLL->reg), sizeof(m_pOPLL->reg));
-    stream.read(reinterpret_cast<char*>(&m_pOPLL->test_flag), sizeof(m_pOPLL->test_flag));
-    stream.read(reinterpret_cast<char*>(&m_pOPLL->slot_key_status), sizeof(m_pOPLL->slot_key_status));
-    stream.read(reinterpret_cast<char*>(&m_pOPLL->rhythm_mode), sizeof(m_pOPLL->rhythm_mode));
-    stream.read(reinterpret_cast<char*>(&m_pOPLL->eg_counter), sizeof(m_pOPLL->eg_counter));
-    stream.read(reinterpret_cast<char*>(&m_pOPLL->pm_phase), sizeof(m_pOPLL->pm_phase));
-    stream.read(reinterpret_cast<char*>(&m_pOPLL->am_phase), sizeof(m_pOPLL->am_phase));
-    stream.read(reinterpret_cast<char*>(&m_pOPLL->lfo_am), sizeof(m_pOPLL->lfo_am));
-    stream.read(reinterpret_cast<char*>(&m_pOPLL->noise), sizeof(m_pOPLL->noise));
-    stream.read(reinterpret_cast<char*>(&m_pOPLL->short_noise), sizeof(m_pOPLL->short_noise));
-    stream.read(reinterpret_cast<char*>(m_pOPLL->patch_number), sizeof(m_pOPLL->patch_number));
-    stream.read(reinterpret_cast<char*>(m_pOPLL->patch), sizeof(m_pOPLL->patch));
-    stream.read(reinterpret_cast<char*>(&m_pOPLL->mask), sizeof(m_pOPLL->mask));
-    stream.read(reinterpret_cast<char*>(m_pOPLL->ch_out), sizeof(m_pOPLL->ch_out));
-    stream.read(reinterpret_cast<char*>(m_pOPLL->mix_out), sizeof(m_pOPLL->mix_out));
+    state.Read(&m_iCycleCounter, sizeof(int));
+    state.Read(&m_iFrameCycles, sizeof(int));
+    state.Read(&m_iBufferIndex, sizeof(int));
+    state.Read(&m_ElapsedCycles, sizeof(int));
+    state.Read(&m_iClockRate, sizeof(int));
+    state.Read(&m_RegisterF2, sizeof(u8));
+    state.Read(m_pBuffer, sizeof(s16) * GS_AUDIO_BUFFER_SIZE);
+    state.Read(&m_CurrentSample, sizeof(m_CurrentSample));
+    state.Read(&m_bEnabled, sizeof(m_bEnabled));
+    state.Read(&m_pOPLL->chip_type, sizeof(m_pOPLL->chip_type));
+    state.Read(&m_pOPLL->adr, sizeof(m_pOPLL->adr));
+    state.Read(m_pOPLL->reg, sizeof(m_pOPLL->reg));
+    state.Read(&m_pOPLL->test_flag, sizeof(m_pOPLL->test_flag));
+    state.Read(&m_pOPLL->slot_key_status, sizeof(m_pOPLL->slot_key_status));
+    state.Read(&m_pOPLL->rhythm_mode, sizeof(m_pOPLL->rhythm_mode));
+    state.Read(&m_pOPLL->eg_counter, sizeof(m_pOPLL->eg_counter));
+    state.Read(&m_pOPLL->pm_phase, sizeof(m_pOPLL->pm_phase));
+    state.Read(&m_pOPLL->am_phase, sizeof(m_pOPLL->am_phase));
+    state.Read(&m_pOPLL->lfo_am, sizeof(m_pOPLL->lfo_am));
+    state.Read(&m_pOPLL->noise, sizeof(m_pOPLL->noise));
+    state.Read(&m_pOPLL->short_noise, sizeof(m_pOPLL->short_noise));
+    state.Read(m_pOPLL->patch_number, sizeof(m_pOPLL->patch_number));
+    state.Read(m_pOPLL->patch, sizeof(m_pOPLL->patch));
+    state.Read(&m_pOPLL->mask, sizeof(m_pOPLL->mask));
+    state.Read(m_pOPLL->ch_out, sizeof(m_pOPLL->ch_out));
+    state.Read(m_pOPLL->mix_out, sizeof(m_pOPLL->mix_out));
     for (int i = 0; i < 18; i++)
     {
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].number), sizeof(m_pOPLL->slot[i].number));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].type), sizeof(m_pOPLL->slot[i].type));
-        stream.read(reinterpret_cast<char*>(m_pOPLL->slot[i].output), sizeof(m_pOPLL->slot[i].output));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].pg_phase), sizeof(m_pOPLL->slot[i].pg_phase));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].pg_out), sizeof(m_pOPLL->slot[i].pg_out));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].pg_keep), sizeof(m_pOPLL->slot[i].pg_keep));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].blk_fnum), sizeof(m_pOPLL->slot[i].blk_fnum));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].fnum), sizeof(m_pOPLL->slot[i].fnum));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].blk), sizeof(m_pOPLL->slot[i].blk));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].eg_state), sizeof(m_pOPLL->slot[i].eg_state));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].volume), sizeof(m_pOPLL->slot[i].volume));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].key_flag), sizeof(m_pOPLL->slot[i].key_flag));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].sus_flag), sizeof(m_pOPLL->slot[i].sus_flag));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].tll), sizeof(m_pOPLL->slot[i].tll));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].rks), sizeof(m_pOPLL->slot[i].rks));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].eg_rate_h), sizeof(m_pOPLL->slot[i].eg_rate_h));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].eg_rate_l), sizeof(m_pOPLL->slot[i].eg_rate_l));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].eg_shift), sizeof(m_pOPLL->slot[i].eg_shift));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].eg_out), sizeof(m_pOPLL->slot[i].eg_out));
-        stream.read(reinterpret_cast<char*>(&m_pOPLL->slot[i].update_requests), sizeof(m_pOPLL->slot[i].update_requests));
+        state.Read(&m_pOPLL->slot[i].number, sizeof(m_pOPLL->slot[i].number));
+        state.Read(&m_pOPLL->slot[i].type, sizeof(m_pOPLL->slot[i].type));
+        state.Read(m_pOPLL->slot[i].output, sizeof(m_pOPLL->slot[i].output));
+        state.Read(&m_pOPLL->slot[i].pg_phase, sizeof(m_pOPLL->slot[i].pg_phase));
+        state.Read(&m_pOPLL->slot[i].pg_out, sizeof(m_pOPLL->slot[i].pg_out));
+        state.Read(&m_pOPLL->slot[i].pg_keep, sizeof(m_pOPLL->slot[i].pg_keep));
+        state.Read(&m_pOPLL->slot[i].blk_fnum, sizeof(m_pOPLL->slot[i].blk_fnum));
+        state.Read(&m_pOPLL->slot[i].fnum, sizeof(m_pOPLL->slot[i].fnum));
+        state.Read(&m_pOPLL->slot[i].blk, sizeof(m_pOPLL->slot[i].blk));
+        state.Read(&m_pOPLL->slot[i].eg_state, sizeof(m_pOPLL->slot[i].eg_state));
+        state.Read(&m_pOPLL->slot[i].volume, sizeof(m_pOPLL->slot[i].volume));
+        state.Read(&m_pOPLL->slot[i].key_flag, sizeof(m_pOPLL->slot[i].key_flag));
+        state.Read(&m_pOPLL->slot[i].sus_flag, sizeof(m_pOPLL->slot[i].sus_flag));
+        state.Read(&m_pOPLL->slot[i].tll, sizeof(m_pOPLL->slot[i].tll));
+        state.Read(&m_pOPLL->slot[i].rks, sizeof(m_pOPLL->slot[i].rks));
+        state.Read(&m_pOPLL->slot[i].eg_rate_h, sizeof(m_pOPLL->slot[i].eg_rate_h));
+        state.Read(&m_pOPLL->slot[i].eg_rate_l, sizeof(m_pOPLL->slot[i].eg_rate_l));
+        state.Read(&m_pOPLL->slot[i].eg_shift, sizeof(m_pOPLL->slot[i].eg_shift));
+        state.Read(&m_pOPLL->slot[i].eg_out, sizeof(m_pOPLL->slot[i].eg_out));
+        state.Read(&m_pOPLL->slot[i].update_requests, sizeof(m_pOPLL->slot[i].update_requests));
     }
 }
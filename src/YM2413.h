@@ -3,6 +3,8 @@
 
 #include "definitions.h"
 #include "audio/emu2413/emu2413.h"
+#include "audio/Blip_Buffer.h"
+#include "StateSerializer.h"
 
 class YM2413
 {
@@ -18,16 +20,18 @@ public:
     void Tick(unsigned int clockCycles);
     int EndFrame(s16* pSampleBuffer);
     void Enable(bool bEnabled);
-    void SaveState(std::ostream& stream);
-    void LoadState(std::istream& stream);
+    void EnableSynthesis(bool bEnabled);
+    void SaveState(StateWriter& state);
+    void LoadState(StateReader& state);
 
 private:
     void Sync();
 
 private:
+    typedef Blip_Synth<blip_good_quality, 1 << 16> Synth;
+
     int m_iCycleCounter;
-    int m_iSampleCounter;
-    int m_iCyclesPerSample;
+    int m_iFrameCycles;
     s16* m_pBuffer;
     int m_iBufferIndex;
     int m_ElapsedCycles;
@@ -36,6 +40,10 @@ private:
     OPLL *m_pOPLL;
     s16 m_CurrentSample;
     bool m_bEnabled;
+    bool m_bSynthesis;
+    Blip_Buffer* m_pOutput;
+    Synth m_Synth;
+    bool m_bOutputPending;
 };
 
 #endif	/* YM2413_H */
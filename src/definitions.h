@@ -33,10 +33,6 @@
 #define DEBUG_GEARSYSTEM 1
 #endif
 
-#if defined(PS2) || defined(PSP)
-#define PERFORMANCE
-#endif
-
 #define GEARSYSTEM_TITLE "Gearsystem"
 #define GEARSYSTEM_VERSION "3.5.0"
 #define GEARSYSTEM_TITLE_ASCII "" \
@@ -173,6 +169,13 @@ enum GS_Region
     Region_PAL
 };
 
+enum GS_Run_Flags
+{
+    GS_RUN_DEFAULT = 0,
+    GS_RUN_SKIP_RENDER = 1,
+    GS_RUN_SKIP_AUDIO = 2
+};
+
 struct GS_RuntimeInfo
 {
     int screen_width;
@@ -180,8 +183,33 @@ struct GS_RuntimeInfo
     GS_Region region;
 };
 
+enum GS_Native_Format
+{
+    GS_NATIVE_SMS,
+    GS_NATIVE_GG,
+    GS_NATIVE_SG1000
+};
+
+// Read-only view of the VDP output before any color conversion.
+// GS_NATIVE_SMS pixels are --BBGGRR, GS_NATIVE_GG pixels are ----BBBBGGGGRRRR
+// and GS_NATIVE_SG1000 pixels are indices into the 16 entry RGB888 palette.
+struct GS_FrameView
+{
+    const u16* buffer;
+    int width;
+    int height;
+    int pitch;
+    GS_Native_Format format;
+    const u8* cram;
+    int cram_size;
+    const u8* palette;
+    u16 backdrop;
+};
+
 #ifdef DEBUG_GEARSYSTEM
 
+#include <atomic>
+
 #ifdef __ANDROID__
 #include <android/log.h>
 #define printf(...) __android_log_print(ANDROID_LOG_DEBUG, "GEARSYSTEM", __VA_ARGS__);
@@ -191,7 +219,7 @@ struct GS_RuntimeInfo
 
 inline void Log_func(const char* const msg, ...)
 {
-    static int count = 1;
+    static std::atomic<int> count(1);
     char szBuf[512];
 
     va_list args;
@@ -199,10 +227,8 @@ inline void Log_func(const char* const msg, ...)
     vsnprintf(szBuf, 512, msg, args);
     va_end(args);
 
-    printf("%d: %s\n", count, szBuf);
+    printf("%d: %s\n", count++, szBuf);
     fflush(stdout);
-
-    count++;
 }
 
 #else // DEBUG_GEARSYSTEM
@@ -29,6 +29,8 @@
 #include "Video.h"
 #include "SixteenBitRegister.h"
 #include "MemoryRule.h"
+#include "Rewind.h"
+#include "RunAhead.h"
 
 #endif	/* GEARSYSTEM_H */
 
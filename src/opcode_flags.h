@@ -0,0 +1,1063 @@
+/*
+ * Gearsystem - Sega Master System / Game Gear Emulator
+ * Copyright (C) 2013  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/ 
+ * 
+ */
+
+#ifndef OPCODE_FLAGS_H
+#define	OPCODE_FLAGS_H
+
+// Sign, zero and undocumented X/Y flags of a result byte
+const u8 kOPCodeSZXYTable[0x100] = {
+    FLAG_ZERO,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X
+};
+
+// Sign, zero, X/Y and parity flags of a result byte
+const u8 kOPCodeSZXYPTable[0x100] = {
+    FLAG_ZERO + FLAG_PARITY,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_PARITY,
+    FLAG_NONE,
+    FLAG_PARITY,
+    FLAG_PARITY,
+    FLAG_NONE,
+    FLAG_X,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X + FLAG_PARITY,
+    FLAG_NONE,
+    FLAG_PARITY,
+    FLAG_PARITY,
+    FLAG_NONE,
+    FLAG_PARITY,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_PARITY,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X,
+    FLAG_Y,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_NONE,
+    FLAG_PARITY,
+    FLAG_PARITY,
+    FLAG_NONE,
+    FLAG_PARITY,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_PARITY,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X,
+    FLAG_PARITY,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_PARITY,
+    FLAG_NONE,
+    FLAG_PARITY,
+    FLAG_PARITY,
+    FLAG_NONE,
+    FLAG_X,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X,
+    FLAG_X + FLAG_PARITY,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y + FLAG_PARITY,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_Y + FLAG_X,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_PARITY
+};
+
+// All flags but carry after INC, indexed by the result byte
+const u8 kOPCodeINCFlagsTable[0x100] = {
+    FLAG_ZERO + FLAG_HALF,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_HALF,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_Y + FLAG_HALF,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_HALF,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_HALF,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_HALF,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_NONE,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_X,
+    FLAG_Y + FLAG_HALF,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_HALF,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_HALF + FLAG_PARITY,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_HALF,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_HALF,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_HALF,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_HALF,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_HALF,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_HALF,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_HALF,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X,
+    FLAG_SIGN + FLAG_Y + FLAG_X
+};
+
+// All flags but carry after DEC, indexed by the result byte
+const u8 kOPCodeDECFlagsTable[0x100] = {
+    FLAG_ZERO + FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_X + FLAG_NEGATIVE,
+    FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_Y + FLAG_HALF + FLAG_X + FLAG_PARITY + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_HALF + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_X + FLAG_NEGATIVE,
+    FLAG_SIGN + FLAG_Y + FLAG_HALF + FLAG_X + FLAG_NEGATIVE
+};
+
+#endif	/* OPCODE_FLAGS_H */
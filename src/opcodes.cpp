@@ -78,13 +78,14 @@ void Processor::OPCode0x07()
 void Processor::OPCode0x08()
 {
     // EX AF,AF’
+    MaterializeFlags();
     OPCodes_EX(&AF, &AF2);
 }
 
 void Processor::OPCode0x09()
 {
     // ADD HL,BC
-    OPCodes_ADD_HL(BC.GetValue());
+    OPCodes_ADD_HL(GetPrefixedRegister(), BC.GetValue());
 }
 
 void Processor::OPCode0x0A()
@@ -190,7 +191,7 @@ void Processor::OPCode0x18()
 void Processor::OPCode0x19()
 {
     // ADD HL,DE
-    OPCodes_ADD_HL(DE.GetValue());
+    OPCodes_ADD_HL(GetPrefixedRegister(), DE.GetValue());
 }
 
 void Processor::OPCode0x1A()
@@ -301,7 +302,7 @@ void Processor::OPCode0x29()
 {
     // ADD HL,HL
     SixteenBitRegister* reg = GetPrefixedRegister();
-    OPCodes_ADD_HL(reg->GetValue());
+    OPCodes_ADD_HL(reg, reg->GetValue());
 }
 
 void Processor::OPCode0x2A()
@@ -378,13 +379,13 @@ void Processor::OPCode0x33()
 void Processor::OPCode0x34()
 {
     // INC (HL)
-    OPCodes_INC_HL();
+    OPCodes_INC_HL(GetEffectiveAddress());
 }
 
 void Processor::OPCode0x35()
 {
     // DEC (HL)
-    OPCodes_DEC_HL();
+    OPCodes_DEC_HL(GetEffectiveAddress());
 }
 
 void Processor::OPCode0x36()
@@ -429,7 +430,7 @@ void Processor::OPCode0x38()
 void Processor::OPCode0x39()
 {
     // ADD HL,SP
-    OPCodes_ADD_HL(SP.GetValue());
+    OPCodes_ADD_HL(GetPrefixedRegister(), SP.GetValue());
 }
 
 void Processor::OPCode0x3A()
@@ -1580,6 +1581,7 @@ void Processor::OPCode0xF0()
 void Processor::OPCode0xF1()
 {
     // POP AF
+    m_LazyFlagsOp = LazyFlagsNone;
     StackPop(&AF);
 }
 
@@ -1605,6 +1607,7 @@ void Processor::OPCode0xF4()
 void Processor::OPCode0xF5()
 {
     // PUSH AF
+    MaterializeFlags();
     StackPush(&AF);
 }
 
@@ -1670,4 +1673,1292 @@ void Processor::OPCode0xFF()
 {
     // RST 38H
     OPCodes_RST(0x0038);
-}
\ No newline at end of file
+}
+
+template <u8 prefix>
+void Processor::ExecuteOPCodeSwitch(u8 opcode)
+{
+    switch (opcode)
+    {
+        case 0xCB:
+        {
+            IncreaseR();
+
+            if (IsPrefixedInstruction<prefix>())
+            {
+                m_bPrefixedCBOpcode = true;
+                m_PrefixedCBValue = m_pMemory->Read(PC.GetValue());
+                PC.Increment();
+            }
+            else
+                IncreaseR();
+
+            opcode = FetchOPCode();
+
+            ExecuteOPCodeSwitchCB(opcode);
+
+            if (IsPrefixedInstruction<prefix>())
+            {
+                m_iTStates += kOPCodeXYCBTStates[opcode];
+                m_bPrefixedCBOpcode = false;
+            }
+            else
+                m_iTStates += kOPCodeCBTStates[opcode];
+
+            return;
+        }
+        case 0xED:
+        {
+            IncreaseR();
+            IncreaseR();
+
+            m_CurrentPrefix = 0x00;
+            opcode = FetchOPCode();
+
+            ExecuteOPCodeSwitchED(opcode);
+
+            m_iTStates += kOPCodeEDTStates[opcode];
+            return;
+        }
+    }
+
+    if (!m_bInputLastCycle)
+        IncreaseR();
+
+    switch (opcode)
+    {
+        case 0x00:
+            // NOP
+            OPCode0x00();
+            break;
+        case 0x01:
+            // LD BC,nn
+            OPCode0x01();
+            break;
+        case 0x02:
+            // LD (BC),A
+            OPCode0x02();
+            break;
+        case 0x03:
+            // INC BC
+            OPCode0x03();
+            break;
+        case 0x04:
+            // INC B
+            OPCode0x04();
+            break;
+        case 0x05:
+            // DEC B
+            OPCode0x05();
+            break;
+        case 0x06:
+            // LD B,n
+            OPCode0x06();
+            break;
+        case 0x07:
+            // RLCA
+            OPCode0x07();
+            break;
+        case 0x08:
+            // EX AF,AF’
+            OPCode0x08();
+            break;
+        case 0x09:
+        {
+            // ADD HL,BC
+            OPCodes_ADD_HL(GetPrefixedRegister<prefix>(), BC.GetValue());
+            break;
+        }
+        case 0x0A:
+            // LD A,(BC)
+            OPCode0x0A();
+            break;
+        case 0x0B:
+            // DEC BC
+            OPCode0x0B();
+            break;
+        case 0x0C:
+            // INC C
+            OPCode0x0C();
+            break;
+        case 0x0D:
+            // DEC C
+            OPCode0x0D();
+            break;
+        case 0x0E:
+            // LD C,n
+            OPCode0x0E();
+            break;
+        case 0x0F:
+            // RRCA
+            OPCode0x0F();
+            break;
+        case 0x10:
+            // DJNZ (PC+e)
+            OPCode0x10();
+            break;
+        case 0x11:
+            // LD DE,nn
+            OPCode0x11();
+            break;
+        case 0x12:
+            // LD (DE),A
+            OPCode0x12();
+            break;
+        case 0x13:
+            // INC DE
+            OPCode0x13();
+            break;
+        case 0x14:
+            // INC D
+            OPCode0x14();
+            break;
+        case 0x15:
+            // DEC D
+            OPCode0x15();
+            break;
+        case 0x16:
+            // LD D,n
+            OPCode0x16();
+            break;
+        case 0x17:
+            // RLA
+            OPCode0x17();
+            break;
+        case 0x18:
+            // JR n
+            OPCode0x18();
+            break;
+        case 0x19:
+        {
+            // ADD HL,DE
+            OPCodes_ADD_HL(GetPrefixedRegister<prefix>(), DE.GetValue());
+            break;
+        }
+        case 0x1A:
+            // LD A,(DE)
+            OPCode0x1A();
+            break;
+        case 0x1B:
+            // DEC DE
+            OPCode0x1B();
+            break;
+        case 0x1C:
+            // INC E
+            OPCode0x1C();
+            break;
+        case 0x1D:
+            // DEC E
+            OPCode0x1D();
+            break;
+        case 0x1E:
+            // LD E,n
+            OPCode0x1E();
+            break;
+        case 0x1F:
+            // RRA
+            OPCode0x1F();
+            break;
+        case 0x20:
+            // JR NZ,n
+            OPCode0x20();
+            break;
+        case 0x21:
+        {
+            // LD HL,nn
+            SixteenBitRegister* reg = GetPrefixedRegister<prefix>();
+            OPCodes_LD(reg->GetLowRegister(), PC.GetValue());
+            PC.Increment();
+            OPCodes_LD(reg->GetHighRegister(), PC.GetValue());
+            PC.Increment();
+            break;
+        }
+        case 0x22:
+        {
+            // LD (nn),HL
+            OPCodes_LD_nn_dd(GetPrefixedRegister<prefix>());
+            break;
+        }
+        case 0x23:
+        {
+            // INC HL
+            GetPrefixedRegister<prefix>()->Increment();
+            break;
+        }
+        case 0x24:
+        {
+            // INC H
+            OPCodes_INC(GetPrefixedRegister<prefix>()->GetHighRegister());
+            break;
+        }
+        case 0x25:
+        {
+            // DEC H
+            OPCodes_DEC(GetPrefixedRegister<prefix>()->GetHighRegister());
+            break;
+        }
+        case 0x26:
+        {
+            // LD H,n
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetHighRegister(), PC.GetValue());
+            PC.Increment();
+            break;
+        }
+        case 0x27:
+            // DAA
+            OPCode0x27();
+            break;
+        case 0x28:
+            // JR Z,n
+            OPCode0x28();
+            break;
+        case 0x29:
+        {
+            // ADD HL,HL
+            SixteenBitRegister* reg = GetPrefixedRegister<prefix>();
+            OPCodes_ADD_HL(reg, reg->GetValue());
+            break;
+        }
+        case 0x2A:
+        {
+            // LD HL,(nn)
+            OPCodes_LD_dd_nn(GetPrefixedRegister<prefix>());
+            break;
+        }
+        case 0x2B:
+        {
+            // DEC HL
+            GetPrefixedRegister<prefix>()->Decrement();
+            break;
+        }
+        case 0x2C:
+        {
+            // INC L
+            OPCodes_INC(GetPrefixedRegister<prefix>()->GetLowRegister());
+            break;
+        }
+        case 0x2D:
+        {
+            // DEC L
+            OPCodes_DEC(GetPrefixedRegister<prefix>()->GetLowRegister());
+            break;
+        }
+        case 0x2E:
+        {
+            // LD L,n
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetLowRegister(), PC.GetValue());
+            PC.Increment();
+            break;
+        }
+        case 0x2F:
+            // CPL
+            OPCode0x2F();
+            break;
+        case 0x30:
+            // JR NC,n
+            OPCode0x30();
+            break;
+        case 0x31:
+            // LD SP,nn
+            OPCode0x31();
+            break;
+        case 0x32:
+            // LD (nn),A
+            OPCode0x32();
+            break;
+        case 0x33:
+            // INC SP
+            OPCode0x33();
+            break;
+        case 0x34:
+        {
+            // INC (HL)
+            OPCodes_INC_HL(GetEffectiveAddress<prefix>());
+            break;
+        }
+        case 0x35:
+        {
+            // DEC (HL)
+            OPCodes_DEC_HL(GetEffectiveAddress<prefix>());
+            break;
+        }
+        case 0x36:
+        {
+            // LD (HL),n
+            if (prefix == 0xDD)
+            {
+                u8 d = m_pMemory->Read(PC.GetValue());
+                u8 n = m_pMemory->Read(PC.GetValue() + 1);
+                u16 address = IX.GetValue() + static_cast<s8> (d);
+                m_pMemory->Write(address, n);
+                PC.Increment();
+            }
+            else if (prefix == 0xFD)
+            {
+                u8 d = m_pMemory->Read(PC.GetValue());
+                u8 n = m_pMemory->Read(PC.GetValue() + 1);
+                u16 address = IY.GetValue() + static_cast<s8> (d);
+                m_pMemory->Write(address, n);
+                PC.Increment();
+            }
+            else
+                m_pMemory->Write(HL.GetValue(), m_pMemory->Read(PC.GetValue()));
+            PC.Increment();
+            break;
+        }
+        case 0x37:
+            // SCF
+            OPCode0x37();
+            break;
+        case 0x38:
+            // JR C,n
+            OPCode0x38();
+            break;
+        case 0x39:
+        {
+            // ADD HL,SP
+            OPCodes_ADD_HL(GetPrefixedRegister<prefix>(), SP.GetValue());
+            break;
+        }
+        case 0x3A:
+            // LD A,(nn)
+            OPCode0x3A();
+            break;
+        case 0x3B:
+            // DEC SP
+            OPCode0x3B();
+            break;
+        case 0x3C:
+            // INC A
+            OPCode0x3C();
+            break;
+        case 0x3D:
+            // DEC A
+            OPCode0x3D();
+            break;
+        case 0x3E:
+            // LD A,n
+            OPCode0x3E();
+            break;
+        case 0x3F:
+            // CCF
+            OPCode0x3F();
+            break;
+        case 0x40:
+            // LD B,B
+            OPCode0x40();
+            break;
+        case 0x41:
+            // LD B,C
+            OPCode0x41();
+            break;
+        case 0x42:
+            // LD B,D
+            OPCode0x42();
+            break;
+        case 0x43:
+            // LD B,E
+            OPCode0x43();
+            break;
+        case 0x44:
+        {
+            // LD B,H
+            OPCodes_LD(BC.GetHighRegister(), GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0x45:
+        {
+            // LD B,L
+            OPCodes_LD(BC.GetHighRegister(), GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0x46:
+        {
+            // LD B,(HL)
+            OPCodes_LD(BC.GetHighRegister(), GetEffectiveAddress<prefix>());
+            break;
+        }
+        case 0x47:
+            // LD B,A
+            OPCode0x47();
+            break;
+        case 0x48:
+            // LD C,B
+            OPCode0x48();
+            break;
+        case 0x49:
+            // LD C,C
+            OPCode0x49();
+            break;
+        case 0x4A:
+            // LD C,D
+            OPCode0x4A();
+            break;
+        case 0x4B:
+            // LD C,E
+            OPCode0x4B();
+            break;
+        case 0x4C:
+        {
+            // LD C,H
+            OPCodes_LD(BC.GetLowRegister(), GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0x4D:
+        {
+            // LD C,L
+            OPCodes_LD(BC.GetLowRegister(), GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0x4E:
+        {
+            // LD C,(HL)
+            OPCodes_LD(BC.GetLowRegister(), GetEffectiveAddress<prefix>());
+            break;
+        }
+        case 0x4F:
+            // LD C,A
+            OPCode0x4F();
+            break;
+        case 0x50:
+            // LD D,B
+            OPCode0x50();
+            break;
+        case 0x51:
+            // LD D,C
+            OPCode0x51();
+            break;
+        case 0x52:
+            // LD D,D
+            OPCode0x52();
+            break;
+        case 0x53:
+            // LD D,E
+            OPCode0x53();
+            break;
+        case 0x54:
+        {
+            // LD D,H
+            OPCodes_LD(DE.GetHighRegister(), GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0x55:
+        {
+            // LD D,L
+            OPCodes_LD(DE.GetHighRegister(), GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0x56:
+        {
+            // LD D,(HL)
+            OPCodes_LD(DE.GetHighRegister(), GetEffectiveAddress<prefix>());
+            break;
+        }
+        case 0x57:
+            // LD D,A
+            OPCode0x57();
+            break;
+        case 0x58:
+            // LD E,B
+            OPCode0x58();
+            break;
+        case 0x59:
+            // LD E,C
+            OPCode0x59();
+            break;
+        case 0x5A:
+            // LD E,D
+            OPCode0x5A();
+            break;
+        case 0x5B:
+            // LD E,E
+            OPCode0x5B();
+            break;
+        case 0x5C:
+        {
+            // LD E,H
+            OPCodes_LD(DE.GetLowRegister(), GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0x5D:
+        {
+            // LD E,L
+            OPCodes_LD(DE.GetLowRegister(), GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0x5E:
+        {
+            // LD E,(HL)
+            OPCodes_LD(DE.GetLowRegister(), GetEffectiveAddress<prefix>());
+            break;
+        }
+        case 0x5F:
+            // LD E,A
+            OPCode0x5F();
+            break;
+        case 0x60:
+        {
+            // LD H,B
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetHighRegister(), BC.GetHigh());
+            break;
+        }
+        case 0x61:
+        {
+            // LD H,C
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetHighRegister(), BC.GetLow());
+            break;
+        }
+        case 0x62:
+        {
+            // LD H,D
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetHighRegister(), DE.GetHigh());
+            break;
+        }
+        case 0x63:
+        {
+            // LD H,E
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetHighRegister(), DE.GetLow());
+            break;
+        }
+        case 0x64:
+        {
+            // LD H,H
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetHighRegister(), GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0x65:
+        {
+            // LD H,L
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetHighRegister(), GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0x66:
+        {
+            // LD H,(HL)
+            OPCodes_LD(HL.GetHighRegister(), GetEffectiveAddress<prefix>());
+            break;
+        }
+        case 0x67:
+        {
+            // LD H,A
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetHighRegister(), AF.GetHigh());
+            break;
+        }
+        case 0x68:
+        {
+            // LD L,B
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetLowRegister(), BC.GetHigh());
+            break;
+        }
+        case 0x69:
+        {
+            // LD L,C
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetLowRegister(), BC.GetLow());
+            break;
+        }
+        case 0x6A:
+        {
+            // LD L,D
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetLowRegister(), DE.GetHigh());
+            break;
+        }
+        case 0x6B:
+        {
+            // LD L,E
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetLowRegister(), DE.GetLow());
+            break;
+        }
+        case 0x6C:
+        {
+            // LD L,H
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetLowRegister(), GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0x6D:
+        {
+            // LD L,L
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetLowRegister(), GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0x6E:
+        {
+            // LD L,(HL)
+            OPCodes_LD(HL.GetLowRegister(), GetEffectiveAddress<prefix>());
+            break;
+        }
+        case 0x6F:
+        {
+            // LD L,A
+            OPCodes_LD(GetPrefixedRegister<prefix>()->GetLowRegister(), AF.GetHigh());
+            break;
+        }
+        case 0x70:
+        {
+            // LD (HL),B
+            OPCodes_LD(GetEffectiveAddress<prefix>(), BC.GetHigh());
+            break;
+        }
+        case 0x71:
+        {
+            // LD (HL),C
+            OPCodes_LD(GetEffectiveAddress<prefix>(), BC.GetLow());
+            break;
+        }
+        case 0x72:
+        {
+            // LD (HL),D
+            OPCodes_LD(GetEffectiveAddress<prefix>(), DE.GetHigh());
+            break;
+        }
+        case 0x73:
+        {
+            // LD (HL),E
+            OPCodes_LD(GetEffectiveAddress<prefix>(), DE.GetLow());
+            break;
+        }
+        case 0x74:
+        {
+            // LD (HL),H
+            OPCodes_LD(GetEffectiveAddress<prefix>(), HL.GetHigh());
+            break;
+        }
+        case 0x75:
+        {
+            // LD (HL),L
+            OPCodes_LD(GetEffectiveAddress<prefix>(), HL.GetLow());
+            break;
+        }
+        case 0x76:
+            // HALT
+            OPCode0x76();
+            break;
+        case 0x77:
+        {
+            // LD (HL),A
+            OPCodes_LD(GetEffectiveAddress<prefix>(), AF.GetHigh());
+            break;
+        }
+        case 0x78:
+            // LD A,B
+            OPCode0x78();
+            break;
+        case 0x79:
+            // LD A,C
+            OPCode0x79();
+            break;
+        case 0x7A:
+            // LD A,D
+            OPCode0x7A();
+            break;
+        case 0x7B:
+            // LD A,E
+            OPCode0x7B();
+            break;
+        case 0x7C:
+        {
+            // LD A,H
+            OPCodes_LD(AF.GetHighRegister(), GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0x7D:
+        {
+            // LD A,L
+            OPCodes_LD(AF.GetHighRegister(), GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0x7E:
+        {
+            // LD A,(HL)
+            OPCodes_LD(AF.GetHighRegister(), GetEffectiveAddress<prefix>());
+            break;
+        }
+        case 0x7F:
+            // LD A,A
+            OPCode0x7F();
+            break;
+        case 0x80:
+            // ADD A,B
+            OPCode0x80();
+            break;
+        case 0x81:
+            // ADD A,C
+            OPCode0x81();
+            break;
+        case 0x82:
+            // ADD A,D
+            OPCode0x82();
+            break;
+        case 0x83:
+            // ADD A,E
+            OPCode0x83();
+            break;
+        case 0x84:
+        {
+            // ADD A,H
+            OPCodes_ADD(GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0x85:
+        {
+            // ADD A,L
+            OPCodes_ADD(GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0x86:
+        {
+            // ADD A,(HL)
+            OPCodes_ADD(m_pMemory->Read(GetEffectiveAddress<prefix>()));
+            break;
+        }
+        case 0x87:
+            // ADD A,A
+            OPCode0x87();
+            break;
+        case 0x88:
+            // ADC A,B
+            OPCode0x88();
+            break;
+        case 0x89:
+            // ADC A,C
+            OPCode0x89();
+            break;
+        case 0x8A:
+            // ADC A,D
+            OPCode0x8A();
+            break;
+        case 0x8B:
+            // ADC A,E
+            OPCode0x8B();
+            break;
+        case 0x8C:
+        {
+            // ADC A,H
+            OPCodes_ADC(GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0x8D:
+        {
+            // ADC A,L
+            OPCodes_ADC(GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0x8E:
+        {
+            // ADC A,(HL)
+            OPCodes_ADC(m_pMemory->Read(GetEffectiveAddress<prefix>()));
+            break;
+        }
+        case 0x8F:
+            // ADC A,A
+            OPCode0x8F();
+            break;
+        case 0x90:
+            // SUB B
+            OPCode0x90();
+            break;
+        case 0x91:
+            // SUB C
+            OPCode0x91();
+            break;
+        case 0x92:
+            // SUB D
+            OPCode0x92();
+            break;
+        case 0x93:
+            // SUB E
+            OPCode0x93();
+            break;
+        case 0x94:
+        {
+            // SUB H
+            OPCodes_SUB(GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0x95:
+        {
+            // SUB L
+            OPCodes_SUB(GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0x96:
+        {
+            // SUB (HL)
+            OPCodes_SUB(m_pMemory->Read(GetEffectiveAddress<prefix>()));
+            break;
+        }
+        case 0x97:
+            // SUB A
+            OPCode0x97();
+            break;
+        case 0x98:
+            // SBC B
+            OPCode0x98();
+            break;
+        case 0x99:
+            // SBC C
+            OPCode0x99();
+            break;
+        case 0x9A:
+            // SBC D
+            OPCode0x9A();
+            break;
+        case 0x9B:
+            // SBC E
+            OPCode0x9B();
+            break;
+        case 0x9C:
+        {
+            // SBC H
+            OPCodes_SBC(GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0x9D:
+        {
+            // SBC L
+            OPCodes_SBC(GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0x9E:
+        {
+            // SBC (HL)
+            OPCodes_SBC(m_pMemory->Read(GetEffectiveAddress<prefix>()));
+            break;
+        }
+        case 0x9F:
+            // SBC A
+            OPCode0x9F();
+            break;
+        case 0xA0:
+            // AND B
+            OPCode0xA0();
+            break;
+        case 0xA1:
+            // AND C
+            OPCode0xA1();
+            break;
+        case 0xA2:
+            // AND D
+            OPCode0xA2();
+            break;
+        case 0xA3:
+            // AND E
+            OPCode0xA3();
+            break;
+        case 0xA4:
+        {
+            // AND H
+            OPCodes_AND(GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0xA5:
+        {
+            // AND L
+            OPCodes_AND(GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0xA6:
+        {
+            // AND (HL)
+            OPCodes_AND(m_pMemory->Read(GetEffectiveAddress<prefix>()));
+            break;
+        }
+        case 0xA7:
+            // AND A
+            OPCode0xA7();
+            break;
+        case 0xA8:
+            // XOR B
+            OPCode0xA8();
+            break;
+        case 0xA9:
+            // XOR C
+            OPCode0xA9();
+            break;
+        case 0xAA:
+            // XOR D
+            OPCode0xAA();
+            break;
+        case 0xAB:
+            // XOR E
+            OPCode0xAB();
+            break;
+        case 0xAC:
+        {
+            // XOR H
+            OPCodes_XOR(GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0xAD:
+        {
+            // XOR L
+            OPCodes_XOR(GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0xAE:
+        {
+            // XOR (HL)
+            OPCodes_XOR(m_pMemory->Read(GetEffectiveAddress<prefix>()));
+            break;
+        }
+        case 0xAF:
+            // XOR A
+            OPCode0xAF();
+            break;
+        case 0xB0:
+            // OR B
+            OPCode0xB0();
+            break;
+        case 0xB1:
+            // OR C
+            OPCode0xB1();
+            break;
+        case 0xB2:
+            // OR D
+            OPCode0xB2();
+            break;
+        case 0xB3:
+            // OR E
+            OPCode0xB3();
+            break;
+        case 0xB4:
+        {
+            // OR H
+            OPCodes_OR(GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0xB5:
+        {
+            // OR L
+            OPCodes_OR(GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0xB6:
+        {
+            // OR (HL)
+            OPCodes_OR(m_pMemory->Read(GetEffectiveAddress<prefix>()));
+            break;
+        }
+        case 0xB7:
+            // OR A
+            OPCode0xB7();
+            break;
+        case 0xB8:
+            // CP B
+            OPCode0xB8();
+            break;
+        case 0xB9:
+            // CP C
+            OPCode0xB9();
+            break;
+        case 0xBA:
+            // CP D
+            OPCode0xBA();
+            break;
+        case 0xBB:
+            // CP E
+            OPCode0xBB();
+            break;
+        case 0xBC:
+        {
+            // CP H
+            OPCodes_CP(GetPrefixedRegister<prefix>()->GetHigh());
+            break;
+        }
+        case 0xBD:
+        {
+            // CP L
+            OPCodes_CP(GetPrefixedRegister<prefix>()->GetLow());
+            break;
+        }
+        case 0xBE:
+        {
+            // CP (HL)
+            OPCodes_CP(m_pMemory->Read(GetEffectiveAddress<prefix>()));
+            break;
+        }
+        case 0xBF:
+            // CP A
+            OPCode0xBF();
+            break;
+        case 0xC0:
+            // RET NZ
+            OPCode0xC0();
+            break;
+        case 0xC1:
+            // POP BC
+            OPCode0xC1();
+            break;
+        case 0xC2:
+            // JP NZ,nn
+            OPCode0xC2();
+            break;
+        case 0xC3:
+            // JP nn
+            OPCode0xC3();
+            break;
+        case 0xC4:
+            // CALL NZ,nn
+            OPCode0xC4();
+            break;
+        case 0xC5:
+            // PUSH BC
+            OPCode0xC5();
+            break;
+        case 0xC6:
+            // ADD A,n
+            OPCode0xC6();
+            break;
+        case 0xC7:
+            // RST 00H
+            OPCode0xC7();
+            break;
+        case 0xC8:
+            // RET Z
+            OPCode0xC8();
+            break;
+        case 0xC9:
+            // RET
+            OPCode0xC9();
+            break;
+        case 0xCA:
+            // JP Z,nn
+            OPCode0xCA();
+            break;
+        case 0xCC:
+            // CALL Z,nn
+            OPCode0xCC();
+            break;
+        case 0xCD:
+            // CALL nn
+            OPCode0xCD();
+            break;
+        case 0xCE:
+            // ADC A,n
+            OPCode0xCE();
+            break;
+        case 0xCF:
+            // RST 08H
+            OPCode0xCF();
+            break;
+        case 0xD0:
+            // RET NC
+            OPCode0xD0();
+            break;
+        case 0xD1:
+            // POP DE
+            OPCode0xD1();
+            break;
+        case 0xD2:
+            // JP NC,nn
+            OPCode0xD2();
+            break;
+        case 0xD3:
+            // OUT (n),A
+            OPCode0xD3();
+            break;
+        case 0xD4:
+            // CALL NC,nn
+            OPCode0xD4();
+            break;
+        case 0xD5:
+            // PUSH DE
+            OPCode0xD5();
+            break;
+        case 0xD6:
+            // SUB n
+            OPCode0xD6();
+            break;
+        case 0xD7:
+            // RST 10H
+            OPCode0xD7();
+            break;
+        case 0xD8:
+            // RET C
+            OPCode0xD8();
+            break;
+        case 0xD9:
+            // EXX
+            OPCode0xD9();
+            break;
+        case 0xDA:
+            // JP C,nn
+            OPCode0xDA();
+            break;
+        case 0xDB:
+            // IN A,(n)
+            OPCode0xDB();
+            break;
+        case 0xDC:
+            // CALL C,nn
+            OPCode0xDC();
+            break;
+        case 0xDD:
+            // DD prefixed instruction
+            OPCode0xDD();
+            break;
+        case 0xDE:
+            // SBC n
+            OPCode0xDE();
+            break;
+        case 0xDF:
+            // RST 18H
+            OPCode0xDF();
+            break;
+        case 0xE0:
+            // RET PO
+            OPCode0xE0();
+            break;
+        case 0xE1:
+        {
+            // POP HL
+            StackPop(GetPrefixedRegister<prefix>());
+            break;
+        }
+        case 0xE2:
+            // JP PO,nn
+            OPCode0xE2();
+            break;
+        case 0xE3:
+        {
+            // EX (SP),HL
+            SixteenBitRegister* reg = GetPrefixedRegister<prefix>();
+            u8 l = reg->GetLow();
+            u8 h = reg->GetHigh();
+            reg->SetLow(m_pMemory->Read(SP.GetValue()));
+            reg->SetHigh(m_pMemory->Read(SP.GetValue() + 1));
+            m_pMemory->Write(SP.GetValue(), l);
+            m_pMemory->Write(SP.GetValue() + 1, h);
+            WZ.SetValue(reg->GetValue());
+            break;
+        }
+        case 0xE4:
+            // CALL PO,nn
+            OPCode0xE4();
+            break;
+        case 0xE5:
+        {
+            // PUSH HL
+            StackPush(GetPrefixedRegister<prefix>());
+            break;
+        }
+        case 0xE6:
+            // AND n
+            OPCode0xE6();
+            break;
+        case 0xE7:
+            // RST 20H
+            OPCode0xE7();
+            break;
+        case 0xE8:
+            // RET PE
+            OPCode0xE8();
+            break;
+        case 0xE9:
+        {
+            // JP (HL)
+            PC.SetValue(GetPrefixedRegister<prefix>()->GetValue());
+            break;
+        }
+        case 0xEA:
+            // JP PE,nn
+            OPCode0xEA();
+            break;
+        case 0xEB:
+            // EX DE,HL
+            OPCode0xEB();
+            break;
+        case 0xEC:
+            // CALL PE,nn
+            OPCode0xEC();
+            break;
+        case 0xEE:
+            // XOR n
+            OPCode0xEE();
+            break;
+        case 0xEF:
+            // RST 28H
+            OPCode0xEF();
+            break;
+        case 0xF0:
+            // RET P
+            OPCode0xF0();
+            break;
+        case 0xF1:
+            // POP AF
+            OPCode0xF1();
+            break;
+        case 0xF2:
+            // JP P,nn
+            OPCode0xF2();
+            break;
+        case 0xF3:
+            // DI
+            OPCode0xF3();
+            break;
+        case 0xF4:
+            // CALL P,nn
+            OPCode0xF4();
+            break;
+        case 0xF5:
+            // PUSH AF
+            OPCode0xF5();
+            break;
+        case 0xF6:
+            // OR n
+            OPCode0xF6();
+            break;
+        case 0xF7:
+            // RST 30H
+            OPCode0xF7();
+            break;
+        case 0xF8:
+            // RET M
+            OPCode0xF8();
+            break;
+        case 0xF9:
+        {
+            // LD SP,HL
+            SP.SetValue(GetPrefixedRegister<prefix>()->GetValue());
+            break;
+        }
+        case 0xFA:
+            // JP M,nn
+            OPCode0xFA();
+            break;
+        case 0xFB:
+            // EI
+            OPCode0xFB();
+            break;
+        case 0xFC:
+            // CALL M,nn
+            OPCode0xFC();
+            break;
+        case 0xFD:
+            // FD prefixed instruction
+            OPCode0xFD();
+            break;
+        case 0xFE:
+            // CP n
+            OPCode0xFE();
+            break;
+        case 0xFF:
+            // RST 38H
+            OPCode0xFF();
+            break;
+    }
+
+    if (IsPrefixedInstruction<prefix>())
+        m_iTStates += kOPCodeXYTStates[opcode];
+    else
+        m_iTStates += kOPCodeTStates[opcode];
+
+    if (m_bBranchTaken)
+    {
+        m_bBranchTaken = false;
+        m_iTStates += kOPCodeTStatesBranched[opcode];
+    }
+}
+
+template void Processor::ExecuteOPCodeSwitch<0x00>(u8 opcode);
+template void Processor::ExecuteOPCodeSwitch<0xDD>(u8 opcode);
+template void Processor::ExecuteOPCodeSwitch<0xFD>(u8 opcode);
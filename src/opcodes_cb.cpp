@@ -1554,3 +1554,1034 @@ void Processor::OPCodeCB0xFF()
     // SET 7 A
     OPCodes_SET(AF.GetHighRegister(), 7);
 }
+
+void Processor::ExecuteOPCodeSwitchCB(u8 opcode)
+{
+    switch (opcode)
+    {
+        case 0x00:
+            // RLC B
+            OPCodeCB0x00();
+            break;
+        case 0x01:
+            // RLC C
+            OPCodeCB0x01();
+            break;
+        case 0x02:
+            // RLC D
+            OPCodeCB0x02();
+            break;
+        case 0x03:
+            // RLC E
+            OPCodeCB0x03();
+            break;
+        case 0x04:
+            // RLC H
+            OPCodeCB0x04();
+            break;
+        case 0x05:
+            // RLC L
+            OPCodeCB0x05();
+            break;
+        case 0x06:
+            // RLC (HL)
+            OPCodeCB0x06();
+            break;
+        case 0x07:
+            // RLC A
+            OPCodeCB0x07();
+            break;
+        case 0x08:
+            // RRC B
+            OPCodeCB0x08();
+            break;
+        case 0x09:
+            // RRC C
+            OPCodeCB0x09();
+            break;
+        case 0x0A:
+            // RRC D
+            OPCodeCB0x0A();
+            break;
+        case 0x0B:
+            // RRC E
+            OPCodeCB0x0B();
+            break;
+        case 0x0C:
+            // RRC H
+            OPCodeCB0x0C();
+            break;
+        case 0x0D:
+            // RRC L
+            OPCodeCB0x0D();
+            break;
+        case 0x0E:
+            // RRC (HL)
+            OPCodeCB0x0E();
+            break;
+        case 0x0F:
+            // RRC A
+            OPCodeCB0x0F();
+            break;
+        case 0x10:
+            // RL B
+            OPCodeCB0x10();
+            break;
+        case 0x11:
+            // RL C
+            OPCodeCB0x11();
+            break;
+        case 0x12:
+            // RL D
+            OPCodeCB0x12();
+            break;
+        case 0x13:
+            // RL E
+            OPCodeCB0x13();
+            break;
+        case 0x14:
+            // RL H
+            OPCodeCB0x14();
+            break;
+        case 0x15:
+            // RL L
+            OPCodeCB0x15();
+            break;
+        case 0x16:
+            // RL (HL)
+            OPCodeCB0x16();
+            break;
+        case 0x17:
+            // RL A
+            OPCodeCB0x17();
+            break;
+        case 0x18:
+            // RR B
+            OPCodeCB0x18();
+            break;
+        case 0x19:
+            // RR C
+            OPCodeCB0x19();
+            break;
+        case 0x1A:
+            // RR D
+            OPCodeCB0x1A();
+            break;
+        case 0x1B:
+            // RR E
+            OPCodeCB0x1B();
+            break;
+        case 0x1C:
+            // RR H
+            OPCodeCB0x1C();
+            break;
+        case 0x1D:
+            // RR L
+            OPCodeCB0x1D();
+            break;
+        case 0x1E:
+            // RR (HL)
+            OPCodeCB0x1E();
+            break;
+        case 0x1F:
+            // RR A
+            OPCodeCB0x1F();
+            break;
+        case 0x20:
+            // SLA B
+            OPCodeCB0x20();
+            break;
+        case 0x21:
+            // SLA C
+            OPCodeCB0x21();
+            break;
+        case 0x22:
+            // SLA D
+            OPCodeCB0x22();
+            break;
+        case 0x23:
+            // SLA E
+            OPCodeCB0x23();
+            break;
+        case 0x24:
+            // SLA H
+            OPCodeCB0x24();
+            break;
+        case 0x25:
+            // SLA L
+            OPCodeCB0x25();
+            break;
+        case 0x26:
+            // SLA (HL)
+            OPCodeCB0x26();
+            break;
+        case 0x27:
+            // SLA A
+            OPCodeCB0x27();
+            break;
+        case 0x28:
+            // SRA B
+            OPCodeCB0x28();
+            break;
+        case 0x29:
+            // SRA C
+            OPCodeCB0x29();
+            break;
+        case 0x2A:
+            // SRA D
+            OPCodeCB0x2A();
+            break;
+        case 0x2B:
+            // SRA E
+            OPCodeCB0x2B();
+            break;
+        case 0x2C:
+            // SRA H
+            OPCodeCB0x2C();
+            break;
+        case 0x2D:
+            // SRA L
+            OPCodeCB0x2D();
+            break;
+        case 0x2E:
+            // SRA (HL)
+            OPCodeCB0x2E();
+            break;
+        case 0x2F:
+            // SRA A
+            OPCodeCB0x2F();
+            break;
+        case 0x30:
+            // SLL B
+            OPCodeCB0x30();
+            break;
+        case 0x31:
+            // SLL C
+            OPCodeCB0x31();
+            break;
+        case 0x32:
+            // SLL D
+            OPCodeCB0x32();
+            break;
+        case 0x33:
+            // SLL E
+            OPCodeCB0x33();
+            break;
+        case 0x34:
+            // SLL H
+            OPCodeCB0x34();
+            break;
+        case 0x35:
+            // SLL L
+            OPCodeCB0x35();
+            break;
+        case 0x36:
+            // SLL (HL)
+            OPCodeCB0x36();
+            break;
+        case 0x37:
+            // SLL A
+            OPCodeCB0x37();
+            break;
+        case 0x38:
+            // SRL B
+            OPCodeCB0x38();
+            break;
+        case 0x39:
+            // SRL C
+            OPCodeCB0x39();
+            break;
+        case 0x3A:
+            // SRL D
+            OPCodeCB0x3A();
+            break;
+        case 0x3B:
+            // SRL E
+            OPCodeCB0x3B();
+            break;
+        case 0x3C:
+            // SRL H
+            OPCodeCB0x3C();
+            break;
+        case 0x3D:
+            // SRL L
+            OPCodeCB0x3D();
+            break;
+        case 0x3E:
+            // SRL (HL)
+            OPCodeCB0x3E();
+            break;
+        case 0x3F:
+            // SRL A
+            OPCodeCB0x3F();
+            break;
+        case 0x40:
+            // BIT 0 B
+            OPCodeCB0x40();
+            break;
+        case 0x41:
+            // BIT 0 C
+            OPCodeCB0x41();
+            break;
+        case 0x42:
+            // BIT 0 D
+            OPCodeCB0x42();
+            break;
+        case 0x43:
+            // BIT 0 E
+            OPCodeCB0x43();
+            break;
+        case 0x44:
+            // BIT 0 H
+            OPCodeCB0x44();
+            break;
+        case 0x45:
+            // BIT 0 L
+            OPCodeCB0x45();
+            break;
+        case 0x46:
+            // BIT 0 (HL)
+            OPCodeCB0x46();
+            break;
+        case 0x47:
+            // BIT 0 A
+            OPCodeCB0x47();
+            break;
+        case 0x48:
+            // BIT 1 B
+            OPCodeCB0x48();
+            break;
+        case 0x49:
+            // BIT 1 C
+            OPCodeCB0x49();
+            break;
+        case 0x4A:
+            // BIT 1 D
+            OPCodeCB0x4A();
+            break;
+        case 0x4B:
+            // BIT 1 E
+            OPCodeCB0x4B();
+            break;
+        case 0x4C:
+            // BIT 1 H
+            OPCodeCB0x4C();
+            break;
+        case 0x4D:
+            // BIT 1 L
+            OPCodeCB0x4D();
+            break;
+        case 0x4E:
+            // BIT 1 (HL)
+            OPCodeCB0x4E();
+            break;
+        case 0x4F:
+            // BIT 1 A
+            OPCodeCB0x4F();
+            break;
+        case 0x50:
+            // BIT 2 B
+            OPCodeCB0x50();
+            break;
+        case 0x51:
+            // BIT 2 C
+            OPCodeCB0x51();
+            break;
+        case 0x52:
+            // BIT 2 D
+            OPCodeCB0x52();
+            break;
+        case 0x53:
+            // BIT 2 E
+            OPCodeCB0x53();
+            break;
+        case 0x54:
+            // BIT 2 H
+            OPCodeCB0x54();
+            break;
+        case 0x55:
+            // BIT 2 L
+            OPCodeCB0x55();
+            break;
+        case 0x56:
+            // BIT 2 (HL)
+            OPCodeCB0x56();
+            break;
+        case 0x57:
+            // BIT 2 A
+            OPCodeCB0x57();
+            break;
+        case 0x58:
+            // BIT 3 B
+            OPCodeCB0x58();
+            break;
+        case 0x59:
+            // BIT 3 C
+            OPCodeCB0x59();
+            break;
+        case 0x5A:
+            // BIT 3 D
+            OPCodeCB0x5A();
+            break;
+        case 0x5B:
+            // BIT 3 E
+            OPCodeCB0x5B();
+            break;
+        case 0x5C:
+            // BIT 3 H
+            OPCodeCB0x5C();
+            break;
+        case 0x5D:
+            // BIT 3 L
+            OPCodeCB0x5D();
+            break;
+        case 0x5E:
+            // BIT 3 (HL)
+            OPCodeCB0x5E();
+            break;
+        case 0x5F:
+            // BIT 3 A
+            OPCodeCB0x5F();
+            break;
+        case 0x60:
+            // BIT 4 B
+            OPCodeCB0x60();
+            break;
+        case 0x61:
+            // BIT 4 C
+            OPCodeCB0x61();
+            break;
+        case 0x62:
+            // BIT 4 D
+            OPCodeCB0x62();
+            break;
+        case 0x63:
+            // BIT 4 E
+            OPCodeCB0x63();
+            break;
+        case 0x64:
+            // BIT 4 H
+            OPCodeCB0x64();
+            break;
+        case 0x65:
+            // BIT 4 L
+            OPCodeCB0x65();
+            break;
+        case 0x66:
+            // BIT 4 (HL)
+            OPCodeCB0x66();
+            break;
+        case 0x67:
+            // BIT 4 A
+            OPCodeCB0x67();
+            break;
+        case 0x68:
+            // BIT 5 B
+            OPCodeCB0x68();
+            break;
+        case 0x69:
+            // BIT 5 C
+            OPCodeCB0x69();
+            break;
+        case 0x6A:
+            // BIT 5 D
+            OPCodeCB0x6A();
+            break;
+        case 0x6B:
+            // BIT 5 E
+            OPCodeCB0x6B();
+            break;
+        case 0x6C:
+            // BIT 5 H
+            OPCodeCB0x6C();
+            break;
+        case 0x6D:
+            // BIT 5 L
+            OPCodeCB0x6D();
+            break;
+        case 0x6E:
+            // BIT 5 (HL)
+            OPCodeCB0x6E();
+            break;
+        case 0x6F:
+            // BIT 5 A
+            OPCodeCB0x6F();
+            break;
+        case 0x70:
+            // BIT 6 B
+            OPCodeCB0x70();
+            break;
+        case 0x71:
+            // BIT 6 C
+            OPCodeCB0x71();
+            break;
+        case 0x72:
+            // BIT 6 D
+            OPCodeCB0x72();
+            break;
+        case 0x73:
+            // BIT 6 E
+            OPCodeCB0x73();
+            break;
+        case 0x74:
+            // BIT 6 H
+            OPCodeCB0x74();
+            break;
+        case 0x75:
+            // BIT 6 L
+            OPCodeCB0x75();
+            break;
+        case 0x76:
+            // BIT 6 (HL)
+            OPCodeCB0x76();
+            break;
+        case 0x77:
+            // BIT 6 A
+            OPCodeCB0x77();
+            break;
+        case 0x78:
+            // BIT 7 B
+            OPCodeCB0x78();
+            break;
+        case 0x79:
+            // BIT 7 C
+            OPCodeCB0x79();
+            break;
+        case 0x7A:
+            // BIT 7 D
+            OPCodeCB0x7A();
+            break;
+        case 0x7B:
+            // BIT 7 E
+            OPCodeCB0x7B();
+            break;
+        case 0x7C:
+            // BIT 7 H
+            OPCodeCB0x7C();
+            break;
+        case 0x7D:
+            // BIT 7 L
+            OPCodeCB0x7D();
+            break;
+        case 0x7E:
+            // BIT 7 (HL)
+            OPCodeCB0x7E();
+            break;
+        case 0x7F:
+            // BIT 7 A
+            OPCodeCB0x7F();
+            break;
+        case 0x80:
+            // RES 0 B
+            OPCodeCB0x80();
+            break;
+        case 0x81:
+            // RES 0 C
+            OPCodeCB0x81();
+            break;
+        case 0x82:
+            // RES 0 D
+            OPCodeCB0x82();
+            break;
+        case 0x83:
+            // RES 0 E
+            OPCodeCB0x83();
+            break;
+        case 0x84:
+            // RES 0 H
+            OPCodeCB0x84();
+            break;
+        case 0x85:
+            // RES 0 L
+            OPCodeCB0x85();
+            break;
+        case 0x86:
+            // RES 0 (HL)
+            OPCodeCB0x86();
+            break;
+        case 0x87:
+            // RES 0 A
+            OPCodeCB0x87();
+            break;
+        case 0x88:
+            // RES 1 B
+            OPCodeCB0x88();
+            break;
+        case 0x89:
+            // RES 1 C
+            OPCodeCB0x89();
+            break;
+        case 0x8A:
+            // RES 1 D
+            OPCodeCB0x8A();
+            break;
+        case 0x8B:
+            // RES 1 E
+            OPCodeCB0x8B();
+            break;
+        case 0x8C:
+            // RES 1 H
+            OPCodeCB0x8C();
+            break;
+        case 0x8D:
+            // RES 1 L
+            OPCodeCB0x8D();
+            break;
+        case 0x8E:
+            // RES 1 (HL)
+            OPCodeCB0x8E();
+            break;
+        case 0x8F:
+            // RES 1 A
+            OPCodeCB0x8F();
+            break;
+        case 0x90:
+            // RES 2 B
+            OPCodeCB0x90();
+            break;
+        case 0x91:
+            // RES 2 C
+            OPCodeCB0x91();
+            break;
+        case 0x92:
+            // RES 2 D
+            OPCodeCB0x92();
+            break;
+        case 0x93:
+            // RES 2 E
+            OPCodeCB0x93();
+            break;
+        case 0x94:
+            // RES 2 H
+            OPCodeCB0x94();
+            break;
+        case 0x95:
+            // RES 2 L
+            OPCodeCB0x95();
+            break;
+        case 0x96:
+            // RES 2 (HL)
+            OPCodeCB0x96();
+            break;
+        case 0x97:
+            // RES 2 A
+            OPCodeCB0x97();
+            break;
+        case 0x98:
+            // RES 3 B
+            OPCodeCB0x98();
+            break;
+        case 0x99:
+            // RES 3 C
+            OPCodeCB0x99();
+            break;
+        case 0x9A:
+            // RES 3 D
+            OPCodeCB0x9A();
+            break;
+        case 0x9B:
+            // RES 3 E
+            OPCodeCB0x9B();
+            break;
+        case 0x9C:
+            // RES 3 H
+            OPCodeCB0x9C();
+            break;
+        case 0x9D:
+            // RES 3 L
+            OPCodeCB0x9D();
+            break;
+        case 0x9E:
+            // RES 3 (HL)
+            OPCodeCB0x9E();
+            break;
+        case 0x9F:
+            // RES 3 A
+            OPCodeCB0x9F();
+            break;
+        case 0xA0:
+            // RES 4 B
+            OPCodeCB0xA0();
+            break;
+        case 0xA1:
+            // RES 4 C
+            OPCodeCB0xA1();
+            break;
+        case 0xA2:
+            // RES 4 D
+            OPCodeCB0xA2();
+            break;
+        case 0xA3:
+            // RES 4 E
+            OPCodeCB0xA3();
+            break;
+        case 0xA4:
+            // RES 4 H
+            OPCodeCB0xA4();
+            break;
+        case 0xA5:
+            // RES 4 L
+            OPCodeCB0xA5();
+            break;
+        case 0xA6:
+            // RES 4 (HL)
+            OPCodeCB0xA6();
+            break;
+        case 0xA7:
+            // RES 4 A
+            OPCodeCB0xA7();
+            break;
+        case 0xA8:
+            // RES 5 B
+            OPCodeCB0xA8();
+            break;
+        case 0xA9:
+            // RES 5 C
+            OPCodeCB0xA9();
+            break;
+        case 0xAA:
+            // RES 5 D
+            OPCodeCB0xAA();
+            break;
+        case 0xAB:
+            // RES 5 E
+            OPCodeCB0xAB();
+            break;
+        case 0xAC:
+            // RES 5 H
+            OPCodeCB0xAC();
+            break;
+        case 0xAD:
+            // RES 5 L
+            OPCodeCB0xAD();
+            break;
+        case 0xAE:
+            // RES 5 (HL)
+            OPCodeCB0xAE();
+            break;
+        case 0xAF:
+            // RES 5 A
+            OPCodeCB0xAF();
+            break;
+        case 0xB0:
+            // RES 6 B
+            OPCodeCB0xB0();
+            break;
+        case 0xB1:
+            // RES 6 C
+            OPCodeCB0xB1();
+            break;
+        case 0xB2:
+            // RES 6 D
+            OPCodeCB0xB2();
+            break;
+        case 0xB3:
+            // RES 6 E
+            OPCodeCB0xB3();
+            break;
+        case 0xB4:
+            // RES 6 H
+            OPCodeCB0xB4();
+            break;
+        case 0xB5:
+            // RES 6 L
+            OPCodeCB0xB5();
+            break;
+        case 0xB6:
+            // RES 6 (HL)
+            OPCodeCB0xB6();
+            break;
+        case 0xB7:
+            // RES 6 A
+            OPCodeCB0xB7();
+            break;
+        case 0xB8:
+            // RES 7 B
+            OPCodeCB0xB8();
+            break;
+        case 0xB9:
+            // RES 7 C
+            OPCodeCB0xB9();
+            break;
+        case 0xBA:
+            // RES 7 D
+            OPCodeCB0xBA();
+            break;
+        case 0xBB:
+            // RES 7 E
+            OPCodeCB0xBB();
+            break;
+        case 0xBC:
+            // RES 7 H
+            OPCodeCB0xBC();
+            break;
+        case 0xBD:
+            // RES 7 L
+            OPCodeCB0xBD();
+            break;
+        case 0xBE:
+            // RES 7 (HL)
+            OPCodeCB0xBE();
+            break;
+        case 0xBF:
+            // RES 7 A
+            OPCodeCB0xBF();
+            break;
+        case 0xC0:
+            // SET 0 B
+            OPCodeCB0xC0();
+            break;
+        case 0xC1:
+            // SET 0 C
+            OPCodeCB0xC1();
+            break;
+        case 0xC2:
+            // SET 0 D
+            OPCodeCB0xC2();
+            break;
+        case 0xC3:
+            // SET 0 E
+            OPCodeCB0xC3();
+            break;
+        case 0xC4:
+            // SET 0 H
+            OPCodeCB0xC4();
+            break;
+        case 0xC5:
+            // SET 0 L
+            OPCodeCB0xC5();
+            break;
+        case 0xC6:
+            // SET 0 (HL)
+            OPCodeCB0xC6();
+            break;
+        case 0xC7:
+            // SET 0 A
+            OPCodeCB0xC7();
+            break;
+        case 0xC8:
+            // SET 1 B
+            OPCodeCB0xC8();
+            break;
+        case 0xC9:
+            // SET 1 C
+            OPCodeCB0xC9();
+            break;
+        case 0xCA:
+            // SET 1 D
+            OPCodeCB0xCA();
+            break;
+        case 0xCB:
+            // SET 1 E
+            OPCodeCB0xCB();
+            break;
+        case 0xCC:
+            // SET 1 H
+            OPCodeCB0xCC();
+            break;
+        case 0xCD:
+            // SET 1 L
+            OPCodeCB0xCD();
+            break;
+        case 0xCE:
+            // SET 1 (HL)
+            OPCodeCB0xCE();
+            break;
+        case 0xCF:
+            // SET 1 A
+            OPCodeCB0xCF();
+            break;
+        case 0xD0:
+            // SET 2 B
+            OPCodeCB0xD0();
+            break;
+        case 0xD1:
+            // SET 2 C
+            OPCodeCB0xD1();
+            break;
+        case 0xD2:
+            // SET 2 D
+            OPCodeCB0xD2();
+            break;
+        case 0xD3:
+            // SET 2 E
+            OPCodeCB0xD3();
+            break;
+        case 0xD4:
+            // SET 2 H
+            OPCodeCB0xD4();
+            break;
+        case 0xD5:
+            // SET 2 L
+            OPCodeCB0xD5();
+            break;
+        case 0xD6:
+            // SET 2 (HL)
+            OPCodeCB0xD6();
+            break;
+        case 0xD7:
+            // SET 2 A
+            OPCodeCB0xD7();
+            break;
+        case 0xD8:
+            // SET 3 B
+            OPCodeCB0xD8();
+            break;
+        case 0xD9:
+            // SET 3 C
+            OPCodeCB0xD9();
+            break;
+        case 0xDA:
+            // SET 3 D
+            OPCodeCB0xDA();
+            break;
+        case 0xDB:
+            // SET 3 E
+            OPCodeCB0xDB();
+            break;
+        case 0xDC:
+            // SET 3 H
+            OPCodeCB0xDC();
+            break;
+        case 0xDD:
+            // SET 3 L
+            OPCodeCB0xDD();
+            break;
+        case 0xDE:
+            // SET 3 (HL)
+            OPCodeCB0xDE();
+            break;
+        case 0xDF:
+            // SET 3 A
+            OPCodeCB0xDF();
+            break;
+        case 0xE0:
+            // SET 4 B
+            OPCodeCB0xE0();
+            break;
+        case 0xE1:
+            // SET 4 C
+            OPCodeCB0xE1();
+            break;
+        case 0xE2:
+            // SET 4 D
+            OPCodeCB0xE2();
+            break;
+        case 0xE3:
+            // SET 4 E
+            OPCodeCB0xE3();
+            break;
+        case 0xE4:
+            // SET 4 H
+            OPCodeCB0xE4();
+            break;
+        case 0xE5:
+            // SET 4 L
+            OPCodeCB0xE5();
+            break;
+        case 0xE6:
+            // SET 4 (HL)
+            OPCodeCB0xE6();
+            break;
+        case 0xE7:
+            // SET 4 A
+            OPCodeCB0xE7();
+            break;
+        case 0xE8:
+            // SET 5 B
+            OPCodeCB0xE8();
+            break;
+        case 0xE9:
+            // SET 5 C
+            OPCodeCB0xE9();
+            break;
+        case 0xEA:
+            // SET 5 D
+            OPCodeCB0xEA();
+            break;
+        case 0xEB:
+            // SET 5 E
+            OPCodeCB0xEB();
+            break;
+        case 0xEC:
+            // SET 5 H
+            OPCodeCB0xEC();
+            break;
+        case 0xED:
+            // SET 5 L
+            OPCodeCB0xED();
+            break;
+        case 0xEE:
+            // SET 5 (HL)
+            OPCodeCB0xEE();
+            break;
+        case 0xEF:
+            // SET 5 A
+            OPCodeCB0xEF();
+            break;
+        case 0xF0:
+            // SET 6 B
+            OPCodeCB0xF0();
+            break;
+        case 0xF1:
+            // SET 6 C
+            OPCodeCB0xF1();
+            break;
+        case 0xF2:
+            // SET 6 D
+            OPCodeCB0xF2();
+            break;
+        case 0xF3:
+            // SET 6 E
+            OPCodeCB0xF3();
+            break;
+        case 0xF4:
+            // SET 6 H
+            OPCodeCB0xF4();
+            break;
+        case 0xF5:
+            // SET 6 L
+            OPCodeCB0xF5();
+            break;
+        case 0xF6:
+            // SET 6 (HL)
+            OPCodeCB0xF6();
+            break;
+        case 0xF7:
+            // SET 6 A
+            OPCodeCB0xF7();
+            break;
+        case 0xF8:
+            // SET 7 B
+            OPCodeCB0xF8();
+            break;
+        case 0xF9:
+            // SET 7 C
+            OPCodeCB0xF9();
+            break;
+        case 0xFA:
+            // SET 7 D
+            OPCodeCB0xFA();
+            break;
+        case 0xFB:
+            // SET 7 E
+            OPCodeCB0xFB();
+            break;
+        case 0xFC:
+            // SET 7 H
+            OPCodeCB0xFC();
+            break;
+        case 0xFD:
+            // SET 7 L
+            OPCodeCB0xFD();
+            break;
+        case 0xFE:
+            // SET 7 (HL)
+            OPCodeCB0xFE();
+            break;
+        case 0xFF:
+            // SET 7 A
+            OPCodeCB0xFF();
+            break;
+    }
+}
@@ -294,11 +294,8 @@ void Processor::OPCodeED0x67()
     u8 result = (AF.GetHigh() & 0xF0) | (value & 0x0F);
     m_pMemory->Write(address, ((AF.GetHigh() << 4) & 0xF0) | ((value >> 4) & 0x0F));
     AF.SetHigh(result);
-    IsSetFlag(FLAG_CARRY) ? SetFlag(FLAG_CARRY) : ClearAllFlags();
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    u8 flags = IsSetFlag(FLAG_CARRY) ? FLAG_CARRY : FLAG_NONE;
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
     WZ.SetValue(address + 1);
 }
 
@@ -355,11 +352,8 @@ void Processor::OPCodeED0x6F()
     u8 result = (AF.GetHigh() & 0xF0) | ((value >> 4) & 0x0F);
     m_pMemory->Write(address, ((value << 4) & 0xF0) | (AF.GetHigh() & 0x0F));
     AF.SetHigh(result);
-    IsSetFlag(FLAG_CARRY) ? SetFlag(FLAG_CARRY) : ClearAllFlags();
-    ToggleZeroFlagFromResult(result);
-    ToggleSignFlagFromResult(result);
-    ToggleParityFlagFromResult(result);
-    ToggleXYFlagsFromResult(result);
+    u8 flags = IsSetFlag(FLAG_CARRY) ? FLAG_CARRY : FLAG_NONE;
+    SetFlag(flags | kOPCodeSZXYPTable[result]);
     WZ.SetValue(address + 1);
 }
 
@@ -604,3 +598,325 @@ void Processor::OPCodeED0xBB()
         m_iTStates += 5;
     }
 }
+
+void Processor::ExecuteOPCodeSwitchED(u8 opcode)
+{
+    switch (opcode)
+    {
+        case 0x40:
+            // IN B,(C)
+            OPCodeED0x40();
+            break;
+        case 0x41:
+            // OUT (C),B
+            OPCodeED0x41();
+            break;
+        case 0x42:
+            // SBC HL,BC
+            OPCodeED0x42();
+            break;
+        case 0x43:
+            // LD (nn),BC
+            OPCodeED0x43();
+            break;
+        case 0x44:
+            // NEG
+            OPCodeED0x44();
+            break;
+        case 0x45:
+            // RETN
+            OPCodeED0x45();
+            break;
+        case 0x46:
+            // IM 0
+            OPCodeED0x46();
+            break;
+        case 0x47:
+            // LD I,A
+            OPCodeED0x47();
+            break;
+        case 0x48:
+            // IN C,(C)
+            OPCodeED0x48();
+            break;
+        case 0x49:
+            // OUT (C),C
+            OPCodeED0x49();
+            break;
+        case 0x4A:
+            // ADC HL,BC
+            OPCodeED0x4A();
+            break;
+        case 0x4B:
+            // LD BC,(nn)
+            OPCodeED0x4B();
+            break;
+        case 0x4C:
+            // NEG*
+            OPCodeED0x4C();
+            break;
+        case 0x4D:
+            // RETI
+            OPCodeED0x4D();
+            break;
+        case 0x4E:
+            // IM 0*
+            OPCodeED0x4E();
+            break;
+        case 0x4F:
+            // LD R,A
+            OPCodeED0x4F();
+            break;
+        case 0x50:
+            // IN D,(C)
+            OPCodeED0x50();
+            break;
+        case 0x51:
+            // OUT (C),D
+            OPCodeED0x51();
+            break;
+        case 0x52:
+            // SBC HL,DE
+            OPCodeED0x52();
+            break;
+        case 0x53:
+            // LD (nn),DE
+            OPCodeED0x53();
+            break;
+        case 0x54:
+            // NEG*
+            OPCodeED0x54();
+            break;
+        case 0x55:
+            // RETN*
+            OPCodeED0x55();
+            break;
+        case 0x56:
+            // IM 1
+            OPCodeED0x56();
+            break;
+        case 0x57:
+            // LD A,I
+            OPCodeED0x57();
+            break;
+        case 0x58:
+            // IN E,(C)
+            OPCodeED0x58();
+            break;
+        case 0x59:
+            // OUT (C),E
+            OPCodeED0x59();
+            break;
+        case 0x5A:
+            // ADC HL,DE
+            OPCodeED0x5A();
+            break;
+        case 0x5B:
+            // LD DE,(nn)
+            OPCodeED0x5B();
+            break;
+        case 0x5C:
+            // NEG*
+            OPCodeED0x5C();
+            break;
+        case 0x5D:
+            // RETN*
+            OPCodeED0x5D();
+            break;
+        case 0x5E:
+            // IM 2
+            OPCodeED0x5E();
+            break;
+        case 0x5F:
+            // LD A,R
+            OPCodeED0x5F();
+            break;
+        case 0x60:
+            // IN H,(C)
+            OPCodeED0x60();
+            break;
+        case 0x61:
+            // OUT (C),H
+            OPCodeED0x61();
+            break;
+        case 0x62:
+            // SBC HL,HL
+            OPCodeED0x62();
+            break;
+        case 0x63:
+            // LD (nn),HL
+            OPCodeED0x63();
+            break;
+        case 0x64:
+            // NEG*
+            OPCodeED0x64();
+            break;
+        case 0x65:
+            // RETN*
+            OPCodeED0x65();
+            break;
+        case 0x66:
+            // IM 0*
+            OPCodeED0x66();
+            break;
+        case 0x67:
+            // RRD
+            OPCodeED0x67();
+            break;
+        case 0x68:
+            // IN L,(C)
+            OPCodeED0x68();
+            break;
+        case 0x69:
+            // OUT (C),L
+            OPCodeED0x69();
+            break;
+        case 0x6A:
+            // ADC HL,HL
+            OPCodeED0x6A();
+            break;
+        case 0x6B:
+            // LD HL,(nn)
+            OPCodeED0x6B();
+            break;
+        case 0x6C:
+            // NEG*
+            OPCodeED0x6C();
+            break;
+        case 0x6D:
+            // RETN*
+            OPCodeED0x6D();
+            break;
+        case 0x6E:
+            // IM 0*
+            OPCodeED0x6E();
+            break;
+        case 0x6F:
+            // RLD
+            OPCodeED0x6F();
+            break;
+        case 0x70:
+            // IN F,(C)*
+            OPCodeED0x70();
+            break;
+        case 0x71:
+            // OUT (C),0*
+            OPCodeED0x71();
+            break;
+        case 0x72:
+            // SBC HL,SP
+            OPCodeED0x72();
+            break;
+        case 0x73:
+            // LD (nn),SP
+            OPCodeED0x73();
+            break;
+        case 0x74:
+            // NEG*
+            OPCodeED0x74();
+            break;
+        case 0x75:
+            // RETN*
+            OPCodeED0x75();
+            break;
+        case 0x76:
+            // IM 1*
+            OPCodeED0x76();
+            break;
+        case 0x78:
+            // IN A,(C)
+            OPCodeED0x78();
+            break;
+        case 0x79:
+            // OUT (C),A
+            OPCodeED0x79();
+            break;
+        case 0x7A:
+            // ADC HL,SP
+            OPCodeED0x7A();
+            break;
+        case 0x7B:
+            // LD SP,(nn)
+            OPCodeED0x7B();
+            break;
+        case 0x7C:
+            // NEG*
+            OPCodeED0x7C();
+            break;
+        case 0x7D:
+            // RETN*
+            OPCodeED0x7D();
+            break;
+        case 0x7E:
+            // IM 2*
+            OPCodeED0x7E();
+            break;
+        case 0xA0:
+            // LDI
+            OPCodeED0xA0();
+            break;
+        case 0xA1:
+            // CPI
+            OPCodeED0xA1();
+            break;
+        case 0xA2:
+            // INI
+            OPCodeED0xA2();
+            break;
+        case 0xA3:
+            // OUTI
+            OPCodeED0xA3();
+            break;
+        case 0xA8:
+            // LDD
+            OPCodeED0xA8();
+            break;
+        case 0xA9:
+            // CPD
+            OPCodeED0xA9();
+            break;
+        case 0xAA:
+            // IND
+            OPCodeED0xAA();
+            break;
+        case 0xAB:
+            // OUTD
+            OPCodeED0xAB();
+            break;
+        case 0xB0:
+            // LDIR
+            OPCodeED0xB0();
+            break;
+        case 0xB1:
+            // CPIR
+            OPCodeED0xB1();
+            break;
+        case 0xB2:
+            // INIR
+            OPCodeED0xB2();
+            break;
+        case 0xB3:
+            // OTIR
+            OPCodeED0xB3();
+            break;
+        case 0xB8:
+            // LDDR
+            OPCodeED0xB8();
+            break;
+        case 0xB9:
+            // CPDR
+            OPCodeED0xB9();
+            break;
+        case 0xBA:
+            // INDR
+            OPCodeED0xBA();
+            break;
+        case 0xBB:
+            // OTDR
+            OPCodeED0xBB();
+            break;
+        default:
+            InvalidOPCode();
+            break;
+    }
+}